@@ -0,0 +1,52 @@
+#ifndef BYTE_ORDER_H
+#define BYTE_ORDER_H
+
+#include <stdint.h>
+
+/*
+	Byte order notes!
+
+	Every on-disk format here (pcb.bin, the v2 pcb file and the compressed trace) is little-endian.
+	These read and write fixed-width words byte by byte, so they work on any host and at any alignment;
+	  compilers turn them into plain loads and stores on little-endian hosts.
+
+	Everything is static inline, this header is only shared by the file format translation units.
+*/
+
+///
+/// Reads a little-endian uint32_t
+///
+static inline uint32_t le32(const uint8_t *bytes)
+{
+	return (uint32_t)bytes[0] | (uint32_t)bytes[1] << 8 | (uint32_t)bytes[2] << 16 | (uint32_t)bytes[3] << 24;
+}
+
+///
+/// Reads a little-endian uint64_t
+///
+static inline uint64_t le64(const uint8_t *bytes)
+{
+	return (uint64_t)le32(bytes) | (uint64_t)le32(bytes + 4) << 32;
+}
+
+///
+/// Writes value as a little-endian uint32_t
+///
+static inline void put_le32(uint8_t *bytes, uint32_t value)
+{
+	bytes[0] = (uint8_t)value;
+	bytes[1] = (uint8_t)(value >> 8);
+	bytes[2] = (uint8_t)(value >> 16);
+	bytes[3] = (uint8_t)(value >> 24);
+}
+
+///
+/// Writes value as a little-endian uint64_t
+///
+static inline void put_le64(uint8_t *bytes, uint64_t value)
+{
+	put_le32(bytes, (uint32_t)value);
+	put_le32(bytes + 4, (uint32_t)(value >> 32));
+}
+
+#endif
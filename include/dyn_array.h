@@ -130,6 +130,15 @@ void *dyn_array_back(const dyn_array_t *const dyn_array);
 ///
 bool dyn_array_push_back(dyn_array_t *const dyn_array, const void *const object);
 
+///
+/// Grows the array by count objects at the back, left uninitialized, so they can be filled in bulk
+/// The returned pointer is internal, like dyn_array_export's, and is invalidated by anything that reallocates
+/// \param dyn_array the dynamic array
+/// \param count number of objects to add, at least one
+/// \return Pointer to the first new object, NULL on error
+///
+void *dyn_array_append(dyn_array_t *const dyn_array, const size_t count);
+
 ///
 /// Removes and optionally destructs the object at the back of the array
 /// \param dyn_array the dynamic array
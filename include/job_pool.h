@@ -0,0 +1,114 @@
+#ifndef JOB_POOL_H
+#define JOB_POOL_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+/*
+	Job pool notes!
+
+	This is where the schedulers keep their per pcb state when it can't be an array indexed by
+	  arrival rank, because the pcbs are streamed in (see schedule_session.h) and nobody knows
+	  how many there will be.
+
+	Items are handed out of blocks that never move, so a pointer to an item stays good until
+	  the item is given back: the policies link their queues and trees through them. A block
+	  twice the size of the last is added when the pool runs out, and given back items go on a
+	  free list threaded through their first bytes, so memory follows the most items ever live.
+
+	The first block holds capacity items, so a batch run that knows its pcb count allocates once.
+
+	Everything is static inline, like the ready heap.
+*/
+
+// Item sizes and the block header are rounded up to this, so items are aligned for anything
+#define JOB_POOL_ALIGN sizeof(max_align_t)
+
+typedef struct
+{
+	void *blocks;		// the newest block, each one starts with a pointer to the one before
+	void *free_list;	// items given back
+	size_t item_size;
+	size_t used;		// items handed out of the newest block
+	size_t capacity;	// items the newest block holds
+}
+JobPool_t;
+
+///
+/// Sets up an empty pool, the first block is allocated on the first take
+/// \param pool the pool to initialize
+/// \param item_size size of one item
+/// \param capacity number of items the first block holds (0 for 16)
+///
+static inline void job_pool_init(JobPool_t *pool, size_t item_size, size_t capacity)
+{
+	item_size = item_size > sizeof(void *) ? item_size : sizeof(void *);
+	pool->blocks = NULL;
+	pool->free_list = NULL;
+	pool->item_size = (item_size + JOB_POOL_ALIGN - 1) / JOB_POOL_ALIGN * JOB_POOL_ALIGN;
+	pool->used = 0;
+	pool->capacity = capacity ? capacity : 16;
+}
+
+///
+/// Releases every block, and with them every item
+/// \param pool the pool
+///
+static inline void job_pool_destroy(JobPool_t *pool)
+{
+	while (pool->blocks != NULL)
+	{
+		void *previous = *(void **)pool->blocks;
+		free(pool->blocks);
+		pool->blocks = previous;
+	}
+	pool->free_list = NULL;
+	pool->used = 0;
+}
+
+///
+/// Hands out an item, its contents are undefined
+/// \param pool the pool
+/// \return the item, NULL if a new block can't be allocated
+///
+static inline void *job_pool_take(JobPool_t *pool)
+{
+	if (pool->free_list != NULL)
+	{
+		void *item = pool->free_list;
+		pool->free_list = *(void **)item;
+		return item;
+	}
+
+	if (pool->blocks == NULL || pool->used == pool->capacity)
+	{
+		size_t capacity = pool->blocks == NULL ? pool->capacity : 2 * pool->capacity;
+		void *block = malloc(JOB_POOL_ALIGN + capacity * pool->item_size);
+		if (block == NULL)
+		{
+			return NULL;
+		}
+
+		*(void **)block = pool->blocks;
+		pool->blocks = block;
+		pool->used = 0;
+		pool->capacity = capacity;
+	}
+
+	return (unsigned char *)pool->blocks + JOB_POOL_ALIGN + pool->used++ * pool->item_size;
+}
+
+///
+/// Gives an item back for the next take
+/// \param pool the pool
+/// \param item an item taken from this pool
+///
+static inline void job_pool_give(JobPool_t *pool, void *item)
+{
+	*(void **)item = pool->free_list;
+	pool->free_list = item;
+}
+
+#endif
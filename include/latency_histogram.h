@@ -0,0 +1,146 @@
+#ifndef LATENCY_HISTOGRAM_H
+#define LATENCY_HISTOGRAM_H
+
+#ifdef __cplusplus
+	extern "C" {
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+	Latency histogram notes!
+
+	A log-linear (HDR style) histogram of uint64_t samples in a fixed 15 KB, however many samples go in.
+	Values below 32 get a bucket each; every power of two range [2^m, 2^(m+1)) above that is split into
+	  32 equal buckets, so a reported percentile is within 1/32 (about 3%) of the true sample. max is exact.
+
+	Counts are plain sums, so histograms filled on different threads or from different shards of a
+	  trace merge exactly with latency_histogram_merge, in any order.
+*/
+
+#define LATENCY_HISTOGRAM_SUB_BITS 5
+#define LATENCY_HISTOGRAM_SUB_BUCKETS (1u << LATENCY_HISTOGRAM_SUB_BITS)
+#define LATENCY_HISTOGRAM_BUCKETS ((64 - LATENCY_HISTOGRAM_SUB_BITS + 1) * LATENCY_HISTOGRAM_SUB_BUCKETS)
+
+typedef struct
+{
+	uint64_t counts[LATENCY_HISTOGRAM_BUCKETS];
+	uint64_t total;		// samples recorded
+	uint64_t max;		// largest sample, 0 when empty
+}
+LatencyHistogram_t;
+
+///
+/// Returns the bucket a value is counted in
+/// \param value the sample
+/// \return the bucket index, below LATENCY_HISTOGRAM_BUCKETS
+///
+static inline size_t latency_histogram_bucket(const uint64_t value)
+{
+	if (value < LATENCY_HISTOGRAM_SUB_BUCKETS)
+	{
+		return (size_t)value;
+	}
+
+	unsigned shift = 63 - (unsigned)__builtin_clzll(value) - LATENCY_HISTOGRAM_SUB_BITS;
+	return (size_t)(shift + 1) * LATENCY_HISTOGRAM_SUB_BUCKETS + (size_t)((value >> shift) & (LATENCY_HISTOGRAM_SUB_BUCKETS - 1));
+}
+
+///
+/// Returns the largest value that is counted in a bucket
+/// \param bucket the bucket index
+/// \return the bucket's upper bound
+///
+static inline uint64_t latency_histogram_bucket_limit(const size_t bucket)
+{
+	if (bucket < LATENCY_HISTOGRAM_SUB_BUCKETS)
+	{
+		return bucket;
+	}
+
+	unsigned shift = (unsigned)(bucket / LATENCY_HISTOGRAM_SUB_BUCKETS) - 1;
+	uint64_t lowest = (uint64_t)(LATENCY_HISTOGRAM_SUB_BUCKETS + bucket % LATENCY_HISTOGRAM_SUB_BUCKETS) << shift;
+	return lowest + ((uint64_t)1 << shift) - 1;
+}
+
+///
+/// Counts one sample
+/// \param histogram the histogram
+/// \param value the sample
+///
+static inline void latency_histogram_record(LatencyHistogram_t *const histogram, const uint64_t value)
+{
+	histogram->counts[latency_histogram_bucket(value)]++;
+	histogram->total++;
+	if (value > histogram->max)
+	{
+		histogram->max = value;
+	}
+}
+
+///
+/// Adds every sample of part into histogram
+/// \param histogram the histogram merged into
+/// \param part the histogram merged from, left untouched
+///
+static inline void latency_histogram_merge(LatencyHistogram_t *const histogram, const LatencyHistogram_t *const part)
+{
+	if (part->total == 0)
+	{
+		return;
+	}
+
+	for (size_t bucket = 0; bucket < LATENCY_HISTOGRAM_BUCKETS; bucket++)
+	{
+		histogram->counts[bucket] += part->counts[bucket];
+	}
+	histogram->total += part->total;
+	if (part->max > histogram->max)
+	{
+		histogram->max = part->max;
+	}
+}
+
+///
+/// Returns the value at a percentile: at least that share of the samples are no larger than it
+/// \param histogram the histogram
+/// \param percentile 0 to 100, for example 99.9
+/// \return the upper bound of the bucket holding that sample (never above max), 0 when empty
+///
+static inline uint64_t latency_histogram_percentile(const LatencyHistogram_t *const histogram, const double percentile)
+{
+	if (histogram->total == 0)
+	{
+		return 0;
+	}
+
+	double wanted = percentile / 100.0 * (double)histogram->total;
+	uint64_t rank = (uint64_t)wanted;
+	if ((double)rank < wanted || rank == 0) // round up, and the 0th percentile is the smallest sample
+	{
+		rank++;
+	}
+	if (rank > histogram->total)
+	{
+		rank = histogram->total;
+	}
+
+	uint64_t seen = 0;
+	for (size_t bucket = 0; bucket < LATENCY_HISTOGRAM_BUCKETS; bucket++)
+	{
+		seen += histogram->counts[bucket];
+		if (seen >= rank)
+		{
+			uint64_t limit = latency_histogram_bucket_limit(bucket);
+			return limit < histogram->max ? limit : histogram->max;
+		}
+	}
+	return histogram->max;
+}
+
+#ifdef __cplusplus
+	}
+#endif
+
+#endif
@@ -0,0 +1,214 @@
+#ifndef PCB_FILE_H
+#define PCB_FILE_H
+
+#ifdef __cplusplus
+	extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "dyn_array.h"
+#include "processing_scheduling.h"
+
+typedef struct pcb_file pcb_file_t;
+
+/*
+	PCB file notes!
+
+	pcb.bin (version 1) is a uint32_t record count N followed by N records of three uint32_t:
+	  burst, priority, arrival, all little-endian. Deadline files add a fourth word, the deadline.
+
+	Version 2 files describe themselves, every field little-endian:
+	  "PCBFILE2", u32 version, u32 flags, u64 count, u32 records per block, u32 reserved (0),
+	  then an offset table with one {u64 block offset, u64 checksum} per block, then the blocks of records.
+	The flags say whether the arrivals never decrease, whether records carry a deadline and whether
+	  the blocks carry a Fletcher-64 checksum of their words.
+	A loader only does the work a file asks for: no checksums means nothing is summed, and a sorted
+	  flag is verified in the same pass that decodes. Blocks are independent, so a mapped v2 file
+	  decodes its blocks in parallel on a thread pool.
+	The sorted flag isn't carried past the loader. The scheduler's arrival order finds sorted input on
+	  its own in one linear scan and then skips its radix passes, so a sorted file is never sorted again
+	  and any other sorted ready_queue gets the same fast path.
+	Every loader tells the two versions apart by the magic, so callers don't have to.
+
+	A columnar v2 file (PCB_FILE_COLUMNAR) stores each field as its own contiguous section instead of
+	  blocks of records: the header's block size becomes the column count, and the offset table has one
+	  entry per column, in PcbColumn_t order. Columns past the ones this code knows are fields added later
+	  and are skipped. Each column starts on a 64-byte boundary of the file.
+	pcb_file_to_dyn_array_columns decodes only the columns asked for, in parallel, and a column that isn't
+	  asked for is never read or even paged in, so FCFS over a deadline trace reads half the file.
+	  pcb_file_policy_columns says which columns an algorithm needs. pcb_file_column hands out a mapped
+	  column in place, an aligned uint32_t array ready for vector loops.
+
+	pcb_stream_load reads any stream (a file, a pipe, a file on a network mount) in large blocks and
+	  decodes whole blocks of records at a time with explicit little-endian loads, so the result is the
+	  same on every host. load_process_control_blocks goes through pcb_file_load, which streams v1 files
+	  and maps v2 files.
+
+	pcb_file_map maps the whole file read-only and checks the header against the file length once.
+	The records can then be read in place through pcb_file_records, without copying anything,
+	  or turned into a ready_queue in a single pass with pcb_file_to_dyn_array.
+	The file is paged in as the records are touched, so a load costs page faults, not read calls.
+	pcb_file_records is a view in host byte order, so it only reads correctly on little-endian hosts;
+	  pcb_file_to_dyn_array decodes explicitly and is correct everywhere.
+*/
+
+#define PCB_FILE_VERSION 2
+#define PCB_FILE_ARRIVAL_SORTED 0x1u	// arrivals never decrease, set by pcb_file_write
+#define PCB_FILE_HAS_DEADLINES 0x2u		// four words a record
+#define PCB_FILE_CHECKSUMS 0x4u			// per block checksums in the offset table
+#define PCB_FILE_COLUMNAR 0x8u			// one section per field rather than blocks of records
+#define PCB_FILE_KNOWN_FLAGS (PCB_FILE_ARRIVAL_SORTED | PCB_FILE_HAS_DEADLINES | PCB_FILE_CHECKSUMS | PCB_FILE_COLUMNAR)
+#define PCB_FILE_MAX_BLOCK_RECORDS (1u << 20)
+#define PCB_FILE_MAX_COLUMNS 32
+
+typedef enum
+{
+	PCB_COLUMN_BURST,
+	PCB_COLUMN_PRIORITY,
+	PCB_COLUMN_ARRIVAL,
+	PCB_COLUMN_DEADLINE,
+	PCB_COLUMN_KNOWN			// columns this code reads, later ones are skipped
+}
+PcbColumn_t;
+
+#define PCB_COLUMN_BIT(column) (1u << (column))
+#define PCB_COLUMNS_ALL (PCB_COLUMN_BIT(PCB_COLUMN_KNOWN) - 1)
+
+typedef struct
+{
+	uint32_t remaining_burst_time;
+	uint32_t priority;
+	uint32_t arrival;
+}
+PcbRecord_t;	// one pcb as stored in pcb.bin, 12 bytes
+
+///
+/// Reads a v1 or v2 pcb file from a stream in large blocks, decoding little-endian records
+/// Like load_process_control_blocks, it's an error for the stream to end early or to hold another whole uint32_t past the last record,
+/// and for a v2 stream to fail a checksum or its sorted flag
+/// \param stream positioned at the start of the file, read up to its end
+/// \param with_deadlines whether every v1 record has a fourth word, the deadline; v2 files say so themselves
+/// \return a populated dyn_array of ProcessControlBlocks, NULL on error
+///
+dyn_array_t *pcb_stream_load(FILE *const stream, const bool with_deadlines);
+
+///
+/// Maps a v1 or v2 pcb file and validates its length against its record count, and a v2 file's offset table
+/// Like load_process_control_blocks, it's an error for the file to end early or to hold another whole uint32_t past the last record
+/// \param input_file the pcb file
+/// \return new mapped file pointer, NULL on error
+///
+pcb_file_t *pcb_file_map(const char *const input_file);
+
+///
+/// Returns the number of records in a mapped file
+/// \param file the mapped file
+/// \return the record count, 0 on error
+///
+size_t pcb_file_size(const pcb_file_t *const file);
+
+///
+/// Returns the format version of a mapped file
+/// \param file the mapped file
+/// \return 1 or PCB_FILE_VERSION, 0 on error
+///
+uint32_t pcb_file_version(const pcb_file_t *const file);
+
+///
+/// Returns the flags of a mapped file, always 0 for a v1 file
+/// \param file the mapped file
+/// \return the PCB_FILE_* flags, 0 on error
+///
+uint32_t pcb_file_flags(const pcb_file_t *const file);
+
+///
+/// Returns the records of a mapped v1 file, in place
+/// The pointer is valid until pcb_file_unmap, the fields are in host byte order (see the notes)
+/// \param file the mapped file
+/// \return pointer to pcb_file_size records, NULL on error, for a v2 file or when there are none
+///
+const PcbRecord_t *pcb_file_records(const pcb_file_t *const file);
+
+///
+/// Returns one column of a mapped columnar file, in place
+/// The pointer is valid until pcb_file_unmap, the words are in host byte order like pcb_file_records
+/// \param file the mapped file
+/// \param column the column
+/// \return pointer to pcb_file_size words, NULL on error, for a row file, a column the file lacks or when there are no records
+///
+const uint32_t *pcb_file_column(const pcb_file_t *const file, const PcbColumn_t column);
+
+///
+/// Returns the columns a scheduling algorithm reads
+/// \param algorithm the algorithm
+/// \return PCB_COLUMN_BIT of every column it needs
+///
+uint32_t pcb_file_policy_columns(const ScheduleAlgorithm_t algorithm);
+
+///
+/// Builds a ready_queue from a mapped file, in one pass over the records, decoding them as little-endian
+/// A v2 file's blocks are decoded in parallel, checking their checksums and sorted flag as they go
+/// \param file the mapped file, still usable afterwards
+/// \return a populated dyn_array of ProcessControlBlocks, NULL on error
+///
+dyn_array_t *pcb_file_to_dyn_array(const pcb_file_t *const file);
+
+///
+/// Builds a ready_queue holding only some fields of a mapped file, the others are 0
+/// For a columnar file only those columns are read, checked and paged in; a row file is decoded whole
+/// \param file the mapped file, still usable afterwards
+/// \param columns PCB_COLUMN_BIT of each wanted column, such as pcb_file_policy_columns returns
+/// \return a populated dyn_array of ProcessControlBlocks, NULL on error
+///
+dyn_array_t *pcb_file_to_dyn_array_columns(const pcb_file_t *const file, const uint32_t columns);
+
+///
+/// Unmaps the file
+/// \param file the mapped file
+///
+void pcb_file_unmap(pcb_file_t *const file);
+
+///
+/// Loads a pcb file through a read-only mapping, same result as load_process_control_blocks
+/// \param input_file the pcb file
+/// \return a populated dyn_array of ProcessControlBlocks, NULL on error
+///
+dyn_array_t *load_process_control_blocks_mapped(const char *const input_file);
+
+///
+/// Loads only some fields of a pcb file through a read-only mapping, the others are 0
+/// A compressed trace (see pcb_trace.h) can't be mapped and is decoded whole
+/// \param input_file the pcb file
+/// \param columns PCB_COLUMN_BIT of each wanted column, such as pcb_file_policy_columns returns
+/// \return a populated dyn_array of ProcessControlBlocks, NULL on error
+///
+dyn_array_t *load_process_control_blocks_columns(const char *const input_file, const uint32_t columns);
+
+///
+/// Loads a v1 or v2 pcb file or a compressed trace, what load_process_control_blocks does
+/// A v2 file is mapped and decoded in parallel, a v1 file is streamed with pcb_stream_load and a trace with pcb_trace_load
+/// \param input_file the pcb file
+/// \param with_deadlines whether every v1 record has a fourth word, the deadline; v2 files say so themselves
+/// \return a populated dyn_array of ProcessControlBlocks, NULL on error
+///
+dyn_array_t *pcb_file_load(const char *const input_file, const bool with_deadlines);
+
+///
+/// Writes pcbs as a v2 pcb file, setting PCB_FILE_ARRIVAL_SORTED when their arrivals never decrease
+/// \param output_file the file to write, replaced if it exists
+/// \param ready_queue the pcbs, in file order
+/// \param flags PCB_FILE_HAS_DEADLINES, PCB_FILE_CHECKSUMS and/or PCB_FILE_COLUMNAR
+/// \param block_records records per block, 0 for the default of 65536, at most PCB_FILE_MAX_BLOCK_RECORDS; unused by a columnar file
+/// \return true if function ran successful else false for an error
+///
+bool pcb_file_write(const char *const output_file, const dyn_array_t *const ready_queue, const uint32_t flags, const size_t block_records);
+
+#ifdef __cplusplus
+	}
+#endif
+
+#endif
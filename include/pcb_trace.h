@@ -0,0 +1,117 @@
+#ifndef PCB_TRACE_H
+#define PCB_TRACE_H
+
+#ifdef __cplusplus
+	extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "dyn_array.h"
+#include "processing_scheduling.h"
+
+typedef struct pcb_trace_reader pcb_trace_reader_t;
+
+/*
+	PCB trace notes!
+
+	A trace is a compressed pcb file for archiving and replaying long arrival streams:
+	  "PCBTRAC1", u32 flags, u32 reserved (0), u64 count, all little-endian, then count records.
+	Each record is a run of LEB128 varints: the arrival as a zigzag delta from the previous arrival,
+	  the burst, the priority and, with PCB_TRACE_HAS_DEADLINES, the deadline as a zigzag delta from the arrival.
+	An arrival-sorted trace with small bursts and priorities takes 3 to 4 bytes a record instead of 12.
+	The deltas are signed, so a trace whose arrivals go backwards still round trips; it just can't be replayed.
+
+	Nothing in a trace needs seeking, so every function here works on pipes, and both writing and
+	  reading go through 64 KB buffers. pcb_trace_convert turns a pcb.bin stream into a trace in constant memory.
+	pcb_trace_replay feeds the records straight into a schedule session (see schedule_session.h) as they
+	  are decoded, so replaying a trace never holds more than a chunk of records plus the session's live pcbs.
+	load_process_control_blocks also accepts traces, decoding them whole.
+*/
+
+#define PCB_TRACE_MAGIC "PCBTRAC1"	// the first 8 bytes of every trace
+#define PCB_TRACE_HAS_DEADLINES 0x1u
+
+///
+/// Writes pcbs as a trace
+/// \param output the stream to write, left open
+/// \param ready_queue the pcbs, in file order
+/// \param flags PCB_TRACE_HAS_DEADLINES to keep the deadlines
+/// \return true if function ran successful else false for an error
+///
+bool pcb_trace_write(FILE *const output, const dyn_array_t *const ready_queue, const uint32_t flags);
+
+///
+/// Converts a pcb.bin stream into a trace, a block of records at a time
+/// Like load_process_control_blocks, it's an error for the input to end early or to hold another whole uint32_t past the last record
+/// \param input the pcb.bin stream, positioned at the record count
+/// \param output the stream to write, left open
+/// \param with_deadlines whether every input record has a fourth word, the deadline, which the trace then keeps
+/// \return true if function ran successful else false for an error
+///
+bool pcb_trace_convert(FILE *const input, FILE *const output, const bool with_deadlines);
+
+///
+/// Starts reading a trace, reading its header
+/// \param input the trace stream, positioned at the magic, left open by pcb_trace_close
+/// \return new reader pointer, NULL on error or if the stream isn't a trace
+///
+pcb_trace_reader_t *pcb_trace_open(FILE *const input);
+
+///
+/// Returns the number of records the trace's header promises
+/// \param reader the reader
+/// \return the record count, 0 on error
+///
+uint64_t pcb_trace_size(const pcb_trace_reader_t *const reader);
+
+///
+/// Returns the trace's flags
+/// \param reader the reader
+/// \return the PCB_TRACE_* flags, 0 on error
+///
+uint32_t pcb_trace_flags(const pcb_trace_reader_t *const reader);
+
+///
+/// Decodes the next records of the trace
+/// It's an error for the trace to end before its count, or to hold anything after it
+/// \param reader the reader
+/// \param pcbs receives up to max pcbs
+/// \param max the room in pcbs
+/// \param decoded receives the number of pcbs decoded, 0 once the whole trace has been read
+/// \return true if function ran successful else false for an error
+///
+bool pcb_trace_read(pcb_trace_reader_t *const reader, ProcessControlBlock_t *const pcbs, const size_t max, size_t *const decoded);
+
+///
+/// Frees the reader, the stream stays open
+/// \param reader the reader
+///
+void pcb_trace_close(pcb_trace_reader_t *const reader);
+
+///
+/// Decodes a whole trace into a ready_queue
+/// \param input the trace stream, positioned at the magic, left open
+/// \return a populated dyn_array of ProcessControlBlocks, NULL on error
+///
+dyn_array_t *pcb_trace_load(FILE *const input);
+
+///
+/// Schedules a trace as it is decoded, submitting each chunk of records to a schedule session
+/// The result is the same as loading the trace and running schedule_algorithm over it
+/// \param input the trace stream, positioned at the magic, left open; its arrivals must never decrease
+/// \param algorithm the policy to run
+/// \param quantum the time slice, only used by round robin (where it must not be 0)
+/// \param result receives the statistics \ref ScheduleResult_t
+/// \return true if function ran successful else false for an error
+///
+bool pcb_trace_replay(FILE *const input, const ScheduleAlgorithm_t algorithm, const size_t quantum, ScheduleResult_t *const result);
+
+#ifdef __cplusplus
+	}
+#endif
+
+#endif
@@ -15,30 +15,101 @@
 		uint32_t remaining_burst_time;  // the remaining burst of the pcb
 		uint32_t priority;				// The priority of the task
 		uint32_t arrival;				// Time the process arrived in the ready queue
+		uint32_t deadline;				// Time by which the process should have completed, 0 for no deadline
 		bool started;			  		// If it has been activated on virtual CPU
 	} 
 	ProcessControlBlock_t;				// you may or may not need to add more elements
 
+	typedef struct
+	{
+		uint64_t p50;
+		uint64_t p90;
+		uint64_t p99;
+		uint64_t p999;					// the 99.9th percentile
+		uint64_t max;
+	}
+	ScheduleLatency_t;					// tail of a per-pcb time, percentiles within about 3% (see latency_histogram.h), max exact
+
 	typedef struct 
 	{
 		float average_waiting_time;	 // the average waiting time in the ready queue until first schedue on the cpu
 		float average_turnaround_time;  // the average completion time of the PCBs
 		unsigned long total_run_time;   // the total time to process all the PCBs in the ready queue
+		unsigned long deadline_misses;  // PCBs with a deadline that completed after it
+		long max_lateness;			  	// the largest completion - deadline over PCBs with a deadline, 0 if none had one
+		ScheduleLatency_t waiting_latency;	// percentiles of the PCBs' waiting times
+		ScheduleLatency_t turnaround_latency;	// percentiles of the PCBs' turnaround times
 	} 
 	ScheduleResult_t;
 
+	typedef enum
+	{
+		SCHEDULE_FCFS,		// First Come First Served
+		SCHEDULE_SJF,		// Shortest Job First
+		SCHEDULE_PRIORITY,	// non-preemptive Priority, lowest value first
+		SCHEDULE_RR,		// Round Robin, needs a quantum
+		SCHEDULE_SRT,		// Shortest Remaining Time First
+		SCHEDULE_EDF,		// non-preemptive Earliest Deadline First
+		SCHEDULE_EDF_PREEMPTIVE	// preemptive Earliest Deadline First
+	}
+	ScheduleAlgorithm_t;				// the work-conserving single CPU policies
+
+	typedef struct
+	{
+		uint64_t *first_dispatch;		// time the pcb first got the CPU
+		uint64_t *completion;			// time the pcb finished
+		uint64_t *waiting;				// time spent in the ready queue, turnaround minus burst
+		uint64_t *response;				// first dispatch minus arrival
+		uint32_t *preemptions;			// times the pcb lost the CPU before finishing, slice ends included
+	}
+	ScheduleColumns_t;					// optional per-pcb results, one caller-owned array per column indexed like the ready_queue, NULL to skip it
+
+	#define MLFQ_MAX_LEVELS 64
+
+	typedef struct
+	{
+		size_t levels;					// number of queues, 1 to MLFQ_MAX_LEVELS, level 0 runs first
+		const size_t *quanta;			// the allotment of each level, levels of them, all non-zero
+		size_t boost_period;			// every boost_period time units all pcbs go back to level 0, 0 for never
+	}
+	MlfqConfig_t;						// multi-level feedback queue settings
+
 	// Reads the PCB burst time values from the binary file into ProcessControlBlock_t remaining_burst_time field
 	// for N number of PCB burst time stored in the file.
 	// \param input_file the file containing the PCB burst times
 	// \return a populated dyn_array of ProcessControlBlocks if function ran successful else NULL for an error
 	dyn_array_t *load_process_control_blocks(const char *input_file);
 
+	// Reads pcbs from a binary file whose records carry a deadline after the arrival time
+	// \param input_file the file containing N and then N (burst, priority, arrival, deadline) records
+	// \return a populated dyn_array of ProcessControlBlocks if function ran successful else NULL for an error
+	dyn_array_t *load_process_control_blocks_with_deadlines(const char *input_file);
+
 	// Runs the First Come First Served Process Scheduling algorithm over the incoming ready_queue
 	// \param ready queue a dyn_array of type ProcessControlBlock_t that contain be up to N elements
 	// \param result used for first come first served stat tracking \ref ScheduleResult_t
 	// \return true if function ran successful else false for an error
 	bool first_come_first_serve(dyn_array_t *ready_queue, ScheduleResult_t *result);
 
+	// Runs algorithm over the incoming ready_queue and leaves it as it was
+	// The pcbs are only read, so one loaded ready_queue can be scheduled again and again, or from several threads at once.
+	// \param ready queue a dyn_array of type ProcessControlBlock_t that contain be up to N elements
+	// \param result used for stat tracking \ref ScheduleResult_t
+	// \param algorithm which policy to run
+	// \param quantum the time slice, only used by round robin (where it must not be 0)
+	// \param columns receives per-pcb results in the arrays it points to \ref ScheduleColumns_t, NULL for none
+	// \return true if function ran successful else false for an error
+	bool schedule_algorithm(const dyn_array_t *ready_queue, ScheduleResult_t *result, ScheduleAlgorithm_t algorithm, size_t quantum,
+		const ScheduleColumns_t *columns);
+
+	// Runs the First Come First Served Process Scheduling algorithm over the incoming ready_queue on several threads
+	// Gives exactly the same result as first_come_first_serve, using a parallel prefix scan over the arrival order
+	// \param ready queue a dyn_array of type ProcessControlBlock_t that contain be up to N elements
+	// \param result used for first come first served stat tracking \ref ScheduleResult_t
+	// \param num_threads how many threads to use, 0 for one per online CPU
+	// \return true if function ran successful else false for an error
+	bool first_come_first_serve_parallel(dyn_array_t *ready_queue, ScheduleResult_t *result, size_t num_threads);
+
 	// Runs the Shortest Job First Scheduling algorithm over the incoming ready_queue
 	// \param ready queue a dyn_array of type ProcessControlBlock_t that contain be up to N elements
 	// \param result used for shortest job first stat tracking \ref ScheduleResult_t
@@ -46,11 +117,31 @@
 	bool shortest_job_first(dyn_array_t *ready_queue, ScheduleResult_t *result);
 
 	// Runs the Priority algorithm over the incoming ready_queue
+	// Ties in priority go to the earliest arrival, then to the pcb that comes first in the file
 	// \param ready queue a dyn_array of type ProcessControlBlock_t that contain be up to N elements
 	// \param result used for shortest job first stat tracking \ref ScheduleResult_t
 	// \return true if function ran successful else false for an error
 	bool priority(dyn_array_t *ready_queue, ScheduleResult_t *result);
 
+	// Runs the preemptive Priority algorithm, with optional aging, over the incoming ready_queue
+	// A waiting pcb's effective priority improves by one level per aging_interval it waits, and the running pcb is
+	// preempted by a waiting pcb whose effective priority is better (by a whole level when aging).
+	// \param ready queue a dyn_array of type ProcessControlBlock_t that contain be up to N elements
+	// \param result used for priority stat tracking \ref ScheduleResult_t
+	// \param aging_interval time units per level of aging, 0 for no aging; it's an error if the highest priority times the
+	// interval, plus twice the trace's span, doesn't fit in 64 bits
+	// \param columns receives per-pcb results in the arrays it points to \ref ScheduleColumns_t, NULL for none
+	// \return true if function ran successful else false for an error
+	bool priority_preemptive(dyn_array_t *ready_queue, ScheduleResult_t *result, uint32_t aging_interval, const ScheduleColumns_t *columns);
+
+	// Runs the Earliest Deadline First algorithm over the incoming ready_queue
+	// Pcbs without a deadline run after every pcb that has one; deadline_misses and max_lateness report how it went
+	// \param ready queue a dyn_array of type ProcessControlBlock_t that contain be up to N elements
+	// \param result used for earliest deadline first stat tracking \ref ScheduleResult_t
+	// \param preemptive whether an arrival with an earlier deadline takes the CPU from the running pcb
+	// \return true if function ran successful else false for an error
+	bool earliest_deadline_first(dyn_array_t *ready_queue, ScheduleResult_t *result, bool preemptive);
+
 	// Runs the Round Robin Process Scheduling algorithm over the incoming ready_queue
 	// \param ready queue a dyn_array of type ProcessControlBlock_t that contain be up to N elements
 	// \param result used for round robin stat tracking \ref ScheduleResult_t
@@ -58,12 +149,89 @@
 	// \return true if function ran successful else false for an error
 	bool round_robin(dyn_array_t *ready_queue, ScheduleResult_t *result, size_t quantum);
 
+	// Runs Round Robin once per quantum over the same ready_queue, the quanta spread over several threads
+	// The input is sorted by arrival once and shared read-only by every run; ready_queue is left as it was.
+	// \param ready queue a dyn_array of type ProcessControlBlock_t that contain be up to N elements
+	// \param quanta the quanta to try, none of them 0
+	// \param num_quanta number of quanta
+	// \param results receives one \ref ScheduleResult_t per quantum, in the order of quanta
+	// \param num_threads how many threads to use, 0 for one per online CPU
+	// \return true if function ran successful else false for an error
+	bool round_robin_sweep(const dyn_array_t *ready_queue, const size_t *quanta, size_t num_quanta, ScheduleResult_t *results, size_t num_threads);
+
+	// Runs several algorithms over the same ready_queue, each on its own thread
+	// The input is sorted by arrival once and shared read-only by every run; ready_queue is left as it was.
+	// \param ready queue a dyn_array of type ProcessControlBlock_t that contain be up to N elements
+	// \param algorithms the policies to run
+	// \param num_algorithms number of algorithms
+	// \param quantum the time slice, only used by round robin
+	// \param results receives one \ref ScheduleResult_t per algorithm, in the order of algorithms
+	// \param num_threads how many threads to use, 0 for one per online CPU
+	// \return true if function ran successful else false for an error
+	bool schedule_compare(const dyn_array_t *ready_queue, const ScheduleAlgorithm_t *algorithms, size_t num_algorithms, size_t quantum,
+		ScheduleResult_t *results, size_t num_threads);
+
+	// Runs the Multi-Level Feedback Queue Process Scheduling algorithm over the incoming ready_queue
+	// New pcbs start on level 0 and drop a level once they use up that level's quantum; a pcb on a higher level
+	// preempts the running one, and every boost_period all pcbs move back to level 0.
+	// \param ready queue a dyn_array of type ProcessControlBlock_t that contain be up to N elements
+	// \param result used for multi-level feedback queue stat tracking \ref ScheduleResult_t
+	// \param config the levels, their quanta and the boost period \ref MlfqConfig_t
+	// \param columns receives per-pcb results in the arrays it points to \ref ScheduleColumns_t, NULL for none
+	// \return true if function ran successful else false for an error
+	bool multi_level_feedback_queue(dyn_array_t *ready_queue, ScheduleResult_t *result, const MlfqConfig_t *config, const ScheduleColumns_t *columns);
+
+	// Runs the Completely Fair Scheduler over the incoming ready_queue
+	// The pcb that has had the least weighted CPU time runs next, for its weight's share of the scheduling period.
+	// Weights come from priority, read as nice + 20: priority 20 is nice 0, lower values get more of the CPU.
+	// \param ready queue a dyn_array of type ProcessControlBlock_t that contain be up to N elements
+	// \param result used for completely fair scheduler stat tracking \ref ScheduleResult_t
+	// \param target_latency the period in which every runnable pcb should get to run once
+	// \param min_granularity the shortest slice a pcb is given
+	// \param columns receives per-pcb results in the arrays it points to \ref ScheduleColumns_t, NULL for none
+	// \return true if function ran successful else false for an error
+	bool completely_fair_scheduler(dyn_array_t *ready_queue, ScheduleResult_t *result, size_t target_latency, size_t min_granularity,
+		const ScheduleColumns_t *columns);
+
+	// Runs the Stride Scheduling algorithm over the incoming ready_queue
+	// Each pcb holds priority tickets (0 counts as 1) and gets the CPU in proportion to them, one quantum at a time
+	// \param ready queue a dyn_array of type ProcessControlBlock_t that contain be up to N elements
+	// \param result used for stride scheduling stat tracking \ref ScheduleResult_t
+	// \param quantum the time slice
+	// \param columns receives per-pcb results in the arrays it points to \ref ScheduleColumns_t, NULL for none
+	// \return true if function ran successful else false for an error
+	bool stride_scheduling(dyn_array_t *ready_queue, ScheduleResult_t *result, size_t quantum, const ScheduleColumns_t *columns);
+
 	// Runs the Shortest Remaining Time First Process Scheduling algorithm over the incoming ready_queue
 	// \param ready queue a dyn_array of type ProcessControlBlock_t that contain be up to N elements
 	// \param result used for shortest job first stat tracking \ref ScheduleResult_t
 	// \return true if function ran successful else false for an error
 	bool shortest_remaining_time_first(dyn_array_t *ready_queue, ScheduleResult_t *result);
 
+	// Runs a work-conserving algorithm over the incoming ready_queue with its busy periods spread over several threads
+	// The trace is cut wherever the CPU would sit idle and the pieces are scheduled concurrently, with the same result
+	// as running the algorithm over the whole ready_queue.
+	// \param ready queue a dyn_array of type ProcessControlBlock_t that contain be up to N elements
+	// \param result used for stat tracking \ref ScheduleResult_t
+	// \param algorithm which policy to run
+	// \param quantum the time slice, only used by round robin
+	// \param num_threads how many threads to use, 0 for one per online CPU
+	// \return true if function ran successful else false for an error
+	bool schedule_busy_periods_parallel(dyn_array_t *ready_queue, ScheduleResult_t *result, ScheduleAlgorithm_t algorithm, size_t quantum, size_t num_threads);
+
+	// Runs algorithm over the incoming ready_queue on num_cores virtual CPUs, each with its own run queue
+	// Arrivals are queued on the least loaded core and idle cores steal from the core with the longest queue.
+	// \param ready queue a dyn_array of type ProcessControlBlock_t that contain be up to N elements
+	// \param result used for stat tracking \ref ScheduleResult_t, total_run_time is the CPU time summed over all cores
+	// \param algorithm the policy every core runs
+	// \param quantum the time slice, only used by round robin
+	// \param num_cores how many virtual CPUs to simulate, at least one
+	// \param core_utilization optional, receives num_cores fractions of the time from first arrival to last completion each core was busy
+	// \param columns receives per-pcb results in the arrays it points to \ref ScheduleColumns_t, NULL for none
+	// \return true if function ran successful else false for an error
+	bool schedule_smp(dyn_array_t *ready_queue, ScheduleResult_t *result, ScheduleAlgorithm_t algorithm, size_t quantum, size_t num_cores, float *core_utilization,
+		const ScheduleColumns_t *columns);
+
 #ifdef __cplusplus
 }
 #endif
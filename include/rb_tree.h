@@ -0,0 +1,75 @@
+#ifndef RB_TREE_H
+#define RB_TREE_H
+
+#ifdef __cplusplus
+	extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+	Red-black tree notes!
+
+	This is an intrusive red-black tree of (key, rank) nodes, ordered like the ready heap:
+	  smaller key first, smaller rank on ties.
+
+	The tree never allocates. The caller owns the nodes (usually one array, one node per pcb)
+	  and links and unlinks them; a node can be re-inserted after it was erased.
+
+	The leftmost node is cached, so finding the smallest entry is O(1);
+	  insert and erase are O(log n) and keep the cache up to date.
+*/
+
+typedef struct rb_node
+{
+	struct rb_node *parent;
+	struct rb_node *left;
+	struct rb_node *right;
+	uint64_t key;
+	size_t rank;
+	bool red;
+}
+RbNode_t;
+
+typedef struct
+{
+	RbNode_t *root;
+	RbNode_t *leftmost;
+	size_t size;
+}
+RbTree_t;
+
+///
+/// Sets up an empty tree
+/// \param tree the tree to initialize
+///
+void rb_tree_init(RbTree_t *const tree);
+
+///
+/// Links node into the tree, node's key and rank must be set and it must not be in a tree
+/// \param tree the tree
+/// \param node the node to insert
+///
+void rb_tree_insert(RbTree_t *const tree, RbNode_t *const node);
+
+///
+/// Unlinks node from the tree, node must be in the tree
+/// \param tree the tree
+/// \param node the node to erase
+///
+void rb_tree_erase(RbTree_t *const tree, RbNode_t *const node);
+
+///
+/// Returns the smallest node, O(1)
+/// \param tree the tree
+/// \return the leftmost node, NULL if the tree is empty
+///
+RbNode_t *rb_tree_first(const RbTree_t *const tree);
+
+#ifdef __cplusplus
+	}
+#endif
+
+#endif
@@ -0,0 +1,187 @@
+#ifndef READY_HEAP_H
+#define READY_HEAP_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+/*
+	Ready heap notes!
+
+	This is the ready set used by the event-driven schedulers: a 4-ary min-heap
+	  of (key, rank) entries.
+
+	The key is whatever the policy orders by (burst time, priority, remaining time...).
+	The rank is the pcb's position in arrival order, so ties break by arrival and then
+	  by file order, and every pop is deterministic.
+
+	Keys live inside the entries, so sifting never chases a pointer back into the pcb array.
+	A 4-ary heap is half as deep as a binary one and its children share a cache line.
+
+	Everything is static inline so the comparisons inline into each scheduler's loop.
+*/
+
+#define READY_HEAP_ARITY 4
+
+typedef struct
+{
+	uint64_t key;
+	size_t rank;
+}
+ReadyEntry_t;
+
+typedef struct
+{
+	ReadyEntry_t *entries;
+	size_t size;
+	size_t capacity;
+}
+ReadyHeap_t;
+
+///
+/// Sets up an empty heap with room for capacity entries
+/// \param heap the heap to initialize
+/// \param capacity number of entries to reserve (0 is fine, the heap grows on push)
+/// \return bool representing success of the allocation
+///
+static inline bool ready_heap_init(ReadyHeap_t *heap, size_t capacity)
+{
+	heap->size = 0;
+	heap->capacity = capacity ? capacity : 16;
+	heap->entries = (ReadyEntry_t *)malloc(heap->capacity * sizeof(ReadyEntry_t));
+	return heap->entries != NULL;
+}
+
+///
+/// Releases the heap's storage
+/// \param heap the heap
+///
+static inline void ready_heap_destroy(ReadyHeap_t *heap)
+{
+	free(heap->entries);
+	heap->entries = NULL;
+	heap->size = heap->capacity = 0;
+}
+
+///
+/// Strict ordering of two entries: smaller key first, smaller rank on ties
+///
+static inline bool ready_entry_before(ReadyEntry_t a, ReadyEntry_t b)
+{
+	return a.key < b.key || (a.key == b.key && a.rank < b.rank);
+}
+
+// moves entry down from position i until the heap property holds
+static inline void ready_heap_sift_down(ReadyHeap_t *heap, size_t i, ReadyEntry_t entry)
+{
+	for (;;)
+	{
+		size_t first = READY_HEAP_ARITY * i + 1;
+		if (first >= heap->size)
+		{
+			break;
+		}
+
+		size_t last = first + READY_HEAP_ARITY < heap->size ? first + READY_HEAP_ARITY : heap->size;
+		size_t best = first;
+		for (size_t child = first + 1; child < last; child++)
+		{
+			if (ready_entry_before(heap->entries[child], heap->entries[best]))
+			{
+				best = child;
+			}
+		}
+
+		if (!ready_entry_before(heap->entries[best], entry))
+		{
+			break;
+		}
+		heap->entries[i] = heap->entries[best];
+		i = best;
+	}
+	heap->entries[i] = entry;
+}
+
+///
+/// Inserts an entry, growing the storage if needed
+/// \param heap the heap
+/// \param key the ordering key
+/// \param rank the tie-breaker, normally the pcb's arrival rank
+/// \return bool representing success of the operation (false only if growing failed)
+///
+static inline bool ready_heap_push(ReadyHeap_t *heap, uint64_t key, size_t rank)
+{
+	if (heap->size == heap->capacity)
+	{
+		ReadyEntry_t *grown = (ReadyEntry_t *)realloc(heap->entries, 2 * heap->capacity * sizeof(ReadyEntry_t));
+		if (grown == NULL)
+		{
+			return false;
+		}
+		heap->entries = grown;
+		heap->capacity *= 2;
+	}
+
+	ReadyEntry_t entry = {key, rank};
+	size_t i = heap->size++;
+
+	while (i > 0)
+	{
+		size_t parent = (i - 1) / READY_HEAP_ARITY;
+		if (!ready_entry_before(entry, heap->entries[parent]))
+		{
+			break;
+		}
+		heap->entries[i] = heap->entries[parent];
+		i = parent;
+	}
+	heap->entries[i] = entry;
+	return true;
+}
+
+///
+/// Tests if the heap is empty
+///
+static inline bool ready_heap_empty(const ReadyHeap_t *heap)
+{
+	return heap->size == 0;
+}
+
+///
+/// Returns the smallest entry without removing it, heap must not be empty
+///
+static inline ReadyEntry_t ready_heap_top(const ReadyHeap_t *heap)
+{
+	return heap->entries[0];
+}
+
+///
+/// Removes and returns the smallest entry, heap must not be empty
+///
+static inline ReadyEntry_t ready_heap_pop(ReadyHeap_t *heap)
+{
+	ReadyEntry_t top = heap->entries[0];
+	ReadyEntry_t last = heap->entries[--heap->size];
+
+	if (heap->size > 0)
+	{
+		ready_heap_sift_down(heap, 0, last);
+	}
+	return top;
+}
+
+///
+/// Subtracts base from every key, which keeps their order so the heap needs no fixing
+/// \param heap the heap
+/// \param base at most the smallest key
+///
+static inline void ready_heap_rebase(ReadyHeap_t *heap, uint64_t base)
+{
+	for (size_t i = 0; i < heap->size; i++)
+	{
+		heap->entries[i].key -= base;
+	}
+}
+
+#endif
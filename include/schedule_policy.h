@@ -0,0 +1,318 @@
+#ifndef SCHEDULE_POLICY_H
+#define SCHEDULE_POLICY_H
+
+#ifdef __cplusplus
+	extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "dyn_array.h"
+#include "processing_scheduling.h"
+#include "schedule_totals.h"
+
+/*
+	Schedule policy notes!
+
+	The policy core is the one event-driven simulation loop every scheduler here runs on, with the policy
+	  as a parameter. It owns the clock, the arrival order, the cpus, remaining bursts and the accounting;
+	  the policy only keeps its ready set and answers four questions through SchedulePolicyOps_t:
+
+	  on_arrival   a pcb became ready: it just arrived (from is SCHEDULE_POLICY_ARRIVED) or was taken off cpu from
+	  select       which ready pcb cpu runs next and for how long at most (it leaves the ready set)
+	  preempt      should the pcb running on cpu give up the cpu (NULL: only once its slice is over)
+	  on_complete  the pcb running on cpu finished (NULL: nothing to do)
+
+	preempt is consulted at every decision point: whenever pcbs arrive, whenever another cpu has an event and
+	  whenever the running pcb's slice is over. It gets what is left of the slice (0 once it is over) and may
+	  change it, so a policy wakes itself up for its own events (a quantum, an aging deadline, a boost) simply
+	  by handing out a slice that ends there.
+
+	pcbs are identified by their arrival rank, 0 upward, so ties broken by id are broken by
+	  arrival time and then file order (submission order in a session). At one instant completions come
+	  first, then arrivals, then the pcbs whose slice is over are handled, and then each cpu in turn is
+	  consulted or selects. A streamed run has no pcb count up front, so policies that keep per pcb state
+	  take it from a job pool (job_pool.h) rather than an array indexed by id.
+
+	The loop itself lives in schedule_policy_loop.h and is instantiated three times: schedule_policy_run calls
+	  the hooks of a SchedulePolicyOps_t, picked at runtime, from C++ schedule_policy.hpp instantiates it for a
+	  Policy class so the hooks are direct, inlinable member calls, and schedule_session.c feeds it the pcbs
+	  one submit at a time. The built in schedulers are ops tables of static functions over
+	  schedule_policy_run, so they share its accounting and error handling. The loop keeps what it needs
+	  between instants in a SchedulePolicyCore_t, so it can stop before a time and be resumed later.
+
+	Events are arrivals, completions and slice ends; time jumps straight from one to the next.
+*/
+
+#define SCHEDULE_POLICY_ARRIVED SIZE_MAX	// on_arrival's from for a pcb that just arrived
+#define SCHEDULE_POLICY_IDLE SIZE_MAX		// a cpu with nothing running
+
+typedef struct
+{
+	bool (*on_arrival)(void *state, const ProcessControlBlock_t *pcb, size_t id, uint32_t remaining, uint64_t now, size_t from);
+	bool (*select)(void *state, size_t cpu, uint64_t now, size_t *id, uint64_t *slice);
+	bool (*preempt)(void *state, size_t cpu, size_t running, uint32_t remaining, uint64_t now, uint64_t *slice);
+	void (*on_complete)(void *state, size_t cpu, size_t id, uint64_t now);
+}
+SchedulePolicyOps_t;
+
+// A policy with its state, as the schedule_policy_* constructors build it
+typedef struct
+{
+	const SchedulePolicyOps_t *ops;
+	void *state;					// handed to every hook
+	void (*destroy)(void *state);	// frees state
+	size_t cpus;					// how many cpus it schedules, 1 except for SMP
+}
+SchedulePolicy_t;
+
+// What the loop keeps per cpu
+typedef struct
+{
+	size_t running;		// id, SCHEDULE_POLICY_IDLE for none
+	uint64_t charged;	// the running pcb's remaining burst is up to date as of this time
+	uint64_t slice_end;
+	bool slice_over;	// the slice ended at this instant and the policy hasn't been asked yet
+}
+SchedulePolicyCpu_t;
+
+// What the loop keeps between instants, so a run can stop before some time and carry on from there later
+typedef struct
+{
+	SchedulePolicyCpu_t *cpus;
+	size_t numCpus;
+	uint64_t now;	// the last instant handled
+	size_t ready;	// pcbs the policy holds
+	size_t live;	// pcbs that arrived and haven't finished
+}
+SchedulePolicyCore_t;
+
+///
+/// Sets up the loop's state for a run from time 0 with every cpu idle
+/// \param core the state to set up
+/// \param numCpus number of cpus, at least one
+/// \return true if function ran successful else false for an error
+///
+static inline bool schedule_policy_core_init(SchedulePolicyCore_t *core, size_t numCpus)
+{
+	if (core == NULL || numCpus == 0)
+	{
+		return false;
+	}
+
+	core->cpus = (SchedulePolicyCpu_t *)malloc(numCpus * sizeof(SchedulePolicyCpu_t));
+	if (core->cpus == NULL)
+	{
+		return false;
+	}
+
+	for (size_t c = 0; c < numCpus; c++)
+	{
+		core->cpus[c].running = SCHEDULE_POLICY_IDLE;
+		core->cpus[c].charged = 0;
+		core->cpus[c].slice_end = 0;
+		core->cpus[c].slice_over = false;
+	}
+	core->numCpus = numCpus;
+	core->now = 0;
+	core->ready = 0;
+	core->live = 0;
+	return true;
+}
+
+///
+/// Frees the loop's state
+/// \param core the state, set up by schedule_policy_core_init
+///
+static inline void schedule_policy_core_destroy(SchedulePolicyCore_t *core)
+{
+	free(core->cpus);
+	core->cpus = NULL;
+}
+
+///
+/// Builds the arrival order of the pcbs: order[rank] is the index of the rank-th arrival (ties in file order)
+/// \param pcbs the pcbs
+/// \param numPCBs number of pcbs
+/// \return malloc'd array of numPCBs indices, NULL if the allocation fails
+///
+size_t *schedule_arrival_order(const ProcessControlBlock_t *pcbs, size_t numPCBs);
+
+///
+/// Runs a policy over the pcbs listed in order
+/// \param pcbs the pcbs, left untouched
+/// \param order the arrival order of the pcbs to run, see schedule_arrival_order
+/// \param numPCBs number of pcbs in order, at least one
+/// \param numCpus number of cpus, at least one
+/// \param ops the policy's hooks, on_arrival and select are required
+/// \param state passed to every hook
+/// \param totals receives the statistics, and may already hold earlier parts of the trace
+/// \return true if function ran successful else false for an error (a hook failed or gave a bad answer)
+///
+static inline bool schedule_policy_run(const ProcessControlBlock_t *pcbs, const size_t *order, size_t numPCBs, size_t numCpus,
+	const SchedulePolicyOps_t *ops, void *state, ScheduleTotals_t *totals)
+{
+	uint32_t *remaining = (uint32_t *)malloc(numPCBs * sizeof(uint32_t)); // per id
+	SchedulePolicyCore_t run;
+	SchedulePolicyCore_t *core = &run;
+	size_t nextArrival = 0;
+	uint64_t until = UINT64_MAX;
+	bool success;
+
+	if (remaining == NULL || schedule_policy_core_init(core, numCpus) == false)
+	{
+		free(remaining);
+		return false;
+	}
+
+#define SCHEDULE_POLICY_ON_ARRIVAL(pcb, id, remaining, now, from) ops->on_arrival(state, pcb, id, remaining, now, from)
+#define SCHEDULE_POLICY_SELECT(cpu, now, id, slice) ops->select(state, cpu, now, id, slice)
+#define SCHEDULE_POLICY_PREEMPT(cpu, running, remaining, now, slice) ops->preempt(state, cpu, running, remaining, now, slice)
+#define SCHEDULE_POLICY_ON_COMPLETE(cpu, id, now) ops->on_complete(state, cpu, id, now)
+#define SCHEDULE_POLICY_HAS_PREEMPT (ops->preempt != NULL)
+#define SCHEDULE_POLICY_HAS_ON_COMPLETE (ops->on_complete != NULL)
+#include "schedule_policy_loop.h"
+
+	schedule_policy_core_destroy(core);
+	free(remaining);
+	return success;
+}
+
+///
+/// Runs a policy over ready_queue and leaves it as it was
+/// \param ready_queue a dyn_array of type ProcessControlBlock_t, only read
+/// \param result used for stat tracking \ref ScheduleResult_t
+/// \param ops the policy's hooks, on_arrival and select are required
+/// \param state passed to every hook
+/// \param columns receives per-pcb results in the arrays it points to \ref ScheduleColumns_t, NULL for none
+/// \return true if function ran successful else false for an error
+///
+static inline bool schedule_policy_evaluate(const dyn_array_t *ready_queue, ScheduleResult_t *result, const SchedulePolicyOps_t *ops, void *state,
+	const ScheduleColumns_t *columns)
+{
+	if (ready_queue == NULL || result == NULL || ops == NULL || ops->on_arrival == NULL || ops->select == NULL || dyn_array_size(ready_queue) == 0)
+	{
+		return false;
+	}
+
+	const ProcessControlBlock_t *pcbs = (const ProcessControlBlock_t *)dyn_array_export(ready_queue);
+	size_t numPCBs = dyn_array_size(ready_queue);
+	size_t *order = schedule_arrival_order(pcbs, numPCBs);
+	ScheduleTotals_t totals;
+
+	if (order == NULL)
+	{
+		return false;
+	}
+
+	memset(&totals, 0, sizeof(totals)); // not {0}, the header is compiled as C++ too
+	totals_columns_begin(&totals, columns, pcbs, numPCBs);
+	bool success = schedule_policy_run(pcbs, order, numPCBs, 1, ops, state, &totals);
+	free(order);
+
+	if (success == false)
+	{
+		return false;
+	}
+
+	totals_to_result(&totals, result);
+	return true;
+}
+
+///
+/// Runs a policy over ready_queue and drains it, like the built in schedulers
+/// \param ready_queue a dyn_array of type ProcessControlBlock_t
+/// \param result used for stat tracking \ref ScheduleResult_t
+/// \param ops the policy's hooks, on_arrival and select are required
+/// \param state passed to every hook
+/// \return true if function ran successful else false for an error
+///
+static inline bool schedule_policy_drain(dyn_array_t *ready_queue, ScheduleResult_t *result, const SchedulePolicyOps_t *ops, void *state)
+{
+	if (schedule_policy_evaluate(ready_queue, result, ops, state, NULL) == false)
+	{
+		return false;
+	}
+
+	dyn_array_clear(ready_queue);
+	return true;
+}
+
+///
+/// Runs a policy chosen at runtime over ready_queue and drains it
+/// \param ready_queue a dyn_array of type ProcessControlBlock_t
+/// \param result used for stat tracking \ref ScheduleResult_t
+/// \param ops the policy's hooks, on_arrival and select are required
+/// \param state passed to every hook
+/// \return true if function ran successful else false for an error
+///
+bool schedule_with_policy(dyn_array_t *ready_queue, ScheduleResult_t *result, const SchedulePolicyOps_t *ops, void *state);
+
+///
+/// Builds the policy a ScheduleAlgorithm_t runs, as an ops table and state that can be fed pcbs incrementally
+/// \param policy receives the policy, free it with schedule_policy_destroy
+/// \param algorithm which policy to build
+/// \param quantum the time slice, only used by round robin (where it must not be 0)
+/// \return true if function ran successful else false for an error
+///
+bool schedule_policy_algorithm(SchedulePolicy_t *policy, ScheduleAlgorithm_t algorithm, size_t quantum);
+
+///
+/// Builds preemptive Priority, see priority_preemptive
+/// The aging keys are checked at every arrival, so a stream fails once an arrival could make them overflow.
+/// \param policy receives the policy, free it with schedule_policy_destroy
+/// \param aging_interval a waiting pcb gains one priority level per aging_interval time units, 0 for no aging
+/// \return true if function ran successful else false for an error
+///
+bool schedule_policy_priority_preemptive(SchedulePolicy_t *policy, uint32_t aging_interval);
+
+///
+/// Builds the multi-level feedback queue, see multi_level_feedback_queue
+/// \param policy receives the policy, free it with schedule_policy_destroy
+/// \param config the levels, their quanta and the boost period \ref MlfqConfig_t, copied so it needn't outlive the call
+/// \return true if function ran successful else false for an error
+///
+bool schedule_policy_mlfq(SchedulePolicy_t *policy, const MlfqConfig_t *config);
+
+///
+/// Builds the Completely Fair Scheduler, see completely_fair_scheduler
+/// \param policy receives the policy, free it with schedule_policy_destroy
+/// \param target_latency the period in which every runnable pcb should get to run once
+/// \param min_granularity the shortest slice a pcb is given
+/// \return true if function ran successful else false for an error
+///
+bool schedule_policy_cfs(SchedulePolicy_t *policy, size_t target_latency, size_t min_granularity);
+
+///
+/// Builds stride scheduling, see stride_scheduling
+/// \param policy receives the policy, free it with schedule_policy_destroy
+/// \param quantum the time slice, not 0
+/// \return true if function ran successful else false for an error
+///
+bool schedule_policy_stride(SchedulePolicy_t *policy, size_t quantum);
+
+///
+/// Builds the SMP simulation, see schedule_smp, as a policy over num_cores cpus
+/// \param policy receives the policy, free it with schedule_policy_destroy
+/// \param algorithm the policy every core runs
+/// \param quantum the time slice, only used by round robin (where it must not be 0)
+/// \param num_cores how many virtual CPUs to simulate, at least one
+/// \return true if function ran successful else false for an error
+///
+bool schedule_policy_smp(SchedulePolicy_t *policy, ScheduleAlgorithm_t algorithm, size_t quantum, size_t num_cores);
+
+///
+/// Frees a policy built by one of the schedule_policy_* constructors
+/// \param policy the policy, may be NULL
+///
+void schedule_policy_destroy(SchedulePolicy_t *policy);
+
+#ifdef __cplusplus
+	}
+#endif
+
+#endif
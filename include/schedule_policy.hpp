@@ -0,0 +1,120 @@
+#ifndef SCHEDULE_POLICY_HPP
+#define SCHEDULE_POLICY_HPP
+
+#include "schedule_policy.h"
+
+/*
+	Compile-time policies for the policy core, see schedule_policy.h
+
+	Any class with these members can be scheduled with schedule_with(ready_queue, result, policy):
+
+	  bool on_arrival(const ProcessControlBlock_t *pcb, size_t id, uint32_t remaining, uint64_t now, size_t from);
+	  bool select(size_t cpu, uint64_t now, size_t *id, uint64_t *slice);
+	  bool preempt(size_t cpu, size_t running, uint32_t remaining, uint64_t now, uint64_t *slice);
+	  void on_complete(size_t cpu, size_t id, uint64_t now);
+
+	The hooks mean what they mean in SchedulePolicyOps_t; preempt is required here, a policy that never
+	  preempts returns *slice == 0. schedule_policy_loop is the same loop as schedule_policy_run, instantiated
+	  from schedule_policy_loop.h once per Policy type with the hooks as direct member calls, so there is
+	  no ops table and no indirect call for the compiler to see through.
+*/
+
+///
+/// Runs policy over the pcbs listed in order, schedule_policy_run with the hooks as member calls
+/// \param pcbs the pcbs, left untouched
+/// \param order the arrival order of the pcbs to run, see schedule_arrival_order
+/// \param numPCBs number of pcbs in order, at least one
+/// \param numCpus number of cpus, at least one
+/// \param policy the policy object, its state is kept across the run
+/// \param totals receives the statistics, and may already hold earlier parts of the trace
+/// \return true if function ran successful else false for an error (a hook failed or gave a bad answer)
+///
+template <typename Policy>
+inline bool schedule_policy_loop(const ProcessControlBlock_t *pcbs, const size_t *order, size_t numPCBs, size_t numCpus,
+	Policy &policy, ScheduleTotals_t *totals)
+{
+	uint32_t *remaining = (uint32_t *)malloc(numPCBs * sizeof(uint32_t)); // per id
+	SchedulePolicyCore_t run;
+	SchedulePolicyCore_t *core = &run;
+	size_t nextArrival = 0;
+	uint64_t until = UINT64_MAX;
+	bool success;
+
+	if (remaining == NULL || schedule_policy_core_init(core, numCpus) == false)
+	{
+		free(remaining);
+		return false;
+	}
+
+#define SCHEDULE_POLICY_ON_ARRIVAL(pcb, id, remaining, now, from) policy.on_arrival(pcb, id, remaining, now, from)
+#define SCHEDULE_POLICY_SELECT(cpu, now, id, slice) policy.select(cpu, now, id, slice)
+#define SCHEDULE_POLICY_PREEMPT(cpu, running, remaining, now, slice) policy.preempt(cpu, running, remaining, now, slice)
+#define SCHEDULE_POLICY_ON_COMPLETE(cpu, id, now) policy.on_complete(cpu, id, now)
+#define SCHEDULE_POLICY_HAS_PREEMPT true
+#define SCHEDULE_POLICY_HAS_ON_COMPLETE true
+#include "schedule_policy_loop.h"
+
+	schedule_policy_core_destroy(core);
+	free(remaining);
+	return success;
+}
+
+///
+/// Runs policy over ready_queue and leaves it as it was
+/// \param ready_queue a dyn_array of type ProcessControlBlock_t, only read
+/// \param result used for stat tracking \ref ScheduleResult_t
+/// \param policy the policy object, its state is kept across the run
+/// \param columns receives per-pcb results in the arrays it points to \ref ScheduleColumns_t, NULL for none
+/// \return true if function ran successful else false for an error
+///
+template <typename Policy>
+inline bool schedule_evaluate_with(const dyn_array_t *ready_queue, ScheduleResult_t *result, Policy &policy, const ScheduleColumns_t *columns)
+{
+	if (ready_queue == NULL || result == NULL || dyn_array_size(ready_queue) == 0)
+	{
+		return false;
+	}
+
+	const ProcessControlBlock_t *pcbs = (const ProcessControlBlock_t *)dyn_array_export(ready_queue);
+	size_t numPCBs = dyn_array_size(ready_queue);
+	size_t *order = schedule_arrival_order(pcbs, numPCBs);
+	ScheduleTotals_t totals = {};
+
+	if (order == NULL)
+	{
+		return false;
+	}
+
+	totals_columns_begin(&totals, columns, pcbs, numPCBs);
+	bool success = schedule_policy_loop(pcbs, order, numPCBs, 1, policy, &totals);
+	free(order);
+
+	if (success == false)
+	{
+		return false;
+	}
+
+	totals_to_result(&totals, result);
+	return true;
+}
+
+///
+/// Runs policy over ready_queue and drains it, like the built in schedulers
+/// \param ready_queue a dyn_array of type ProcessControlBlock_t
+/// \param result used for stat tracking \ref ScheduleResult_t
+/// \param policy the policy object, its state is kept across the run
+/// \return true if function ran successful else false for an error
+///
+template <typename Policy>
+inline bool schedule_with(dyn_array_t *ready_queue, ScheduleResult_t *result, Policy &policy)
+{
+	if (schedule_evaluate_with(ready_queue, result, policy, NULL) == false)
+	{
+		return false;
+	}
+
+	dyn_array_clear(ready_queue);
+	return true;
+}
+
+#endif
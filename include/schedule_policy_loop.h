@@ -0,0 +1,167 @@
+/*
+	Schedule policy loop notes!
+
+	This is the body of the policy core's event loop, see schedule_policy.h. It is written once and
+	  instantiated three times, so there is no include guard: schedule_policy.h includes it in
+	  schedule_policy_run, where the hooks are calls through a SchedulePolicyOps_t, schedule_policy.hpp
+	  in a function template, where the hooks are direct member calls on the Policy, and
+	  schedule_session.c in schedule_session_advance, where the pcbs arrive one submit at a time.
+
+	The includer names the loop's state core (a SchedulePolicyCore_t *), totals and until, the loop
+	  handles every instant before until and sets success, and defines the hooks:
+
+	  SCHEDULE_POLICY_ON_ARRIVAL(pcb, id, remaining, now, from)
+	  SCHEDULE_POLICY_SELECT(cpu, now, id, slice)
+	  SCHEDULE_POLICY_PREEMPT(cpu, running, remaining, now, slice)
+	  SCHEDULE_POLICY_ON_COMPLETE(cpu, id, now)
+	  SCHEDULE_POLICY_HAS_PREEMPT and SCHEDULE_POLICY_HAS_ON_COMPLETE, whether those two hooks exist
+
+	The pcbs come from a batch, pcbs listed by order with numPCBs, nextArrival and one remaining burst
+	  per id, unless the includer defines where they come from instead:
+
+	  SCHEDULE_POLICY_NEXT_ARRIVAL   arrival time of the next pcb not handed to the policy yet, UINT64_MAX for none
+	  SCHEDULE_POLICY_ARRIVE(id)     takes that pcb, sets id and its remaining burst
+	  SCHEDULE_POLICY_PCB(id)        the pcb of id, a const ProcessControlBlock_t *
+	  SCHEDULE_POLICY_REMAINING(id)  the remaining burst of id, assignable
+	  SCHEDULE_POLICY_COLUMN(id)     the column id's per-pcb results go in, see ScheduleColumns_t
+	  SCHEDULE_POLICY_LIVE(id)       whether id is a pcb that has arrived and not finished
+	  SCHEDULE_POLICY_FINISHED(id)   id is done, after its completion has been accounted
+
+	All of them are undefined again at the end.
+*/
+
+#ifndef SCHEDULE_POLICY_NEXT_ARRIVAL
+#define SCHEDULE_POLICY_NEXT_ARRIVAL (nextArrival < numPCBs ? (uint64_t)pcbs[order[nextArrival]].arrival : UINT64_MAX)
+#define SCHEDULE_POLICY_ARRIVE(id) ((id) = nextArrival++, remaining[id] = pcbs[order[id]].remaining_burst_time)
+#define SCHEDULE_POLICY_PCB(id) (&pcbs[order[id]])
+#define SCHEDULE_POLICY_REMAINING(id) remaining[id]
+#define SCHEDULE_POLICY_COLUMN(id) order[id]
+#define SCHEDULE_POLICY_LIVE(id) ((id) < nextArrival)
+#define SCHEDULE_POLICY_FINISHED(id)
+#endif
+
+{
+	SchedulePolicyCpu_t *cpus = core->cpus;
+	success = true;
+
+	while (success)
+	{
+		uint64_t next = SCHEDULE_POLICY_NEXT_ARRIVAL; // idle cpus wait for the next arrival
+		for (size_t c = 0; c < core->numCpus; c++)
+		{
+			if (cpus[c].running != SCHEDULE_POLICY_IDLE && cpus[c].slice_end < next)
+			{
+				next = cpus[c].slice_end;
+			}
+		}
+		if (next == UINT64_MAX) // nothing left to wait for: done, unless the policy lost some pcbs
+		{
+			success = core->live == 0;
+			break;
+		}
+		if (next >= until)
+		{
+			break;
+		}
+		uint64_t now = core->now = next;
+
+		for (size_t c = 0; c < core->numCpus; c++) // charge the running pcbs, finish those that are done and flag the slices that ran out
+		{
+			size_t id = cpus[c].running;
+			if (id == SCHEDULE_POLICY_IDLE)
+			{
+				continue;
+			}
+
+			SCHEDULE_POLICY_REMAINING(id) -= (uint32_t)(now - cpus[c].charged);
+			cpus[c].charged = now;
+			if (SCHEDULE_POLICY_REMAINING(id) == 0)
+			{
+				totals_complete_column(totals, SCHEDULE_POLICY_COLUMN(id), SCHEDULE_POLICY_PCB(id), now);
+				cpus[c].running = SCHEDULE_POLICY_IDLE;
+				core->live--;
+				if (SCHEDULE_POLICY_HAS_ON_COMPLETE)
+				{
+					SCHEDULE_POLICY_ON_COMPLETE(c, id, now);
+				}
+				SCHEDULE_POLICY_FINISHED(id);
+			}
+			else
+			{
+				cpus[c].slice_over = cpus[c].slice_end == now;
+			}
+		}
+
+		while (success && SCHEDULE_POLICY_NEXT_ARRIVAL <= now) // arrivals first, ahead of anything handed back at this instant
+		{
+			size_t id;
+			SCHEDULE_POLICY_ARRIVE(id);
+			success = SCHEDULE_POLICY_ON_ARRIVAL(SCHEDULE_POLICY_PCB(id), id, SCHEDULE_POLICY_REMAINING(id), now, SCHEDULE_POLICY_ARRIVED);
+			core->ready++;
+			core->live++;
+		}
+
+		// Every decision point, first for the cpus whose slice ran out and then, cpu by cpu, for the rest: a running
+		// pcb is asked whether it gives up the cpu (NULL preempt: only when its slice is over) and an idle cpu selects
+		for (int pass = 0; pass < 2 && success; pass++)
+		{
+			for (size_t c = 0; c < core->numCpus && success; c++)
+			{
+				size_t id = cpus[c].running;
+				if (id != SCHEDULE_POLICY_IDLE && cpus[c].slice_over == (pass == 0))
+				{
+					uint64_t slice = cpus[c].slice_end - now;
+					uint32_t left = SCHEDULE_POLICY_REMAINING(id);
+					bool preempted = SCHEDULE_POLICY_HAS_PREEMPT ? SCHEDULE_POLICY_PREEMPT(c, id, left, now, &slice) : slice == 0;
+
+					if (preempted)
+					{
+						totals_preempt_column(totals, SCHEDULE_POLICY_COLUMN(id));
+						cpus[c].running = SCHEDULE_POLICY_IDLE;
+						success = SCHEDULE_POLICY_ON_ARRIVAL(SCHEDULE_POLICY_PCB(id), id, left, now, c);
+						core->ready++;
+					}
+					else if (slice == 0) // kept the cpu but gave it no time
+					{
+						success = false;
+					}
+					else
+					{
+						cpus[c].slice_end = now + (slice < left ? slice : left);
+					}
+				}
+
+				if (success && pass == 1 && cpus[c].running == SCHEDULE_POLICY_IDLE && core->ready > 0)
+				{
+					uint64_t slice = UINT64_MAX;
+					success = SCHEDULE_POLICY_SELECT(c, now, &id, &slice) && SCHEDULE_POLICY_LIVE(id) && slice > 0;
+					if (success)
+					{
+						uint32_t left = SCHEDULE_POLICY_REMAINING(id);
+						core->ready--;
+						totals_dispatch_column(totals, SCHEDULE_POLICY_COLUMN(id), SCHEDULE_POLICY_PCB(id), now);
+						cpus[c].running = id;
+						cpus[c].charged = now;
+						cpus[c].slice_end = now + (slice < left ? slice : left);
+					}
+				}
+
+				cpus[c].slice_over = pass == 0 && cpus[c].slice_over; // consulted once per instant
+			}
+		}
+	}
+}
+
+#undef SCHEDULE_POLICY_ON_ARRIVAL
+#undef SCHEDULE_POLICY_SELECT
+#undef SCHEDULE_POLICY_PREEMPT
+#undef SCHEDULE_POLICY_ON_COMPLETE
+#undef SCHEDULE_POLICY_HAS_PREEMPT
+#undef SCHEDULE_POLICY_HAS_ON_COMPLETE
+#undef SCHEDULE_POLICY_NEXT_ARRIVAL
+#undef SCHEDULE_POLICY_ARRIVE
+#undef SCHEDULE_POLICY_PCB
+#undef SCHEDULE_POLICY_REMAINING
+#undef SCHEDULE_POLICY_COLUMN
+#undef SCHEDULE_POLICY_LIVE
+#undef SCHEDULE_POLICY_FINISHED
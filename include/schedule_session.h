@@ -0,0 +1,102 @@
+#ifndef SCHEDULE_SESSION_H
+#define SCHEDULE_SESSION_H
+
+#ifdef __cplusplus
+	extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "processing_scheduling.h"
+#include "schedule_policy.h"
+
+typedef struct schedule_session schedule_session_t;
+
+/*
+	Schedule session notes!
+
+	A session runs a policy over an arrival stream instead of a finished ready_queue: submit pcbs as
+	  they arrive, advance the clock, take snapshots. It is the policy core of schedule_policy.h fed
+	  one submit at a time, the same policy and loop a batch run uses, stopped before each advance's
+	  time and resumed by the next. Any SchedulePolicy_t can be streamed: the ScheduleAlgorithm_t
+	  policies, preemptive Priority, MLFQ, CFS, stride and SMP from their schedule_policy_*
+	  constructors, or a policy of your own.
+
+	pcbs must be submitted in arrival order, and never with an arrival before the session's clock.
+	advance(session, t) simulates everything that happens before t; events at t itself wait for the
+	  next advance, so pcbs arriving at t can still be submitted.
+
+	A session only keeps the pcbs that are submitted but not finished, in a table by submission
+	  order. Finished pcbs are folded into the running totals and dropped from it, so memory follows
+	  the runnable set. Per-pcb columns (schedule_session_columns) are the exception: the caller owns
+	  them and sizes them.
+*/
+
+///
+/// Creates a session with an empty ready set and the clock at 0
+/// \param algorithm the policy to run
+/// \param quantum the time slice, only used by round robin (where it must not be 0)
+/// \return new session pointer, NULL on error
+///
+schedule_session_t *schedule_session_create(ScheduleAlgorithm_t algorithm, size_t quantum);
+
+///
+/// Creates a session that runs any policy, built by a schedule_policy_* constructor or by hand (see schedule_policy.h)
+/// \param policy the policy, the session takes it over and frees it with schedule_policy_destroy, on error too
+/// \return new session pointer, NULL on error
+///
+schedule_session_t *schedule_session_create_policy(const SchedulePolicy_t *policy);
+
+///
+/// Has the session write per-pcb results into columns, indexed by submission order: column i is the i-th submitted pcb
+/// \param session the session, nothing submitted yet
+/// \param columns the caller-owned arrays \ref ScheduleColumns_t, NULL for none
+/// \param capacity how many pcbs the arrays have room for, submitting more fails
+/// \return bool representing success of the operation
+///
+bool schedule_session_columns(schedule_session_t *const session, const ScheduleColumns_t *columns, size_t capacity);
+
+///
+/// Hands the session a pcb, copied, that arrives at pcb->arrival
+/// \param session the session
+/// \param pcb the pcb, its arrival must not be before the last submitted arrival or the session's clock
+/// \return bool representing success of the operation
+///
+bool schedule_session_submit(schedule_session_t *const session, const ProcessControlBlock_t *const pcb);
+
+///
+/// Simulates up to (not including) time, UINT64_MAX runs every submitted pcb to completion
+/// \param session the session
+/// \param time the new clock, not before the current one
+/// \return bool representing success of the operation
+///
+bool schedule_session_advance(schedule_session_t *const session, const uint64_t time);
+
+///
+/// Reports the statistics of the pcbs that finished so far (all zero if none have)
+/// \param session the session
+/// \param result receives the statistics \ref ScheduleResult_t
+/// \return bool representing success of the operation
+///
+bool schedule_session_snapshot(const schedule_session_t *const session, ScheduleResult_t *const result);
+
+///
+/// Returns the number of pcbs submitted but not yet finished
+/// \param session the session
+/// \return the number of live pcbs, 0 on error
+///
+size_t schedule_session_live(const schedule_session_t *const session);
+
+///
+/// Frees the session and any pcbs it still holds
+/// \param session the session
+///
+void schedule_session_destroy(schedule_session_t *const session);
+
+#ifdef __cplusplus
+	}
+#endif
+
+#endif
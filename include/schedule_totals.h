@@ -0,0 +1,200 @@
+#ifndef SCHEDULE_TOTALS_H
+#define SCHEDULE_TOTALS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "latency_histogram.h"
+#include "processing_scheduling.h"
+
+/*
+	Schedule totals notes!
+
+	Every engine accounts for finished pcbs the same way: totals_complete when a pcb finishes,
+	  totals_merge to combine independently scheduled parts of a trace, and totals_to_result at the end.
+
+	Waiting time is turnaround minus burst, so it doesn't matter how often a pcb was preempted.
+	Every finished pcb's waiting and turnaround time also goes into a fixed-size histogram, which is
+	  where the percentiles in ScheduleResult_t come from; totals_merge merges them.
+
+	Per-pcb columns are opt-in: when totals->columns is set, engines also call totals_dispatch each
+	  time a pcb gets the CPU and totals_preempt each time it loses it unfinished. The column index
+	  of a pcb is its offset from totals->pcbs. Without columns both are a single untaken branch.
+	  Engines that don't keep the pcbs in one array (the schedule session) pass the column index
+	  themselves through the _column forms.
+*/
+
+// Running totals kept by the event-driven engines. Everything is 64-bit so traces whose bursts
+// sit near UINT32_MAX can't wrap the clock or the sums.
+typedef struct
+{
+	uint64_t waiting_time;
+	uint64_t turnaround_time;
+	uint64_t run_time;
+	size_t completed;
+	size_t with_deadline;	// pcbs that had a deadline, max_lateness is only meaningful when there were some
+	uint64_t deadline_misses;
+	int64_t max_lateness;
+	LatencyHistogram_t waiting_histogram;
+	LatencyHistogram_t turnaround_histogram;
+	const ScheduleColumns_t *columns;	// per-pcb output, NULL for none
+	const ProcessControlBlock_t *pcbs;	// what the column indices are relative to
+}
+ScheduleTotals_t;
+
+// Gets totals->columns ready for a run: the dispatch columns start out as "never dispatched"
+static inline void totals_columns_begin(ScheduleTotals_t *totals, const ScheduleColumns_t *columns, const ProcessControlBlock_t *pcbs, size_t numPCBs)
+{
+	totals->columns = columns;
+	totals->pcbs = pcbs;
+	if (columns == NULL)
+	{
+		return;
+	}
+
+	for (size_t i = 0; i < numPCBs; i++)
+	{
+		if (columns->first_dispatch != NULL)
+		{
+			columns->first_dispatch[i] = UINT64_MAX;
+		}
+		if (columns->response != NULL)
+		{
+			columns->response[i] = UINT64_MAX;
+		}
+		if (columns->preemptions != NULL)
+		{
+			columns->preemptions[i] = 0;
+		}
+	}
+}
+
+// Records that pcb, in column i, got the CPU at now
+static inline void totals_dispatch_column(ScheduleTotals_t *totals, size_t i, const ProcessControlBlock_t *pcb, uint64_t now)
+{
+	if (totals->columns == NULL)
+	{
+		return;
+	}
+
+	if (totals->columns->first_dispatch != NULL && totals->columns->first_dispatch[i] == UINT64_MAX)
+	{
+		totals->columns->first_dispatch[i] = now;
+	}
+	if (totals->columns->response != NULL && totals->columns->response[i] == UINT64_MAX)
+	{
+		totals->columns->response[i] = now - pcb->arrival;
+	}
+}
+
+// Records that pcb got the CPU at now
+static inline void totals_dispatch(ScheduleTotals_t *totals, const ProcessControlBlock_t *pcb, uint64_t now)
+{
+	if (totals->columns != NULL)
+	{
+		totals_dispatch_column(totals, (size_t)(pcb - totals->pcbs), pcb, now);
+	}
+}
+
+// Records that the pcb in column i lost the CPU before finishing
+static inline void totals_preempt_column(ScheduleTotals_t *totals, size_t i)
+{
+	if (totals->columns != NULL && totals->columns->preemptions != NULL)
+	{
+		totals->columns->preemptions[i]++;
+	}
+}
+
+// Records that pcb lost the CPU before finishing
+static inline void totals_preempt(ScheduleTotals_t *totals, const ProcessControlBlock_t *pcb)
+{
+	if (totals->columns != NULL)
+	{
+		totals_preempt_column(totals, (size_t)(pcb - totals->pcbs));
+	}
+}
+
+// Records a finished pcb, in column i: burst is the pcb's full CPU demand, completion the time it finished
+static inline void totals_complete_column(ScheduleTotals_t *totals, size_t i, const ProcessControlBlock_t *pcb, uint64_t completion)
+{
+	uint64_t turnAroundTime = completion - pcb->arrival;
+	totals->turnaround_time += turnAroundTime;
+	totals->waiting_time += turnAroundTime - pcb->remaining_burst_time;
+	totals->run_time += pcb->remaining_burst_time;
+	totals->completed++;
+	latency_histogram_record(&totals->waiting_histogram, turnAroundTime - pcb->remaining_burst_time);
+	latency_histogram_record(&totals->turnaround_histogram, turnAroundTime);
+
+	if (totals->columns != NULL)
+	{
+		if (totals->columns->completion != NULL)
+		{
+			totals->columns->completion[i] = completion;
+		}
+		if (totals->columns->waiting != NULL)
+		{
+			totals->columns->waiting[i] = turnAroundTime - pcb->remaining_burst_time;
+		}
+	}
+
+	if (pcb->deadline != 0)
+	{
+		int64_t lateness = (int64_t)completion - pcb->deadline;
+		if (totals->with_deadline++ == 0 || lateness > totals->max_lateness)
+		{
+			totals->max_lateness = lateness;
+		}
+		totals->deadline_misses += lateness > 0;
+	}
+}
+
+// Records a finished pcb: burst is the pcb's full CPU demand, completion the time it finished
+static inline void totals_complete(ScheduleTotals_t *totals, const ProcessControlBlock_t *pcb, uint64_t completion)
+{
+	totals_complete_column(totals, totals->columns != NULL ? (size_t)(pcb - totals->pcbs) : 0, pcb, completion);
+}
+
+// Adds the totals of an independent part of the trace (a chunk, a busy period...) into totals
+static inline void totals_merge(ScheduleTotals_t *totals, const ScheduleTotals_t *part)
+{
+	totals->waiting_time += part->waiting_time;
+	totals->turnaround_time += part->turnaround_time;
+	totals->run_time += part->run_time;
+	totals->completed += part->completed;
+	latency_histogram_merge(&totals->waiting_histogram, &part->waiting_histogram);
+	latency_histogram_merge(&totals->turnaround_histogram, &part->turnaround_histogram);
+
+	if (part->with_deadline != 0)
+	{
+		if (totals->with_deadline == 0 || part->max_lateness > totals->max_lateness)
+		{
+			totals->max_lateness = part->max_lateness;
+		}
+		totals->with_deadline += part->with_deadline;
+		totals->deadline_misses += part->deadline_misses;
+	}
+}
+
+// Reads the reported percentiles off a histogram
+static inline void totals_latency(const LatencyHistogram_t *histogram, ScheduleLatency_t *latency)
+{
+	latency->p50 = latency_histogram_percentile(histogram, 50.0);
+	latency->p90 = latency_histogram_percentile(histogram, 90.0);
+	latency->p99 = latency_histogram_percentile(histogram, 99.0);
+	latency->p999 = latency_histogram_percentile(histogram, 99.9);
+	latency->max = histogram->max;
+}
+
+// Turns the totals into the averages reported through ScheduleResult_t
+static inline void totals_to_result(const ScheduleTotals_t *totals, ScheduleResult_t *result)
+{
+	result->average_waiting_time = (float)totals->waiting_time/totals->completed;
+	result->average_turnaround_time = (float)totals->turnaround_time/totals->completed;
+	result->total_run_time = totals->run_time;
+	result->deadline_misses = totals->deadline_misses;
+	result->max_lateness = totals->with_deadline ? totals->max_lateness : 0;
+	totals_latency(&totals->waiting_histogram, &result->waiting_latency);
+	totals_latency(&totals->turnaround_histogram, &result->turnaround_latency);
+}
+
+#endif
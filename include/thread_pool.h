@@ -0,0 +1,68 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#ifdef __cplusplus
+	extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+
+typedef struct thread_pool thread_pool_t;
+
+/*
+	Thread pool notes!
+
+	The pool owns a fixed set of worker threads for its whole lifetime.
+
+	Work is handed out as a parallel for: thread_pool_run(pool, count, task, arg)
+	  calls task(arg, i) once for every i in [0, count) and returns when all of them are done.
+
+	Indices are claimed one at a time from a shared counter, so uneven tasks balance themselves.
+	Keep tasks coarse (a chunk of records, not a single record).
+
+	The calling thread works on the batch too, so a pool of one thread runs everything inline.
+*/
+
+///
+/// Returns the number of online CPUs, at least 1
+/// \return the number of threads a pool should use when the caller has no opinion
+///
+size_t thread_pool_default_threads(void);
+
+///
+/// Creates a pool that runs batches on num_threads threads (including the caller)
+/// \param num_threads number of threads, 0 for thread_pool_default_threads()
+/// \return new thread pool pointer, NULL on error
+///
+thread_pool_t *thread_pool_create(size_t num_threads);
+
+///
+/// Returns the number of threads batches are spread over
+/// \param pool the thread pool
+/// \return the thread count, 0 on error
+///
+size_t thread_pool_size(const thread_pool_t *const pool);
+
+///
+/// Runs task(arg, i) for every i in [0, count) and waits for all of them to finish
+/// Only one batch may run on a pool at a time
+/// \param pool the thread pool
+/// \param count the number of task indices
+/// \param task the function to run
+/// \param arg argument passed to every call (as parameter 1)
+/// \return bool representing success of the operation (really just pointer checks)
+///
+bool thread_pool_run(thread_pool_t *const pool, const size_t count, void (*const task)(void *, size_t), void *arg);
+
+///
+/// Stops and joins the worker threads, then frees the pool
+/// \param pool the thread pool
+///
+void thread_pool_destroy(thread_pool_t *const pool);
+
+#ifdef __cplusplus
+	}
+#endif
+
+#endif
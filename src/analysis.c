@@ -1,7 +1,9 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "dyn_array.h"
+#include "pcb_file.h"
 #include "processing_scheduling.h"
 
 #define FCFS "FCFS"
@@ -9,6 +11,190 @@
 #define RR "RR"
 #define SJF "SJF"
 #define SRT "SRT"
+#define ALL "ALL"
+
+#define MAX_QUANTA 4096
+
+// Parses a quantum argument: one value "5", a list "5,10,20" or an inclusive range "5:50" or "5:50:5"
+// \param arg the argument string
+// \param quanta receives the quanta, up to MAX_QUANTA of them
+// \param num_quanta receives the number of quanta
+// \return true if function ran successful else false for an error
+static bool parse_quanta(const char *arg, size_t *quanta, size_t *num_quanta)
+{
+	char *end;
+	*num_quanta = 0;
+
+	if (strchr(arg, ':') != NULL) // range
+	{
+		unsigned long first = strtoul(arg, &end, 10);
+		if (end == arg || *end != ':')
+		{
+			return false;
+		}
+		const char *next = end + 1;
+		unsigned long last = strtoul(next, &end, 10);
+		if (end == next || (*end != ':' && *end != '\0'))
+		{
+			return false;
+		}
+		unsigned long step = 1;
+		if (*end == ':')
+		{
+			next = end + 1;
+			step = strtoul(next, &end, 10);
+			if (end == next || *end != '\0')
+			{
+				return false;
+			}
+		}
+		if (first == 0 || step == 0 || last < first || (last - first) / step >= MAX_QUANTA)
+		{
+			return false;
+		}
+		for (unsigned long quantum = first; quantum <= last; quantum += step)
+		{
+			quanta[(*num_quanta)++] = quantum;
+			if (last - quantum < step) // the next step would pass last (or wrap)
+			{
+				break;
+			}
+		}
+		return true;
+	}
+
+	for (;;) // list of one or more
+	{
+		unsigned long quantum = strtoul(arg, &end, 10);
+		if (end == arg || quantum == 0 || *num_quanta == MAX_QUANTA || *arg == '-')
+		{
+			return false;
+		}
+		quanta[(*num_quanta)++] = quantum;
+		if (*end == '\0')
+		{
+			return true;
+		}
+		if (*end != ',')
+		{
+			return false;
+		}
+		arg = end + 1;
+	}
+}
+
+// Prints the tail of a latency on one line
+// \param out where to print
+// \param name what the latency is
+// \param latency the percentiles \ref ScheduleLatency_t
+// \return what fprintf returned, negative for an error
+static int print_latency(FILE *out, const char *name, const ScheduleLatency_t *latency)
+{
+	return fprintf(out, "%s p50/p90/p99/p99.9/max: %lu/%lu/%lu/%lu/%lu\n", name, (unsigned long)latency->p50, (unsigned long)latency->p90,
+		(unsigned long)latency->p99, (unsigned long)latency->p999, (unsigned long)latency->max);
+}
+
+// One line of a comparison table
+typedef struct
+{
+	char label[24];
+	ScheduleResult_t result;
+}
+TableRow_t;
+
+// Prints a comparison table, one row per result, to STDOUT and README.md
+// \param heading the title of the label column
+// \param rows the rows
+// \param num_rows number of rows
+// \return EXIT_SUCCESS or EXIT_FAILURE
+static int report_table(const char *heading, const TableRow_t *rows, size_t num_rows)
+{
+	FILE *fptr = fopen("../README.md", "a");
+	FILE *outputs[2] = {stdout, fptr};
+	int status = fptr != NULL ? EXIT_SUCCESS : EXIT_FAILURE; // failure in opening README.md
+
+	for (size_t out = 0; out < 2 && status == EXIT_SUCCESS; out++)
+	{
+		if (fprintf(outputs[out], "%10s  %20s  %23s  %14s\n", heading, "Average Waiting Time", "Average Turnaround Time", "Total Run Time") < 0)
+		{
+			status = EXIT_FAILURE;
+		}
+		for (size_t i = 0; i < num_rows && status == EXIT_SUCCESS; i++)
+		{
+			if (fprintf(outputs[out], "%10s  %20f  %23f  %14lu\n", rows[i].label, rows[i].result.average_waiting_time,
+				rows[i].result.average_turnaround_time, rows[i].result.total_run_time) < 0) // error writing the row
+			{
+				status = EXIT_FAILURE;
+			}
+		}
+	}
+	if (status == EXIT_SUCCESS && fprintf(fptr, "\n") < 0)
+	{
+		status = EXIT_FAILURE;
+	}
+
+	if (fptr != NULL)
+	{
+		fclose(fptr);
+	}
+	return status;
+}
+
+// Runs the Round Robin sweep and prints one row per quantum
+// \param ready_queue the loaded pcbs, left as they are
+// \param quanta the quanta to try
+// \param num_quanta number of quanta
+// \return EXIT_SUCCESS or EXIT_FAILURE
+static int run_quantum_sweep(const dyn_array_t *ready_queue, const size_t *quanta, size_t num_quanta)
+{
+	ScheduleResult_t *results = (ScheduleResult_t *)calloc(num_quanta, sizeof(ScheduleResult_t));
+	TableRow_t *rows = (TableRow_t *)calloc(num_quanta, sizeof(TableRow_t));
+	if (results == NULL || rows == NULL || round_robin_sweep(ready_queue, quanta, num_quanta, results, 0) == false)
+	{
+		free(results);
+		free(rows);
+		printf("Scheduling algorithm failed\n"); // signal error to the user
+		return EXIT_FAILURE;
+	}
+
+	for (size_t i = 0; i < num_quanta; i++)
+	{
+		snprintf(rows[i].label, sizeof(rows[i].label), "%zu", quanta[i]);
+		rows[i].result = results[i];
+	}
+
+	int status = report_table("Quantum", rows, num_quanta);
+	free(results);
+	free(rows);
+	return status;
+}
+
+// Runs FCFS, SJF, P, RR and SRT side by side over the same loaded pcbs and prints one row per algorithm
+// \param ready_queue the loaded pcbs, left as they are
+// \param quantum the round robin quantum
+// \return EXIT_SUCCESS or EXIT_FAILURE
+static int run_all(const dyn_array_t *ready_queue, size_t quantum)
+{
+	const ScheduleAlgorithm_t algorithms[] = {SCHEDULE_FCFS, SCHEDULE_SJF, SCHEDULE_PRIORITY, SCHEDULE_RR, SCHEDULE_SRT};
+	const char *const names[] = {FCFS, SJF, P, RR, SRT};
+	const size_t numAlgorithms = sizeof(algorithms) / sizeof(algorithms[0]);
+	ScheduleResult_t results[sizeof(algorithms) / sizeof(algorithms[0])];
+	TableRow_t rows[sizeof(algorithms) / sizeof(algorithms[0])];
+
+	if (schedule_compare(ready_queue, algorithms, numAlgorithms, quantum, results, 0) == false)
+	{
+		printf("Scheduling algorithm failed\n"); // signal error to the user
+		return EXIT_FAILURE;
+	}
+
+	for (size_t i = 0; i < numAlgorithms; i++)
+	{
+		snprintf(rows[i].label, sizeof(rows[i].label), "%s", names[i]);
+		rows[i].result = results[i];
+	}
+
+	return report_table("Algorithm", rows, numAlgorithms);
+}
 
 // Add and comment your analysis code in this function.
 // THIS IS NOT FINISHED.
@@ -17,12 +203,16 @@ int main(int argc, char **argv)
 	if (argc < 3) 
 	{
 		printf("%s <pcb file> <schedule algorithm> [quantum]\n", argv[0]);
+		printf("  ALL runs FCFS, SJF, P, RR and SRT on one load and compares them, it needs the RR quantum\n");
+		printf("  RR takes one quantum, a list (5,10,20) or a range (5:50 or 5:50:5) to compare them\n");
 		return EXIT_FAILURE;
 	}
 	
 	// Load process control blocks from binary file passed at the command line into a dyn_array (this is your ready queue)
 	char* file = argv[1]; // get binary file
-	dyn_array_t* ready_queue = load_process_control_blocks(file); // create ready_queue by loading in the pcbs from the binary file
+	bool readsPriority = strcmp(argv[2], P) == 0 || strcmp(argv[2], ALL) == 0; // only P reads priorities, a columnar file then skips that column
+	uint32_t columns = pcb_file_policy_columns(readsPriority ? SCHEDULE_PRIORITY : SCHEDULE_FCFS);
+	dyn_array_t* ready_queue = load_process_control_blocks_columns(file, columns); // create ready_queue by mapping the binary file and converting the pcbs in one pass
 	if (ready_queue == NULL) // if we couldn't load the pcbs from the file correctly
 	{
 		printf("Error loading file\n"); // signal error to the user
@@ -55,8 +245,35 @@ int main(int argc, char **argv)
 			dyn_array_destroy(ready_queue); // clean up allocations
 			return EXIT_FAILURE;
 		}
-		size_t quantum = (size_t)argv[3]; // if there is a quantum, collect it
-		schedulingSuccess = round_robin(ready_queue, &result, quantum); // run round_robin and collect results
+		size_t quanta[MAX_QUANTA];
+		size_t numQuanta;
+		if (parse_quanta(argv[3], quanta, &numQuanta) == false) // the quantum must be a positive number, list or range
+		{
+			printf("Invalid quantum\n"); // signal error to the user
+			dyn_array_destroy(ready_queue); // clean up allocations
+			return EXIT_FAILURE;
+		}
+		if (numQuanta > 1) // a sweep, every quantum runs over the same loaded pcbs
+		{
+			int status = run_quantum_sweep(ready_queue, quanta, numQuanta);
+			dyn_array_destroy(ready_queue); // clean up allocations
+			return status;
+		}
+		schedulingSuccess = round_robin(ready_queue, &result, quanta[0]); // run round_robin and collect results
+	}
+	else if (strncmp(algorithm, ALL, 3) == 0 && algorithm[3] == '\0') // if the algorithm string from the command line prompt is ALL exactly
+	{
+		size_t quanta[MAX_QUANTA];
+		size_t numQuanta;
+		if (argc < 4 || parse_quanta(argv[3], quanta, &numQuanta) == false || numQuanta != 1) // RR needs exactly one quantum here
+		{
+			printf("Quantum needed for RR scheduling algorithm\n"); // signal error to the user
+			dyn_array_destroy(ready_queue); // clean up allocations
+			return EXIT_FAILURE;
+		}
+		int status = run_all(ready_queue, quanta[0]);
+		dyn_array_destroy(ready_queue); // clean up allocations
+		return status;
 	}
 	else if (strncmp(algorithm, SRT, 3) == 0 && algorithm[3] == '\0') // if the algorithm string from the command line prompt is SRT exactly
 	{
@@ -84,7 +301,9 @@ int main(int argc, char **argv)
 	// Reporting result times to STDOUT
 	if (printf("Average Waiting Time: %f\n", result.average_waiting_time) < 0 ||
 	printf("Average Turnaround Time: %f\n", result.average_turnaround_time) < 0 ||
-	printf("Total Run Time: %lu\n", result.total_run_time) < 0) // error writing to STDOUT
+	printf("Total Run Time: %lu\n", result.total_run_time) < 0 ||
+	print_latency(stdout, "Waiting Time", &result.waiting_latency) < 0 ||
+	print_latency(stdout, "Turnaround Time", &result.turnaround_latency) < 0) // error writing to STDOUT
 	{
 		return EXIT_FAILURE;
 	}
@@ -99,7 +318,10 @@ int main(int argc, char **argv)
 	// write to the README.md file
 	if (fprintf(fptr, "Average Waiting Time: %f\n", result.average_waiting_time) < 0 ||
 	fprintf(fptr, "Average Turnaround Time: %f\n", result.average_turnaround_time) < 0 ||
-	fprintf(fptr, "Total Run Time: %lu\n\n", result.total_run_time) < 0) // error writing to README.md
+	fprintf(fptr, "Total Run Time: %lu\n", result.total_run_time) < 0 ||
+	print_latency(fptr, "Waiting Time", &result.waiting_latency) < 0 ||
+	print_latency(fptr, "Turnaround Time", &result.turnaround_latency) < 0 ||
+	fprintf(fptr, "\n") < 0) // error writing to README.md
 	{
 		fclose(fptr);
 		return EXIT_FAILURE;
@@ -43,6 +43,9 @@ bool dyn_shift_insert(dyn_array_t *const dyn_array, const size_t position, const
 bool dyn_shift_remove(dyn_array_t *const dyn_array, const size_t position, const size_t count,
 					  const DYN_SHIFT_MODE mode, void *const data_dst);
 
+// Checks to see if the object can handle an increase in size (and optionally increases capacity)
+bool dyn_request_size_increase(dyn_array_t *const dyn_array, const size_t increment);
+
 
 
 ///
@@ -236,6 +239,24 @@ bool dyn_array_push_back(dyn_array_t *const dyn_array, const void *const object)
 	return dyn_array && dyn_shift_insert(dyn_array, dyn_array->size, 1, MODE_INSERT, (void *const) object);
 }
 
+///
+/// Grows the array by count objects at the back, left uninitialized, so they can be filled in bulk
+/// The returned pointer is internal, like dyn_array_export's, and is invalidated by anything that reallocates
+/// \param dyn_array the dynamic array
+/// \param count number of objects to add, at least one
+/// \return Pointer to the first new object, NULL on error
+///
+void *dyn_array_append(dyn_array_t *const dyn_array, const size_t count)
+{
+	if (dyn_array && count && dyn_request_size_increase(dyn_array, count))
+	{
+		void *first = DYN_ARRAY_POSITION(dyn_array, dyn_array->size);
+		dyn_array->size += count;
+		return first;
+	}
+	return NULL;
+}
+
 
 ///
 /// Removes and optionally destructs the object at the back of the array
@@ -496,9 +517,6 @@ bool dyn_array_for_each(dyn_array_t *const dyn_array, void (*const func)(void *c
 //
 
 
-// Checks to see if the object can handle an increase in size (and optionally increases capacity)
-bool dyn_request_size_increase(dyn_array_t *const dyn_array, const size_t increment);
-
 #define MODE_IS_TYPE(mode, type) ((mode) & (type))
 
 // inserting between idx 1 and 2 (between B and C) means you're moving everything from 2 down to make room
@@ -0,0 +1,39 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "pcb_trace.h"
+
+#define DEADLINES "DEADLINES"
+
+// Converts a pcb.bin into a compressed trace, "-" reads stdin or writes stdout so archives can be piped
+int main(int argc, char **argv)
+{
+	if (argc < 3 || (argc > 3 && strcmp(argv[3], DEADLINES) != 0))
+	{
+		printf("%s <pcb file> <trace file> [DEADLINES]\n", argv[0]);
+		printf("  DEADLINES reads records that carry a deadline and keeps it in the trace\n");
+		printf("  - in place of a file name reads stdin or writes stdout\n");
+		return EXIT_FAILURE;
+	}
+
+	FILE *input = strcmp(argv[1], "-") == 0 ? stdin : fopen(argv[1], "rb");
+	FILE *output = strcmp(argv[2], "-") == 0 ? stdout : fopen(argv[2], "wb");
+	bool success = input != NULL && output != NULL && pcb_trace_convert(input, output, argc > 3);
+
+	if (input != NULL && input != stdin)
+	{
+		fclose(input);
+	}
+	if (output != NULL && output != stdout && fclose(output) != 0)
+	{
+		success = false;
+	}
+
+	if (success == false)
+	{
+		fprintf(stderr, "Error converting file\n"); // signal error to the user
+		return EXIT_FAILURE;
+	}
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,951 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "byte_order.h"
+#include "pcb_file.h"
+#include "pcb_trace.h"
+#include "thread_pool.h"
+
+#define PCB_STREAM_BLOCK_RECORDS 65536	// records decoded per read, about 1 MB
+#define PCB_FILE_HEADER_SIZE 32
+#define PCB_FILE_TABLE_ENTRY_SIZE 16	// u64 offset, u64 checksum
+#define PCB_FILE_MAGIC_SIZE 8
+#define PCB_FILE_COLUMN_ALIGNMENT 64	// bytes, a cache line
+
+static const uint8_t pcb_file_magic[PCB_FILE_MAGIC_SIZE] = {'P', 'C', 'B', 'F', 'I', 'L', 'E', '2'};
+
+// Running Fletcher-64 sums, so a section can be summed piece by piece as it streams in
+typedef struct
+{
+	uint64_t low;
+	uint64_t high;
+}
+Checksum_t;
+
+// Adds little-endian words to the sums. They are reduced every 64K words, well inside the ~92K words
+// after which the second sum could overflow 64 bits, and always on return.
+static void checksum_update(Checksum_t *sum, const uint8_t *bytes, size_t words)
+{
+	const uint64_t modulus = 0xFFFFFFFFu;
+
+	while (words > 0)
+	{
+		size_t run = words < 65536 ? words : 65536;
+		for (size_t i = 0; i < run; i++, bytes += 4)
+		{
+			sum->low += le32(bytes);
+			sum->high += sum->low;
+		}
+		sum->low %= modulus;
+		sum->high %= modulus;
+		words -= run;
+	}
+}
+
+static uint64_t block_checksum(const uint8_t *bytes, size_t words)
+{
+	Checksum_t sum = {0, 0};
+	checksum_update(&sum, bytes, words);
+	return sum.high << 32 | sum.low;
+}
+
+// Decodes count records of words uint32_t each (3, or 4 with a deadline) into pcbs
+static void decode_records(ProcessControlBlock_t *pcbs, const uint8_t *bytes, size_t count, size_t words)
+{
+	for (size_t i = 0; i < count; i++, bytes += words * sizeof(uint32_t))
+	{
+		pcbs[i].remaining_burst_time = le32(bytes);
+		pcbs[i].priority = le32(bytes + 4);
+		pcbs[i].arrival = le32(bytes + 8);
+		pcbs[i].deadline = words > 3 ? le32(bytes + 12) : 0;
+		pcbs[i].started = false;
+	}
+}
+
+static void encode_records(uint8_t *bytes, const ProcessControlBlock_t *pcbs, size_t count, size_t words)
+{
+	for (size_t i = 0; i < count; i++, bytes += words * sizeof(uint32_t))
+	{
+		put_le32(bytes, pcbs[i].remaining_burst_time);
+		put_le32(bytes + 4, pcbs[i].priority);
+		put_le32(bytes + 8, pcbs[i].arrival);
+		if (words > 3)
+		{
+			put_le32(bytes + 12, pcbs[i].deadline);
+		}
+	}
+}
+
+// Decodes count little-endian words into one field of the pcbs, leaving the other fields alone
+static void decode_column(ProcessControlBlock_t *pcbs, const uint8_t *bytes, size_t count, PcbColumn_t column)
+{
+	switch (column)
+	{
+		case PCB_COLUMN_BURST:
+			for (size_t i = 0; i < count; i++, bytes += 4)
+			{
+				pcbs[i].remaining_burst_time = le32(bytes);
+			}
+			break;
+		case PCB_COLUMN_PRIORITY:
+			for (size_t i = 0; i < count; i++, bytes += 4)
+			{
+				pcbs[i].priority = le32(bytes);
+			}
+			break;
+		case PCB_COLUMN_ARRIVAL:
+			for (size_t i = 0; i < count; i++, bytes += 4)
+			{
+				pcbs[i].arrival = le32(bytes);
+			}
+			break;
+		case PCB_COLUMN_DEADLINE:
+			for (size_t i = 0; i < count; i++, bytes += 4)
+			{
+				pcbs[i].deadline = le32(bytes);
+			}
+			break;
+		default: // a column this loader doesn't know, skipped
+			break;
+	}
+}
+
+static void encode_column(uint8_t *bytes, const ProcessControlBlock_t *pcbs, size_t count, PcbColumn_t column)
+{
+	for (size_t i = 0; i < count; i++, bytes += 4)
+	{
+		put_le32(bytes, column == PCB_COLUMN_BURST ? pcbs[i].remaining_burst_time : column == PCB_COLUMN_PRIORITY ? pcbs[i].priority :
+			column == PCB_COLUMN_ARRIVAL ? pcbs[i].arrival : pcbs[i].deadline);
+	}
+}
+
+// Whether the pcbs' arrivals never decrease, starting from previous
+static bool arrivals_sorted(const ProcessControlBlock_t *pcbs, size_t count, uint32_t previous)
+{
+	for (size_t i = 0; i < count; i++)
+	{
+		if (pcbs[i].arrival < previous)
+		{
+			return false;
+		}
+		previous = pcbs[i].arrival;
+	}
+	return true;
+}
+
+// The parsed fixed part of a v2 header. A columnar file has one section per column, each count words long,
+// where a row file has one section per block of records.
+typedef struct
+{
+	uint32_t flags;
+	uint64_t count;
+	uint32_t block_records;		// row files only
+	uint64_t num_blocks;		// sections, and so offset table entries
+	size_t record_size;			// bytes a record takes in a section, one word in a column
+}
+PcbFileHeader_t;
+
+// Parses and checks the 32 header bytes after the magic has matched
+static bool parse_header(const uint8_t *bytes, PcbFileHeader_t *header)
+{
+	if (le32(bytes + 8) != PCB_FILE_VERSION)
+	{
+		return false;
+	}
+
+	header->flags = le32(bytes + 12);
+	header->count = le64(bytes + 16);
+
+	if ((header->flags & ~PCB_FILE_KNOWN_FLAGS) != 0 || le32(bytes + 28) != 0)
+	{
+		return false;
+	}
+
+	if (header->flags & PCB_FILE_COLUMNAR)
+	{
+		uint32_t columns = le32(bytes + 24);
+		header->block_records = 0;
+		header->num_blocks = columns;
+		header->record_size = sizeof(uint32_t);
+		// the deadline column is there exactly when the flag says so, columns past it are fields added later
+		return columns >= PCB_COLUMN_DEADLINE && columns <= PCB_FILE_MAX_COLUMNS && (columns > PCB_COLUMN_DEADLINE) == ((header->flags & PCB_FILE_HAS_DEADLINES) != 0);
+	}
+
+	header->block_records = le32(bytes + 24);
+	if (header->block_records > PCB_FILE_MAX_BLOCK_RECORDS || (header->block_records == 0 && header->count != 0))
+	{
+		return false;
+	}
+
+	header->num_blocks = header->count ? (header->count - 1) / header->block_records + 1 : 0;
+	header->record_size = (header->flags & PCB_FILE_HAS_DEADLINES ? 4 : 3) * sizeof(uint32_t);
+	return header->num_blocks <= (SIZE_MAX - PCB_FILE_HEADER_SIZE) / PCB_FILE_TABLE_ENTRY_SIZE;
+}
+
+// Returns how many records a section holds: every record for a column, a block's worth for a row file
+static uint64_t section_records(const PcbFileHeader_t *header, uint64_t section)
+{
+	if (header->flags & PCB_FILE_COLUMNAR)
+	{
+		return header->count;
+	}
+	return section + 1 < header->num_blocks ? header->block_records : header->count - section * header->block_records;
+}
+
+// Reads exactly length bytes, or fails
+static bool read_exact(FILE *stream, uint8_t *bytes, size_t length)
+{
+	return fread(bytes, 1, length, stream) == length;
+}
+
+// Reads past a gap up to the next section, which can't lie behind the stream's position
+static bool skip_to(FILE *stream, uint64_t *position, uint64_t offset)
+{
+	for (uint8_t skipped; *position < offset; (*position)++)
+	{
+		if (read_exact(stream, &skipped, 1) == false)
+		{
+			return false;
+		}
+	}
+	return *position == offset;
+}
+
+// Fails if the stream holds more data past its end
+static bool at_end(FILE *stream)
+{
+	uint8_t extraData;
+	return fread(&extraData, 1, 1, stream) == 0;
+}
+
+// Reads a v2 stream's offset table a chunk of entries at a time into a buffer that grows as it fills,
+// so a corrupt count runs into the end of the stream instead of allocating the whole claimed table up front
+// \return malloc'd table of entries entries, NULL on error
+static uint8_t *read_table(FILE *stream, uint64_t entries)
+{
+	size_t capacity = 1; // entries
+	uint8_t *table = (uint8_t *)malloc(PCB_FILE_TABLE_ENTRY_SIZE);
+
+	for (uint64_t done = 0; table != NULL && done < entries;)
+	{
+		size_t want = entries - done < PCB_STREAM_BLOCK_RECORDS ? (size_t)(entries - done) : PCB_STREAM_BLOCK_RECORDS;
+		uint8_t *grown = table;
+
+		if (capacity < done + want) // doubling, capped at the whole table, which parse_header made sure fits a size_t
+		{
+			while (capacity < done + want)
+			{
+				capacity = capacity < entries / 2 ? capacity * 2 : (size_t)entries;
+			}
+			grown = (uint8_t *)realloc(table, capacity * PCB_FILE_TABLE_ENTRY_SIZE);
+		}
+
+		if (grown == NULL || read_exact(stream, grown + done * PCB_FILE_TABLE_ENTRY_SIZE, want * PCB_FILE_TABLE_ENTRY_SIZE) == false) // out of memory or truncated
+		{
+			free(grown ? grown : table);
+			return NULL;
+		}
+		table = grown;
+		done += want;
+	}
+	return table;
+}
+
+// Reads the rest of a v2 stream, after its header. The blocks must come in file order, as pcb_file_write lays them out.
+static dyn_array_t *stream_load_v2(FILE *stream, const PcbFileHeader_t *header)
+{
+	size_t tableSize = (size_t)header->num_blocks * PCB_FILE_TABLE_ENTRY_SIZE;
+	uint8_t *table = read_table(stream, header->num_blocks);
+	uint8_t *block = (uint8_t *)malloc(header->block_records ? (size_t)header->block_records * header->record_size : 1);
+	dyn_array_t *pcbArray = dyn_array_create(header->count < PCB_STREAM_BLOCK_RECORDS ? header->count : PCB_STREAM_BLOCK_RECORDS,
+		sizeof(ProcessControlBlock_t), NULL);
+	bool success = table != NULL && block != NULL && pcbArray != NULL;
+	uint64_t position = PCB_FILE_HEADER_SIZE + tableSize;
+	uint32_t lastArrival = 0;
+
+	for (uint64_t b = 0; b < header->num_blocks && success; b++)
+	{
+		size_t records = (size_t)section_records(header, b);
+		size_t length = records * header->record_size;
+
+		ProcessControlBlock_t *pcbs = NULL;
+		success = skip_to(stream, &position, le64(table + b * PCB_FILE_TABLE_ENTRY_SIZE)) && read_exact(stream, block, length) &&
+			((header->flags & PCB_FILE_CHECKSUMS) == 0 || block_checksum(block, length / sizeof(uint32_t)) == le64(table + b * PCB_FILE_TABLE_ENTRY_SIZE + 8)) &&
+			(pcbs = (ProcessControlBlock_t *)dyn_array_append(pcbArray, records)) != NULL;
+
+		if (success)
+		{
+			decode_records(pcbs, block, records, header->record_size / sizeof(uint32_t));
+			success = (header->flags & PCB_FILE_ARRIVAL_SORTED) == 0 || arrivals_sorted(pcbs, records, lastArrival);
+			lastArrival = pcbs[records - 1].arrival;
+			position += length;
+		}
+	}
+
+	success = success && at_end(stream);
+	free(table);
+	free(block);
+	if (success == false)
+	{
+		dyn_array_destroy(pcbArray);
+		return NULL;
+	}
+	return pcbArray;
+}
+
+// Reads the rest of a columnar v2 stream, after its header, one chunk of a column at a time.
+// The burst column comes first and grows the array, so a corrupt count fails at the end of the stream, not in malloc.
+static dyn_array_t *stream_load_columns(FILE *stream, const PcbFileHeader_t *header)
+{
+	size_t tableSize = (size_t)header->num_blocks * PCB_FILE_TABLE_ENTRY_SIZE;
+	uint8_t *table = read_table(stream, header->num_blocks);
+	uint8_t *chunk = (uint8_t *)malloc(PCB_STREAM_BLOCK_RECORDS * sizeof(uint32_t));
+	dyn_array_t *pcbArray = dyn_array_create(header->count < PCB_STREAM_BLOCK_RECORDS ? header->count : PCB_STREAM_BLOCK_RECORDS,
+		sizeof(ProcessControlBlock_t), NULL);
+	bool success = table != NULL && chunk != NULL && pcbArray != NULL;
+	uint64_t position = PCB_FILE_HEADER_SIZE + tableSize;
+
+	for (uint64_t c = 0; c < header->num_blocks && success; c++)
+	{
+		Checksum_t sum = {0, 0};
+		uint32_t lastArrival = 0;
+
+		success = skip_to(stream, &position, le64(table + c * PCB_FILE_TABLE_ENTRY_SIZE));
+		for (uint64_t done = 0; done < header->count && success; )
+		{
+			size_t want = header->count - done < PCB_STREAM_BLOCK_RECORDS ? (size_t)(header->count - done) : PCB_STREAM_BLOCK_RECORDS;
+			ProcessControlBlock_t *pcbs = NULL;
+
+			success = read_exact(stream, chunk, want * sizeof(uint32_t));
+			if (success && c == PCB_COLUMN_BURST)
+			{
+				success = (pcbs = (ProcessControlBlock_t *)dyn_array_append(pcbArray, want)) != NULL;
+				if (success)
+				{
+					memset(pcbs, 0, want * sizeof(ProcessControlBlock_t));
+				}
+			}
+			else if (success)
+			{
+				pcbs = (ProcessControlBlock_t *)dyn_array_at(pcbArray, (size_t)done);
+			}
+
+			if (success)
+			{
+				if (header->flags & PCB_FILE_CHECKSUMS)
+				{
+					checksum_update(&sum, chunk, want);
+				}
+				decode_column(pcbs, chunk, want, (PcbColumn_t)c);
+				if (c == PCB_COLUMN_ARRIVAL && (header->flags & PCB_FILE_ARRIVAL_SORTED))
+				{
+					success = arrivals_sorted(pcbs, want, lastArrival);
+					lastArrival = pcbs[want - 1].arrival;
+				}
+				done += want;
+				position += want * sizeof(uint32_t);
+			}
+		}
+
+		success = success && ((header->flags & PCB_FILE_CHECKSUMS) == 0 || (sum.high << 32 | sum.low) == le64(table + c * PCB_FILE_TABLE_ENTRY_SIZE + 8));
+	}
+
+	success = success && at_end(stream);
+	free(table);
+	free(chunk);
+	if (success == false)
+	{
+		dyn_array_destroy(pcbArray);
+		return NULL;
+	}
+	return pcbArray;
+}
+
+// Reads the rest of a v1 stream. carry holds bytes already read past the count (up to 4).
+static dyn_array_t *stream_load_v1(FILE *stream, size_t count, size_t recordSize, const uint8_t *carry, size_t carryLength)
+{
+	size_t blockRecords = count < PCB_STREAM_BLOCK_RECORDS ? count : PCB_STREAM_BLOCK_RECORDS;
+
+	// grown block by block rather than sized from the header, so a corrupt count can't allocate gigabytes up front
+	dyn_array_t *pcbArray = dyn_array_create(blockRecords, sizeof(ProcessControlBlock_t), NULL);
+	uint8_t *block = (uint8_t *)malloc(blockRecords ? blockRecords * recordSize : 1);
+
+	if (pcbArray == NULL || block == NULL)
+	{
+		dyn_array_destroy(pcbArray);
+		free(block);
+		return NULL;
+	}
+
+	for (size_t loaded = 0; loaded < count;)
+	{
+		size_t want = count - loaded < blockRecords ? count - loaded : blockRecords;
+		ProcessControlBlock_t *pcbs = NULL;
+
+		memcpy(block, carry, carryLength);
+		if (read_exact(stream, block + carryLength, want * recordSize - carryLength) == false ||
+			(pcbs = (ProcessControlBlock_t *)dyn_array_append(pcbArray, want)) == NULL) // truncated
+		{
+			dyn_array_destroy(pcbArray);
+			free(block);
+			return NULL;
+		}
+		carryLength = 0;
+		decode_records(pcbs, block, want, recordSize / sizeof(uint32_t));
+		loaded += want;
+	}
+	free(block);
+
+	uint8_t extraData[sizeof(uint32_t)];
+	memcpy(extraData, carry, carryLength); // only still set when there were no records
+	if (read_exact(stream, extraData + carryLength, sizeof(extraData) - carryLength)) // the stream holds more data than it should
+	{
+		dyn_array_destroy(pcbArray);
+		return NULL;
+	}
+	return pcbArray;
+}
+
+dyn_array_t *pcb_stream_load(FILE *const stream, const bool with_deadlines)
+{
+	uint8_t header[PCB_FILE_HEADER_SIZE];
+
+	if (stream == NULL)
+	{
+		return NULL;
+	}
+
+	size_t got = fread(header, 1, PCB_FILE_MAGIC_SIZE, stream);
+	if (got < sizeof(uint32_t))
+	{
+		return NULL;
+	}
+
+	if (got == PCB_FILE_MAGIC_SIZE && memcmp(header, pcb_file_magic, PCB_FILE_MAGIC_SIZE) == 0)
+	{
+		PcbFileHeader_t parsed;
+		if (read_exact(stream, header + PCB_FILE_MAGIC_SIZE, PCB_FILE_HEADER_SIZE - PCB_FILE_MAGIC_SIZE) == false || parse_header(header, &parsed) == false)
+		{
+			return NULL;
+		}
+		return parsed.flags & PCB_FILE_COLUMNAR ? stream_load_columns(stream, &parsed) : stream_load_v2(stream, &parsed);
+	}
+
+	return stream_load_v1(stream, le32(header), (with_deadlines ? 4 : 3) * sizeof(uint32_t), header + sizeof(uint32_t), got - sizeof(uint32_t));
+}
+
+struct pcb_file
+{
+	void *map;				// the whole file
+	size_t length;			// of the mapping
+	size_t count;			// records
+	uint32_t version;
+	uint32_t flags;
+	const PcbRecord_t *records;	// v1 only
+	PcbFileHeader_t header;		// v2 only
+	const uint8_t *table;		// v2 only
+};
+
+// Checks that the v2 sections lie inside the file in order without overlapping, and that the last one ends the file
+static bool check_v2_layout(const pcb_file_t *file)
+{
+	size_t end = PCB_FILE_HEADER_SIZE + (size_t)file->header.num_blocks * PCB_FILE_TABLE_ENTRY_SIZE;
+
+	if (file->length < end)
+	{
+		return false;
+	}
+
+	for (uint64_t b = 0; b < file->header.num_blocks; b++)
+	{
+		uint64_t offset = le64(file->table + b * PCB_FILE_TABLE_ENTRY_SIZE);
+		uint64_t records = section_records(&file->header, b);
+		if (offset < end || offset > file->length || records > (file->length - offset) / file->header.record_size || // overlapping or outside the file
+			offset % sizeof(uint32_t) != 0) // words are read in place
+		{
+			return false;
+		}
+		end = (size_t)(offset + records * file->header.record_size);
+	}
+	return end == file->length; // neither truncated nor carrying extra data
+}
+
+pcb_file_t *pcb_file_map(const char *const input_file)
+{
+	if (input_file == NULL)
+	{
+		return NULL;
+	}
+
+	int fd = open(input_file, O_RDONLY);
+	if (fd < 0)
+	{
+		return NULL;
+	}
+
+	struct stat status;
+	if (fstat(fd, &status) != 0 || (size_t)status.st_size < sizeof(uint32_t))
+	{
+		close(fd);
+		return NULL;
+	}
+
+	size_t length = (size_t)status.st_size;
+	void *map = mmap(NULL, length, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd); // the mapping keeps its own reference
+
+	pcb_file_t *file = (pcb_file_t *)calloc(1, sizeof(pcb_file_t));
+	if (map == MAP_FAILED || file == NULL)
+	{
+		if (map != MAP_FAILED)
+		{
+			munmap(map, length);
+		}
+		free(file);
+		return NULL;
+	}
+
+	const uint8_t *bytes = (const uint8_t *)map;
+	file->map = map;
+	file->length = length;
+	bool valid;
+
+	if (length >= PCB_FILE_HEADER_SIZE && memcmp(bytes, pcb_file_magic, PCB_FILE_MAGIC_SIZE) == 0)
+	{
+		file->version = PCB_FILE_VERSION;
+		file->table = bytes + PCB_FILE_HEADER_SIZE;
+		valid = parse_header(bytes, &file->header) && file->header.count <= SIZE_MAX / sizeof(ProcessControlBlock_t) && check_v2_layout(file);
+		file->count = (size_t)file->header.count;
+		file->flags = file->header.flags;
+	}
+	else
+	{
+		size_t count = le32(bytes);
+		size_t payload = length - sizeof(uint32_t);
+		file->version = 1;
+		file->count = count;
+		file->records = (const PcbRecord_t *)((const uint32_t *)map + 1); // 4-byte aligned, as the records need
+		valid = payload / sizeof(PcbRecord_t) >= count && payload - count * sizeof(PcbRecord_t) < sizeof(uint32_t); // neither truncated nor carrying extra data
+	}
+
+	if (valid == false)
+	{
+		pcb_file_unmap(file);
+		return NULL;
+	}
+
+	if ((file->flags & PCB_FILE_COLUMNAR) == 0) // a columnar file only reads ahead the columns a load asks for
+	{
+		posix_madvise(map, length, POSIX_MADV_SEQUENTIAL);
+	}
+	return file;
+}
+
+size_t pcb_file_size(const pcb_file_t *const file)
+{
+	return file ? file->count : 0;
+}
+
+uint32_t pcb_file_version(const pcb_file_t *const file)
+{
+	return file ? file->version : 0;
+}
+
+uint32_t pcb_file_flags(const pcb_file_t *const file)
+{
+	return file ? file->flags : 0;
+}
+
+const PcbRecord_t *pcb_file_records(const pcb_file_t *const file)
+{
+	return file && file->count ? file->records : NULL;
+}
+
+const uint32_t *pcb_file_column(const pcb_file_t *const file, const PcbColumn_t column)
+{
+	if (file == NULL || file->count == 0 || (file->flags & PCB_FILE_COLUMNAR) == 0 || (uint64_t)column >= file->header.num_blocks)
+	{
+		return NULL;
+	}
+	return (const uint32_t *)((const uint8_t *)file->map + le64(file->table + column * PCB_FILE_TABLE_ENTRY_SIZE));
+}
+
+uint32_t pcb_file_policy_columns(const ScheduleAlgorithm_t algorithm)
+{
+	uint32_t columns = PCB_COLUMN_BIT(PCB_COLUMN_BURST) | PCB_COLUMN_BIT(PCB_COLUMN_ARRIVAL); // every policy runs bursts as they arrive
+
+	if (algorithm == SCHEDULE_PRIORITY)
+	{
+		columns |= PCB_COLUMN_BIT(PCB_COLUMN_PRIORITY);
+	}
+	else if (algorithm == SCHEDULE_EDF || algorithm == SCHEDULE_EDF_PREEMPTIVE)
+	{
+		columns |= PCB_COLUMN_BIT(PCB_COLUMN_DEADLINE);
+	}
+	return columns;
+}
+
+// v2 blocks decoded on the thread pool, one block per task
+typedef struct
+{
+	const pcb_file_t *file;
+	ProcessControlBlock_t *pcbs;
+	bool *succeeded;
+}
+BlockDecode_t;
+
+static void decode_block(void *arg, size_t index)
+{
+	const BlockDecode_t *decode = (const BlockDecode_t *)arg;
+	const PcbFileHeader_t *header = &decode->file->header;
+	const uint8_t *entry = decode->file->table + index * PCB_FILE_TABLE_ENTRY_SIZE;
+	const uint8_t *bytes = (const uint8_t *)decode->file->map + le64(entry);
+	size_t first = index * (size_t)header->block_records;
+	size_t records = index + 1 < header->num_blocks ? header->block_records : decode->file->count - first;
+	size_t words = header->record_size / sizeof(uint32_t);
+
+	if ((header->flags & PCB_FILE_CHECKSUMS) != 0 && block_checksum(bytes, records * words) != le64(entry + 8))
+	{
+		decode->succeeded[index] = false;
+		return;
+	}
+
+	decode_records(decode->pcbs + first, bytes, records, words);
+
+	// a sorted file must really be sorted, the block's first arrival is checked against the last one of the block before
+	decode->succeeded[index] = (header->flags & PCB_FILE_ARRIVAL_SORTED) == 0 ||
+		arrivals_sorted(decode->pcbs + first, records, index ? le32((const uint8_t *)decode->file->map + le64(entry - PCB_FILE_TABLE_ENTRY_SIZE) +
+			(header->block_records - 1) * header->record_size + 8) : 0);
+}
+
+// Columns of a columnar file decoded on the thread pool, one column per task
+typedef struct
+{
+	const pcb_file_t *file;
+	ProcessControlBlock_t *pcbs;
+	const PcbColumn_t *columns;
+	bool *succeeded;
+}
+ColumnDecode_t;
+
+static void decode_column_task(void *arg, size_t index)
+{
+	const ColumnDecode_t *decode = (const ColumnDecode_t *)arg;
+	const PcbColumn_t column = decode->columns[index];
+	const uint8_t *entry = decode->file->table + column * PCB_FILE_TABLE_ENTRY_SIZE;
+	const uint8_t *bytes = (const uint8_t *)decode->file->map + le64(entry);
+
+	if ((decode->file->flags & PCB_FILE_CHECKSUMS) != 0 && block_checksum(bytes, decode->file->count) != le64(entry + 8))
+	{
+		decode->succeeded[index] = false;
+		return;
+	}
+
+	decode_column(decode->pcbs, bytes, decode->file->count, column);
+	decode->succeeded[index] = column != PCB_COLUMN_ARRIVAL || (decode->file->flags & PCB_FILE_ARRIVAL_SORTED) == 0 ||
+		arrivals_sorted(decode->pcbs, decode->file->count, 0);
+}
+
+// Decodes the wanted columns of a columnar file, each one only touching its own section of the mapping
+static bool decode_columns(const pcb_file_t *file, ProcessControlBlock_t *pcbs, uint32_t columns)
+{
+	PcbColumn_t wanted[PCB_COLUMN_KNOWN];
+	bool succeeded[PCB_COLUMN_KNOWN] = {false};
+	size_t numWanted = 0;
+	long pageSize = sysconf(_SC_PAGESIZE);
+
+	memset(pcbs, 0, file->count * sizeof(ProcessControlBlock_t)); // columns that aren't loaded read as 0
+	for (PcbColumn_t column = PCB_COLUMN_BURST; column < PCB_COLUMN_KNOWN; column = (PcbColumn_t)(column + 1))
+	{
+		if ((columns & PCB_COLUMN_BIT(column)) != 0 && (uint64_t)column < file->header.num_blocks)
+		{
+			wanted[numWanted++] = column;
+			if (pageSize > 0) // read ahead this column only, from the page it starts on
+			{
+				size_t offset = (size_t)le64(file->table + column * PCB_FILE_TABLE_ENTRY_SIZE);
+				size_t start = offset - offset % (size_t)pageSize;
+				posix_madvise((uint8_t *)file->map + start, offset - start + file->count * sizeof(uint32_t), POSIX_MADV_WILLNEED);
+			}
+		}
+	}
+
+	thread_pool_t *pool = numWanted > 1 ? thread_pool_create(numWanted) : NULL;
+	ColumnDecode_t decode = {file, pcbs, wanted, succeeded};
+	if (pool != NULL)
+	{
+		thread_pool_run(pool, numWanted, decode_column_task, &decode);
+		thread_pool_destroy(pool);
+	}
+	else
+	{
+		for (size_t i = 0; i < numWanted; i++)
+		{
+			decode_column_task(&decode, i);
+		}
+	}
+
+	for (size_t i = 0; i < numWanted; i++)
+	{
+		if (succeeded[i] == false)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+// Zeroes the fields of row decoded pcbs that weren't asked for, so every format projects the same way
+static void clear_columns(ProcessControlBlock_t *pcbs, size_t count, uint32_t columns)
+{
+	if ((columns & PCB_COLUMNS_ALL) == PCB_COLUMNS_ALL)
+	{
+		return;
+	}
+
+	for (size_t i = 0; i < count; i++)
+	{
+		pcbs[i].remaining_burst_time = columns & PCB_COLUMN_BIT(PCB_COLUMN_BURST) ? pcbs[i].remaining_burst_time : 0;
+		pcbs[i].priority = columns & PCB_COLUMN_BIT(PCB_COLUMN_PRIORITY) ? pcbs[i].priority : 0;
+		pcbs[i].arrival = columns & PCB_COLUMN_BIT(PCB_COLUMN_ARRIVAL) ? pcbs[i].arrival : 0;
+		pcbs[i].deadline = columns & PCB_COLUMN_BIT(PCB_COLUMN_DEADLINE) ? pcbs[i].deadline : 0;
+	}
+}
+
+dyn_array_t *pcb_file_to_dyn_array(const pcb_file_t *const file)
+{
+	return pcb_file_to_dyn_array_columns(file, PCB_COLUMNS_ALL);
+}
+
+dyn_array_t *pcb_file_to_dyn_array_columns(const pcb_file_t *const file, const uint32_t columns)
+{
+	if (file == NULL)
+	{
+		return NULL;
+	}
+
+	dyn_array_t *pcbArray = dyn_array_create(file->count, sizeof(ProcessControlBlock_t), NULL);
+	if (pcbArray == NULL || file->count == 0)
+	{
+		return pcbArray;
+	}
+
+	ProcessControlBlock_t *pcbs = (ProcessControlBlock_t *)dyn_array_append(pcbArray, file->count);
+	if (pcbs == NULL)
+	{
+		dyn_array_destroy(pcbArray);
+		return NULL;
+	}
+
+	if (file->version == 1)
+	{
+		decode_records(pcbs, (const uint8_t *)file->records, file->count, 3);
+		clear_columns(pcbs, file->count, columns);
+		return pcbArray;
+	}
+
+	if (file->flags & PCB_FILE_COLUMNAR)
+	{
+		if (decode_columns(file, pcbs, columns) == false)
+		{
+			dyn_array_destroy(pcbArray);
+			return NULL;
+		}
+		return pcbArray;
+	}
+
+	size_t numBlocks = (size_t)file->header.num_blocks;
+	bool *succeeded = (bool *)calloc(numBlocks, sizeof(bool));
+	thread_pool_t *pool = numBlocks > 1 ? thread_pool_create(0) : NULL;
+	bool success = succeeded != NULL && (numBlocks == 1 || pool != NULL);
+
+	if (success)
+	{
+		BlockDecode_t decode = {file, pcbs, succeeded};
+		if (pool != NULL)
+		{
+			thread_pool_run(pool, numBlocks, decode_block, &decode);
+		}
+		else
+		{
+			decode_block(&decode, 0);
+		}
+	}
+
+	for (size_t b = 0; b < numBlocks && success; b++)
+	{
+		success = succeeded[b];
+	}
+
+	thread_pool_destroy(pool);
+	free(succeeded);
+	if (success == false)
+	{
+		dyn_array_destroy(pcbArray);
+		return NULL;
+	}
+	clear_columns(pcbs, file->count, columns);
+	return pcbArray;
+}
+
+void pcb_file_unmap(pcb_file_t *const file)
+{
+	if (file)
+	{
+		munmap(file->map, file->length);
+		free(file);
+	}
+}
+
+dyn_array_t *load_process_control_blocks_mapped(const char *const input_file)
+{
+	pcb_file_t *file = pcb_file_map(input_file);
+	dyn_array_t *pcbArray = pcb_file_to_dyn_array(file);
+	pcb_file_unmap(file);
+	return pcbArray;
+}
+
+dyn_array_t *load_process_control_blocks_columns(const char *const input_file, const uint32_t columns)
+{
+	pcb_file_t *file = pcb_file_map(input_file);
+	if (file == NULL) // a compressed trace can't be mapped, it's decoded whole
+	{
+		dyn_array_t *pcbArray = pcb_file_load(input_file, false);
+		if (pcbArray != NULL)
+		{
+			clear_columns((ProcessControlBlock_t *)dyn_array_export(pcbArray), dyn_array_size(pcbArray), columns);
+		}
+		return pcbArray;
+	}
+
+	dyn_array_t *pcbArray = pcb_file_to_dyn_array_columns(file, columns);
+	pcb_file_unmap(file);
+	return pcbArray;
+}
+
+dyn_array_t *pcb_file_load(const char *const input_file, const bool with_deadlines)
+{
+	if (input_file == NULL)
+	{
+		return NULL;
+	}
+
+	FILE *fptr = fopen(input_file, "rb");
+	if (fptr == NULL)
+	{
+		return NULL;
+	}
+
+	uint8_t magic[PCB_FILE_MAGIC_SIZE] = {0};
+	bool versioned = fread(magic, 1, sizeof(magic), fptr) == sizeof(magic) && memcmp(magic, pcb_file_magic, sizeof(magic)) == 0;
+	dyn_array_t *pcbArray = NULL;
+
+	if (versioned) // a v2 file is mapped so its blocks decode in parallel
+	{
+		pcbArray = load_process_control_blocks_mapped(input_file);
+	}
+	else if (fseek(fptr, 0, SEEK_SET) == 0)
+	{
+		bool trace = memcmp(magic, PCB_TRACE_MAGIC, sizeof(magic)) == 0; // a file shorter than the magic left it zeroed
+		pcbArray = trace ? pcb_trace_load(fptr) : pcb_stream_load(fptr, with_deadlines);
+	}
+	fclose(fptr);
+	return pcbArray;
+}
+
+// Writes each column of a columnar file in chunks, filling in its table entry. Every column starts on a
+// cache line of the file, so a mapped column is an aligned array.
+static bool write_columns(FILE *fptr, const ProcessControlBlock_t *pcbs, size_t count, size_t numColumns, uint32_t flags, uint8_t *table)
+{
+	uint8_t *chunk = (uint8_t *)malloc(PCB_STREAM_BLOCK_RECORDS * sizeof(uint32_t));
+	uint64_t position = PCB_FILE_HEADER_SIZE + numColumns * PCB_FILE_TABLE_ENTRY_SIZE;
+	bool success = chunk != NULL;
+
+	for (size_t c = 0; c < numColumns && success; c++)
+	{
+		Checksum_t sum = {0, 0};
+
+		for (; position % PCB_FILE_COLUMN_ALIGNMENT != 0 && success; position++)
+		{
+			success = fputc(0, fptr) != EOF;
+		}
+		put_le64(table + c * PCB_FILE_TABLE_ENTRY_SIZE, position);
+
+		for (size_t done = 0; done < count && success;)
+		{
+			size_t want = count - done < PCB_STREAM_BLOCK_RECORDS ? count - done : PCB_STREAM_BLOCK_RECORDS;
+			encode_column(chunk, pcbs + done, want, (PcbColumn_t)c);
+			checksum_update(&sum, chunk, want);
+			success = fwrite(chunk, sizeof(uint32_t), want, fptr) == want;
+			done += want;
+			position += want * sizeof(uint32_t);
+		}
+		put_le64(table + c * PCB_FILE_TABLE_ENTRY_SIZE + 8, flags & PCB_FILE_CHECKSUMS ? sum.high << 32 | sum.low : 0);
+	}
+
+	free(chunk);
+	return success;
+}
+
+bool pcb_file_write(const char *const output_file, const dyn_array_t *const ready_queue, const uint32_t flags, const size_t block_records)
+{
+	if (output_file == NULL || ready_queue == NULL || (flags & ~(PCB_FILE_HAS_DEADLINES | PCB_FILE_CHECKSUMS | PCB_FILE_COLUMNAR)) != 0 ||
+		block_records > PCB_FILE_MAX_BLOCK_RECORDS)
+	{
+		return false;
+	}
+
+	const ProcessControlBlock_t *pcbs = (const ProcessControlBlock_t *)dyn_array_export(ready_queue);
+	size_t count = dyn_array_size(ready_queue);
+	size_t blockRecords = block_records ? block_records : PCB_STREAM_BLOCK_RECORDS;
+	size_t words = flags & PCB_FILE_HAS_DEADLINES ? 4 : 3;
+	size_t numBlocks = flags & PCB_FILE_COLUMNAR ? words : count ? (count - 1) / blockRecords + 1 : 0;
+	size_t tableSize = numBlocks * PCB_FILE_TABLE_ENTRY_SIZE;
+	uint32_t fileFlags = flags | (arrivals_sorted(pcbs, count, 0) ? PCB_FILE_ARRIVAL_SORTED : 0);
+
+	uint8_t header[PCB_FILE_HEADER_SIZE] = {0};
+	memcpy(header, pcb_file_magic, PCB_FILE_MAGIC_SIZE);
+	put_le32(header + 8, PCB_FILE_VERSION);
+	put_le32(header + 12, fileFlags);
+	put_le64(header + 16, count);
+	put_le32(header + 24, (uint32_t)(flags & PCB_FILE_COLUMNAR ? words : blockRecords));
+
+	uint8_t *table = (uint8_t *)calloc(tableSize ? tableSize : 1, 1);
+	uint8_t *block = (uint8_t *)malloc((count < blockRecords ? count : blockRecords) * words * sizeof(uint32_t) + 1);
+	FILE *fptr = fopen(output_file, "wb");
+	bool success = table != NULL && block != NULL && fptr != NULL &&
+		fwrite(header, sizeof(header), 1, fptr) == 1 && fwrite(table, 1, tableSize, fptr) == tableSize; // the table is rewritten once the checksums are known
+
+	if (flags & PCB_FILE_COLUMNAR)
+	{
+		success = success && write_columns(fptr, pcbs, count, words, flags, table);
+		numBlocks = 0;
+	}
+
+	for (size_t b = 0; b < numBlocks && success; b++)
+	{
+		size_t first = b * blockRecords;
+		size_t records = count - first < blockRecords ? count - first : blockRecords;
+		size_t length = records * words * sizeof(uint32_t);
+
+		encode_records(block, pcbs + first, records, words);
+		put_le64(table + b * PCB_FILE_TABLE_ENTRY_SIZE, PCB_FILE_HEADER_SIZE + tableSize + first * words * sizeof(uint32_t));
+		put_le64(table + b * PCB_FILE_TABLE_ENTRY_SIZE + 8, flags & PCB_FILE_CHECKSUMS ? block_checksum(block, length / sizeof(uint32_t)) : 0);
+		success = fwrite(block, 1, length, fptr) == length;
+	}
+
+	success = success && fseek(fptr, PCB_FILE_HEADER_SIZE, SEEK_SET) == 0 && fwrite(table, 1, tableSize, fptr) == tableSize;
+
+	if (fptr != NULL && fclose(fptr) != 0)
+	{
+		success = false;
+	}
+	free(table);
+	free(block);
+	return success;
+}
@@ -0,0 +1,389 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "byte_order.h"
+#include "pcb_trace.h"
+#include "schedule_session.h"
+
+#define PCB_TRACE_BUFFER_SIZE 65536		// bytes read or written at a time
+#define PCB_TRACE_HEADER_SIZE 24
+#define PCB_TRACE_MAGIC_SIZE 8
+#define PCB_TRACE_VARINT_MAX 5			// bytes, enough for 35 bits: a uint32_t or the zigzag of a difference of two
+#define PCB_TRACE_RECORD_MAX (4 * PCB_TRACE_VARINT_MAX)
+#define PCB_TRACE_CHUNK 4096			// records decoded per read while loading or replaying
+#define PCB_TRACE_CONVERT_BLOCK 65536	// pcb.bin records read per block while converting
+
+// Maps a signed difference onto small unsigned values: 0, -1, 1, -2 ... become 0, 1, 2, 3 ...
+static inline uint64_t zigzag(int64_t value)
+{
+	return value < 0 ? ((uint64_t)(-(value + 1)) << 1) | 1 : (uint64_t)value << 1;
+}
+
+static inline int64_t unzigzag(uint64_t value)
+{
+	return value & 1 ? -(int64_t)(value >> 1) - 1 : (int64_t)(value >> 1);
+}
+
+static inline uint8_t *put_varint(uint8_t *bytes, uint64_t value)
+{
+	while (value >= 0x80)
+	{
+		*bytes++ = (uint8_t)(value | 0x80);
+		value >>= 7;
+	}
+	*bytes++ = (uint8_t)value;
+	return bytes;
+}
+
+// Decodes one varint of at most PCB_TRACE_VARINT_MAX bytes without reading past end
+// \return pointer past the varint, NULL if it's cut off or too long
+static inline const uint8_t *get_varint(const uint8_t *bytes, const uint8_t *end, uint64_t *value)
+{
+	uint64_t decoded = 0;
+
+	for (unsigned shift = 0; shift < 7 * PCB_TRACE_VARINT_MAX && bytes < end; shift += 7)
+	{
+		uint8_t byte = *bytes++;
+		decoded |= (uint64_t)(byte & 0x7F) << shift;
+		if ((byte & 0x80) == 0)
+		{
+			*value = decoded;
+			return bytes;
+		}
+	}
+	return NULL;
+}
+
+// Buffered encoder shared by pcb_trace_write and pcb_trace_convert
+typedef struct
+{
+	FILE *output;
+	uint8_t *buffer;
+	size_t length;
+	uint32_t flags;
+	uint32_t arrival;	// of the last record written
+	bool failed;
+}
+TraceWriter_t;
+
+static bool writer_begin(TraceWriter_t *writer, FILE *output, uint32_t flags, uint64_t count)
+{
+	uint8_t header[PCB_TRACE_HEADER_SIZE] = {0};
+	memcpy(header, PCB_TRACE_MAGIC, PCB_TRACE_MAGIC_SIZE);
+	put_le32(header + 8, flags);
+	put_le64(header + 16, count);
+
+	writer->output = output;
+	writer->buffer = (uint8_t *)malloc(PCB_TRACE_BUFFER_SIZE);
+	writer->length = 0;
+	writer->flags = flags;
+	writer->arrival = 0;
+	writer->failed = writer->buffer == NULL || fwrite(header, sizeof(header), 1, output) != 1;
+	return writer->failed == false;
+}
+
+static void writer_flush(TraceWriter_t *writer)
+{
+	if (writer->failed == false && fwrite(writer->buffer, 1, writer->length, writer->output) != writer->length)
+	{
+		writer->failed = true;
+	}
+	writer->length = 0;
+}
+
+static void writer_put(TraceWriter_t *writer, const ProcessControlBlock_t *pcb)
+{
+	if (writer->length > PCB_TRACE_BUFFER_SIZE - PCB_TRACE_RECORD_MAX)
+	{
+		writer_flush(writer);
+	}
+
+	uint8_t *bytes = writer->buffer + writer->length;
+	bytes = put_varint(bytes, zigzag((int64_t)pcb->arrival - (int64_t)writer->arrival));
+	bytes = put_varint(bytes, pcb->remaining_burst_time);
+	bytes = put_varint(bytes, pcb->priority);
+	if (writer->flags & PCB_TRACE_HAS_DEADLINES)
+	{
+		bytes = put_varint(bytes, zigzag((int64_t)pcb->deadline - (int64_t)pcb->arrival));
+	}
+	writer->length = (size_t)(bytes - writer->buffer);
+	writer->arrival = pcb->arrival;
+}
+
+// Flushes what's left and frees the buffer
+// \return true if every write succeeded
+static bool writer_end(TraceWriter_t *writer)
+{
+	if (writer->buffer != NULL)
+	{
+		writer_flush(writer);
+	}
+	free(writer->buffer);
+	return writer->failed == false && fflush(writer->output) == 0;
+}
+
+bool pcb_trace_write(FILE *const output, const dyn_array_t *const ready_queue, const uint32_t flags)
+{
+	if (output == NULL || ready_queue == NULL || (flags & ~PCB_TRACE_HAS_DEADLINES) != 0)
+	{
+		return false;
+	}
+
+	const ProcessControlBlock_t *pcbs = (const ProcessControlBlock_t *)dyn_array_export(ready_queue);
+	size_t count = dyn_array_size(ready_queue);
+	TraceWriter_t writer;
+
+	if (writer_begin(&writer, output, flags, count))
+	{
+		for (size_t i = 0; i < count; i++)
+		{
+			writer_put(&writer, &pcbs[i]);
+		}
+	}
+	return writer_end(&writer);
+}
+
+bool pcb_trace_convert(FILE *const input, FILE *const output, const bool with_deadlines)
+{
+	if (input == NULL || output == NULL)
+	{
+		return false;
+	}
+
+	uint8_t countBytes[sizeof(uint32_t)];
+	if (fread(countBytes, sizeof(countBytes), 1, input) != 1)
+	{
+		return false;
+	}
+
+	size_t count = le32(countBytes);
+	size_t words = with_deadlines ? 4 : 3;
+	size_t blockRecords = count < PCB_TRACE_CONVERT_BLOCK ? count : PCB_TRACE_CONVERT_BLOCK;
+	uint8_t *block = (uint8_t *)malloc(blockRecords * words * sizeof(uint32_t) + 1);
+	TraceWriter_t writer;
+	bool success = block != NULL && writer_begin(&writer, output, with_deadlines ? PCB_TRACE_HAS_DEADLINES : 0, count);
+
+	for (size_t done = 0; done < count && success;)
+	{
+		size_t want = count - done < blockRecords ? count - done : blockRecords;
+		success = fread(block, words * sizeof(uint32_t), want, input) == want; // truncated otherwise
+
+		for (size_t i = 0; i < want && success; i++)
+		{
+			const uint8_t *record = block + i * words * sizeof(uint32_t);
+			ProcessControlBlock_t pcb = {le32(record), le32(record + 4), le32(record + 8), with_deadlines ? le32(record + 12) : 0, false};
+			writer_put(&writer, &pcb);
+		}
+		done += want;
+	}
+
+	uint8_t extraData[sizeof(uint32_t)];
+	success = success && fread(extraData, sizeof(extraData), 1, input) != 1; // the stream holds more data than it should
+
+	if (block != NULL)
+	{
+		success = writer_end(&writer) && success;
+	}
+	free(block);
+	return success;
+}
+
+struct pcb_trace_reader
+{
+	FILE *input;
+	uint8_t *buffer;
+	size_t position;	// next byte to decode
+	size_t length;		// bytes in the buffer
+	bool input_done;	// the stream hit its end
+	uint64_t count;
+	uint64_t decoded;
+	uint32_t flags;
+	uint32_t arrival;	// of the last record decoded
+};
+
+// Moves the undecoded bytes to the front and reads more behind them, until the buffer is full or the stream ends
+static void reader_refill(pcb_trace_reader_t *reader)
+{
+	size_t left = reader->length - reader->position;
+	memmove(reader->buffer, reader->buffer + reader->position, left);
+	reader->position = 0;
+	reader->length = left;
+
+	while (reader->length < PCB_TRACE_BUFFER_SIZE && reader->input_done == false)
+	{
+		size_t got = fread(reader->buffer + reader->length, 1, PCB_TRACE_BUFFER_SIZE - reader->length, reader->input);
+		reader->length += got;
+		reader->input_done = got == 0;
+	}
+}
+
+pcb_trace_reader_t *pcb_trace_open(FILE *const input)
+{
+	uint8_t header[PCB_TRACE_HEADER_SIZE];
+
+	if (input == NULL || fread(header, sizeof(header), 1, input) != 1 || memcmp(header, PCB_TRACE_MAGIC, PCB_TRACE_MAGIC_SIZE) != 0 ||
+		(le32(header + 8) & ~PCB_TRACE_HAS_DEADLINES) != 0 || le32(header + 12) != 0)
+	{
+		return NULL;
+	}
+
+	pcb_trace_reader_t *reader = (pcb_trace_reader_t *)calloc(1, sizeof(pcb_trace_reader_t));
+	if (reader == NULL || (reader->buffer = (uint8_t *)malloc(PCB_TRACE_BUFFER_SIZE)) == NULL)
+	{
+		free(reader);
+		return NULL;
+	}
+
+	reader->input = input;
+	reader->flags = le32(header + 8);
+	reader->count = le64(header + 16);
+	return reader;
+}
+
+uint64_t pcb_trace_size(const pcb_trace_reader_t *const reader)
+{
+	return reader ? reader->count : 0;
+}
+
+uint32_t pcb_trace_flags(const pcb_trace_reader_t *const reader)
+{
+	return reader ? reader->flags : 0;
+}
+
+bool pcb_trace_read(pcb_trace_reader_t *const reader, ProcessControlBlock_t *const pcbs, const size_t max, size_t *const decoded)
+{
+	if (reader == NULL || pcbs == NULL || decoded == NULL)
+	{
+		return false;
+	}
+
+	size_t records = 0;
+	while (records < max && reader->decoded < reader->count)
+	{
+		if (reader->length - reader->position < PCB_TRACE_RECORD_MAX && reader->input_done == false)
+		{
+			reader_refill(reader);
+		}
+
+		const uint8_t *bytes = reader->buffer + reader->position;
+		const uint8_t *end = reader->buffer + reader->length;
+		uint64_t delta, burst, priority, deadline = 0;
+
+		if ((bytes = get_varint(bytes, end, &delta)) == NULL || (bytes = get_varint(bytes, end, &burst)) == NULL ||
+			(bytes = get_varint(bytes, end, &priority)) == NULL ||
+			((reader->flags & PCB_TRACE_HAS_DEADLINES) && (bytes = get_varint(bytes, end, &deadline)) == NULL)) // cut off
+		{
+			return false;
+		}
+
+		int64_t arrival = (int64_t)reader->arrival + unzigzag(delta);
+		int64_t due = (reader->flags & PCB_TRACE_HAS_DEADLINES) ? arrival + unzigzag(deadline) : 0;
+		if (arrival < 0 || arrival > UINT32_MAX || burst > UINT32_MAX || priority > UINT32_MAX || due < 0 || due > UINT32_MAX) // not a uint32_t
+		{
+			return false;
+		}
+
+		ProcessControlBlock_t *pcb = &pcbs[records++];
+		pcb->remaining_burst_time = (uint32_t)burst;
+		pcb->priority = (uint32_t)priority;
+		pcb->arrival = (uint32_t)arrival;
+		pcb->deadline = (uint32_t)due;
+		pcb->started = false;
+		reader->arrival = pcb->arrival;
+		reader->position = (size_t)(bytes - reader->buffer);
+		reader->decoded++;
+	}
+
+	if (reader->decoded == reader->count && records == 0) // at the end, which must be the end of the stream too
+	{
+		if (reader->position == reader->length)
+		{
+			reader_refill(reader);
+		}
+		if (reader->length > reader->position) // the stream holds more data than it should
+		{
+			return false;
+		}
+	}
+
+	*decoded = records;
+	return true;
+}
+
+void pcb_trace_close(pcb_trace_reader_t *const reader)
+{
+	if (reader)
+	{
+		free(reader->buffer);
+		free(reader);
+	}
+}
+
+dyn_array_t *pcb_trace_load(FILE *const input)
+{
+	pcb_trace_reader_t *reader = pcb_trace_open(input);
+	if (reader == NULL)
+	{
+		return NULL;
+	}
+
+	// grown chunk by chunk rather than sized from the header, so a corrupt count can't allocate gigabytes up front
+	dyn_array_t *pcbArray = dyn_array_create(PCB_TRACE_CHUNK, sizeof(ProcessControlBlock_t), NULL);
+	ProcessControlBlock_t *chunk = (ProcessControlBlock_t *)malloc(PCB_TRACE_CHUNK * sizeof(ProcessControlBlock_t));
+	bool success = pcbArray != NULL && chunk != NULL;
+
+	for (size_t decoded = 1; success && decoded > 0;)
+	{
+		success = pcb_trace_read(reader, chunk, PCB_TRACE_CHUNK, &decoded);
+		if (success && decoded > 0)
+		{
+			void *pcbs = dyn_array_append(pcbArray, decoded);
+			success = pcbs != NULL;
+			if (success)
+			{
+				memcpy(pcbs, chunk, decoded * sizeof(ProcessControlBlock_t));
+			}
+		}
+	}
+
+	free(chunk);
+	pcb_trace_close(reader);
+	if (success == false)
+	{
+		dyn_array_destroy(pcbArray);
+		return NULL;
+	}
+	return pcbArray;
+}
+
+bool pcb_trace_replay(FILE *const input, const ScheduleAlgorithm_t algorithm, const size_t quantum, ScheduleResult_t *const result)
+{
+	if (input == NULL || result == NULL)
+	{
+		return false;
+	}
+
+	pcb_trace_reader_t *reader = pcb_trace_open(input);
+	schedule_session_t *session = schedule_session_create(algorithm, quantum);
+	ProcessControlBlock_t *chunk = (ProcessControlBlock_t *)malloc(PCB_TRACE_CHUNK * sizeof(ProcessControlBlock_t));
+	bool success = reader != NULL && session != NULL && chunk != NULL;
+
+	for (size_t decoded = 1; success && decoded > 0;)
+	{
+		success = pcb_trace_read(reader, chunk, PCB_TRACE_CHUNK, &decoded);
+		for (size_t i = 0; i < decoded && success; i++)
+		{
+			success = schedule_session_submit(session, &chunk[i]); // fails if the arrivals go backwards
+		}
+
+		// everything before the last arrival can run now, so the session only holds the pcbs still live then
+		success = success && (decoded == 0 || schedule_session_advance(session, chunk[decoded - 1].arrival));
+	}
+
+	success = success && schedule_session_advance(session, UINT64_MAX) && schedule_session_snapshot(session, result);
+
+	free(chunk);
+	schedule_session_destroy(session);
+	pcb_trace_close(reader);
+	return success;
+}
@@ -4,716 +4,2064 @@
 #include <unistd.h>
 
 #include "dyn_array.h"
+#include "job_pool.h"
+#include "pcb_file.h"
 #include "processing_scheduling.h"
+#include "ready_heap.h"
+#include "rb_tree.h"
+#include "schedule_policy.h"
+#include "schedule_totals.h"
+#include "thread_pool.h"
+
+// Builds the arrival order of the pcbs: order[rank] is the index of the rank-th arrival.
+// It's an LSD radix sort, so equal arrivals stay in file order and the result doesn't depend on
+// how qsort happens to treat ties. The rank therefore doubles as an (arrival, file index) tie-breaker.
+// \return malloc'd array of numPCBs indices, NULL if the allocation fails
+static size_t *arrival_order(const ProcessControlBlock_t *pcbs, size_t numPCBs)
+{
+	size_t *order = (size_t *)malloc(numPCBs * sizeof(size_t));
+	size_t *scratch = (size_t *)malloc(numPCBs * sizeof(size_t));
+
+	if (order == NULL || scratch == NULL)
+	{
+		free(order);
+		free(scratch);
+		return NULL;
+	}
+
+	bool sorted = true;
+	for (size_t i = 0; i < numPCBs; i++)
+	{
+		order[i] = i;
+		sorted = sorted && (i == 0 || pcbs[i - 1].arrival <= pcbs[i].arrival);
+	}
+
+	for (unsigned shift = 0; shift < 32 && sorted == false; shift += 8) // one counting pass per byte of the arrival time, none when already in order
+	{
+		size_t count[257] = {0};
+
+		for (size_t i = 0; i < numPCBs; i++)
+		{
+			count[((pcbs[order[i]].arrival >> shift) & 0xFF) + 1]++;
+		}
+
+		if (count[((pcbs[order[0]].arrival >> shift) & 0xFF) + 1] == numPCBs) // every pcb shares this byte, nothing moves
+		{
+			continue;
+		}
+
+		for (size_t b = 1; b < 257; b++)
+		{
+			count[b] += count[b - 1];
+		}
+
+		for (size_t i = 0; i < numPCBs; i++)
+		{
+			scratch[count[(pcbs[order[i]].arrival >> shift) & 0xFF]++] = order[i];
+		}
+
+		size_t *swap = order;
+		order = scratch;
+		scratch = swap;
+	}
+
+	free(scratch);
+	return order;
+}
+
+// The pcb field a heap policy orders its ready set by. Ties always fall back to the
+// arrival rank, i.e. arrival time and then file index, so the schedule is fully deterministic.
+typedef enum
+{
+	READY_KEY_ARRIVAL,	// FCFS, the rank alone is the order
+	READY_KEY_BURST,	// SJF
+	READY_KEY_PRIORITY,	// Priority, lowest value first
+	READY_KEY_DEADLINE,	// EDF, pcbs without a deadline after all the others
+	READY_KEY_REMAINING	// SRT, the burst still to run
+}
+ReadyKey_t;
+
+static inline uint64_t ready_key(const ProcessControlBlock_t *pcb, uint32_t remaining, ReadyKey_t key)
+{
+	switch (key)
+	{
+		case READY_KEY_BURST:
+			return pcb->remaining_burst_time;
+		case READY_KEY_PRIORITY:
+			return pcb->priority;
+		case READY_KEY_DEADLINE:
+			return pcb->deadline ? pcb->deadline : UINT64_MAX;
+		case READY_KEY_REMAINING:
+			return remaining;
+		default:
+			return 0;
+	}
+}
+
+// The field a ScheduleAlgorithm_t orders its ready set by. Round robin has none, its ready set is first in first out.
+static ReadyKey_t algorithm_key(ScheduleAlgorithm_t algorithm)
+{
+	switch (algorithm)
+	{
+		case SCHEDULE_SJF:
+			return READY_KEY_BURST;
+		case SCHEDULE_PRIORITY:
+			return READY_KEY_PRIORITY;
+		case SCHEDULE_SRT:
+			return READY_KEY_REMAINING;
+		case SCHEDULE_EDF:
+		case SCHEDULE_EDF_PREEMPTIVE:
+			return READY_KEY_DEADLINE;
+		default:
+			return READY_KEY_ARRIVAL;
+	}
+}
+
+// Whether a ScheduleAlgorithm_t lets an arrival that orders first take the cpu
+static bool algorithm_preemptive(ScheduleAlgorithm_t algorithm)
+{
+	return algorithm == SCHEDULE_SRT || algorithm == SCHEDULE_EDF_PREEMPTIVE;
+}
+
+// Every built in single cpu scheduler is a policy over the policy core (see schedule_policy.h): the core runs the
+// clock, the arrival cursor and the accounting, and the policies below only keep their ready sets. Their ops tables
+// are constant, so once schedule_policy_run is inlined into a run_* function the compiler can call the hooks directly.
+
+// A ready heap ordered by one pcb field. Without preempt this is FCFS, SJF, Priority or EDF: a dispatched pcb runs to
+// completion and the clock jumps straight to it, or to the next arrival. With it, it's SRT or preemptive EDF: an
+// arrival that orders strictly before the running pcb, by (key, rank), takes the cpu. The running pcb's key only goes
+// down while it runs (remaining time) or stays put (deadline), so arrivals are the only time that can happen.
+typedef struct
+{
+	ReadyHeap_t ready;
+	ReadyKey_t key;
+	uint64_t running_key;	// the running pcb's key as of dispatch
+}
+HeapPolicy_t;
+
+static bool heap_on_arrival(void *state, const ProcessControlBlock_t *pcb, size_t id, uint32_t remaining, uint64_t now, size_t from)
+{
+	(void)now;
+	(void)from;
+	HeapPolicy_t *policy = (HeapPolicy_t *)state;
+	return ready_heap_push(&policy->ready, ready_key(pcb, remaining, policy->key), id);
+}
+
+static bool heap_select(void *state, size_t cpu, uint64_t now, size_t *id, uint64_t *slice)
+{
+	(void)cpu;
+	(void)now;
+	(void)slice; // runs until it finishes or is preempted
+	HeapPolicy_t *policy = (HeapPolicy_t *)state;
+	ReadyEntry_t next = ready_heap_pop(&policy->ready);
+	policy->running_key = next.key;
+	*id = next.rank;
+	return true;
+}
+
+static bool heap_preempt(void *state, size_t cpu, size_t running, uint32_t remaining, uint64_t now, uint64_t *slice)
+{
+	(void)cpu;
+	(void)now;
+	(void)slice;
+	HeapPolicy_t *policy = (HeapPolicy_t *)state;
+	ReadyEntry_t current = {policy->key == READY_KEY_REMAINING ? remaining : policy->running_key, running};
+	return !ready_heap_empty(&policy->ready) && ready_entry_before(ready_heap_top(&policy->ready), current);
+}
+
+static const SchedulePolicyOps_t heap_ops = {heap_on_arrival, heap_select, NULL, NULL};
+static const SchedulePolicyOps_t preemptive_heap_ops = {heap_on_arrival, heap_select, heap_preempt, NULL};
+
+// Sets up a heap policy with an empty ready set
+// \param policy the policy to set up
+// \param key what the ready heap is ordered by
+// \param capacity pcbs the heap has room for before it grows, 0 for a default
+// \return true if function ran successful else false for an error
+static bool heap_policy_init(HeapPolicy_t *policy, ReadyKey_t key, size_t capacity)
+{
+	policy->key = key;
+	policy->running_key = 0;
+	return ready_heap_init(&policy->ready, capacity);
+}
+
+// Runs a heap policy. The heap is sized for every pcb, so the loop never allocates.
+// \param pcbs the pcbs to schedule, left untouched
+// \param order the arrival order of the pcbs to run, see arrival_order
+// \param numPCBs number of pcbs in order, at least one
+// \param key the policy, what the ready heap is ordered by
+// \param preemptive whether an arrival that orders before the running pcb preempts it
+// \param totals receives the statistics
+// \return true if function ran successful else false for an error
+static bool run_heap_policy(const ProcessControlBlock_t *pcbs, const size_t *order, size_t numPCBs, ReadyKey_t key, bool preemptive, ScheduleTotals_t *totals)
+{
+	HeapPolicy_t policy;
+
+	if (heap_policy_init(&policy, key, numPCBs) == false)
+	{
+		return false;
+	}
+
+	bool success = preemptive ? schedule_policy_run(pcbs, order, numPCBs, 1, &preemptive_heap_ops, &policy, totals) :
+		schedule_policy_run(pcbs, order, numPCBs, 1, &heap_ops, &policy, totals);
+	ready_heap_destroy(&policy.ready);
+	return success;
+}
+
+// Round Robin over a ring buffer of ids. A batch run sizes the ring for every pcb, so it is allocated once up
+// front; otherwise it doubles when full. A pcb whose quantum runs out is handed back by the core after the
+// arrivals of that instant, so arrivals during or at the end of a slice go ahead of the preempted pcb.
+typedef struct
+{
+	size_t *ring;
+	size_t capacity;
+	size_t head;		// next pcb to dispatch
+	size_t tail;		// next free slot
+	size_t count;
+	size_t quantum;
+}
+RoundRobinPolicy_t;
+
+// Sets up a round robin policy with an empty ring
+// \param policy the policy to set up
+// \param quantum the time slice, at least one
+// \param capacity pcbs the ring has room for before it grows, 0 for a default
+// \return true if function ran successful else false for an error
+static bool round_robin_init(RoundRobinPolicy_t *policy, size_t quantum, size_t capacity)
+{
+	policy->capacity = capacity ? capacity : 16;
+	policy->ring = (size_t *)malloc(policy->capacity * sizeof(size_t));
+	policy->head = 0;
+	policy->tail = 0;
+	policy->count = 0;
+	policy->quantum = quantum;
+	return policy->ring != NULL;
+}
+
+// Doubles the ring, unwrapping it
+static bool round_robin_grow(RoundRobinPolicy_t *policy)
+{
+	size_t *ring = (size_t *)malloc(2 * policy->capacity * sizeof(size_t));
+	if (ring == NULL)
+	{
+		return false;
+	}
+
+	for (size_t i = 0; i < policy->count; i++)
+	{
+		ring[i] = policy->ring[(policy->head + i) % policy->capacity];
+	}
+	free(policy->ring);
+	policy->ring = ring;
+	policy->head = 0;
+	policy->tail = policy->count;
+	policy->capacity *= 2;
+	return true;
+}
+
+static bool round_robin_on_arrival(void *state, const ProcessControlBlock_t *pcb, size_t id, uint32_t remaining, uint64_t now, size_t from)
+{
+	(void)pcb;
+	(void)remaining;
+	(void)now;
+	(void)from;
+	RoundRobinPolicy_t *policy = (RoundRobinPolicy_t *)state;
+
+	if (policy->count == policy->capacity && round_robin_grow(policy) == false)
+	{
+		return false;
+	}
+
+	policy->ring[policy->tail] = id;
+	policy->tail = policy->tail + 1 == policy->capacity ? 0 : policy->tail + 1;
+	policy->count++;
+	return true;
+}
+
+static bool round_robin_select(void *state, size_t cpu, uint64_t now, size_t *id, uint64_t *slice)
+{
+	(void)cpu;
+	(void)now;
+	RoundRobinPolicy_t *policy = (RoundRobinPolicy_t *)state;
+	*id = policy->ring[policy->head];
+	*slice = policy->quantum;
+	policy->head = policy->head + 1 == policy->capacity ? 0 : policy->head + 1;
+	policy->count--;
+	return true;
+}
+
+static const SchedulePolicyOps_t round_robin_ops = {round_robin_on_arrival, round_robin_select, NULL, NULL};
+
+// Runs Round Robin
+// \param pcbs the pcbs to schedule, left untouched
+// \param order the arrival order of the pcbs to run, see arrival_order
+// \param numPCBs number of pcbs in order, at least one
+// \param quantum the time slice, at least one
+// \param totals receives the statistics
+// \return true if function ran successful else false for an error
+static bool run_round_robin(const ProcessControlBlock_t *pcbs, const size_t *order, size_t numPCBs, size_t quantum, ScheduleTotals_t *totals)
+{
+	RoundRobinPolicy_t policy;
+
+	if (round_robin_init(&policy, quantum, numPCBs) == false)
+	{
+		return false;
+	}
+
+	bool success = schedule_policy_run(pcbs, order, numPCBs, 1, &round_robin_ops, &policy, totals);
+	free(policy.ring);
+	return success;
+}
+
+// Runs algorithm over the pcbs listed in order, the shared entry point of every single-CPU engine
+// \param pcbs the pcbs, left untouched
+// \param order the arrival order of the pcbs to run, see arrival_order
+// \param numPCBs number of pcbs in order, at least one
+// \param algorithm which policy to run
+// \param quantum the time slice, only used by round robin
+// \param totals receives the statistics
+// \return true if function ran successful else false for an error
+static bool run_algorithm(const ProcessControlBlock_t *pcbs, const size_t *order, size_t numPCBs, ScheduleAlgorithm_t algorithm, size_t quantum, ScheduleTotals_t *totals)
+{
+	if (algorithm > SCHEDULE_EDF_PREEMPTIVE)
+	{
+		return false;
+	}
+	if (algorithm == SCHEDULE_RR)
+	{
+		return quantum > 0 && run_round_robin(pcbs, order, numPCBs, quantum, totals);
+	}
+	return run_heap_policy(pcbs, order, numPCBs, algorithm_key(algorithm), algorithm_preemptive(algorithm), totals);
+}
+
+// Fills in what a schedule_policy_* constructor built
+// \param policy receives the policy
+// \param ops the policy's hooks
+// \param state the malloc'd state, handed to every hook
+// \param destroy frees state
+// \param cpus how many cpus the policy schedules
+// \return true, for the constructors to return
+static bool policy_built(SchedulePolicy_t *policy, const SchedulePolicyOps_t *ops, void *state, void (*destroy)(void *state), size_t cpus)
+{
+	policy->ops = ops;
+	policy->state = state;
+	policy->destroy = destroy;
+	policy->cpus = cpus;
+	return true;
+}
+
+// Frees a heap policy made by schedule_policy_algorithm
+static void heap_policy_free(void *state)
+{
+	HeapPolicy_t *policy = (HeapPolicy_t *)state;
+	ready_heap_destroy(&policy->ready);
+	free(policy);
+}
+
+// Frees a round robin policy made by schedule_policy_algorithm
+static void round_robin_free(void *state)
+{
+	RoundRobinPolicy_t *policy = (RoundRobinPolicy_t *)state;
+	free(policy->ring);
+	free(policy);
+}
+
+// Builds the policy a ScheduleAlgorithm_t runs, for running it incrementally (see schedule_session.h)
+// \param policy receives the ops table, the state and how to free it \ref SchedulePolicy_t
+// \param algorithm which policy to build
+// \param quantum the time slice, only used by round robin (where it must not be 0)
+// \return true if function ran successful else false for an error
+bool schedule_policy_algorithm(SchedulePolicy_t *policy, ScheduleAlgorithm_t algorithm, size_t quantum)
+{
+	if (policy == NULL || algorithm > SCHEDULE_EDF_PREEMPTIVE || (algorithm == SCHEDULE_RR && quantum == 0))
+	{
+		return false;
+	}
+
+	if (algorithm == SCHEDULE_RR)
+	{
+		RoundRobinPolicy_t *state = (RoundRobinPolicy_t *)malloc(sizeof(RoundRobinPolicy_t));
+		if (state == NULL || round_robin_init(state, quantum, 0) == false)
+		{
+			free(state);
+			return false;
+		}
+
+		return policy_built(policy, &round_robin_ops, state, round_robin_free, 1);
+	}
+
+	HeapPolicy_t *state = (HeapPolicy_t *)malloc(sizeof(HeapPolicy_t));
+	if (state == NULL || heap_policy_init(state, algorithm_key(algorithm), 0) == false)
+	{
+		free(state);
+		return false;
+	}
+
+	return policy_built(policy, algorithm_preemptive(algorithm) ? &preemptive_heap_ops : &heap_ops, state, heap_policy_free, 1);
+}
+
+// Frees what a schedule_policy_* constructor built
+// \param policy the policy, may be NULL
+void schedule_policy_destroy(SchedulePolicy_t *policy)
+{
+	if (policy != NULL && policy->destroy != NULL)
+	{
+		policy->destroy(policy->state);
+		policy->destroy = NULL;
+		policy->state = NULL;
+	}
+}
+
+// An engine for policies that take more than a quantum, run over the arrival order like run_algorithm
+typedef bool (*ScheduleEngine_t)(const ProcessControlBlock_t *pcbs, const size_t *order, size_t numPCBs, const void *params, ScheduleTotals_t *totals);
+
+// Runs engine over ready_queue without touching it, the pcbs are only read through an arrival order index
+static bool run_engine(const dyn_array_t *ready_queue, ScheduleResult_t *result, ScheduleEngine_t engine, const void *params, const ScheduleColumns_t *columns)
+{
+	if (ready_queue == NULL || result == NULL || dyn_array_size(ready_queue) == 0) // check for invalid parameters or no processes to be scheduled
+	{
+		return false;
+	}
+
+	const ProcessControlBlock_t *pcbs = (const ProcessControlBlock_t *)dyn_array_export(ready_queue);
+	size_t numPCBs = dyn_array_size(ready_queue);
+	size_t *order = arrival_order(pcbs, numPCBs);
+	ScheduleTotals_t totals = {0};
+
+	if (order == NULL)
+	{
+		return false;
+	}
+
+	totals_columns_begin(&totals, columns, pcbs, numPCBs);
+	bool success = engine(pcbs, order, numPCBs, params, &totals);
+	free(order);
+
+	if (success == false)
+	{
+		return false;
+	}
+
+	totals_to_result(&totals, result);
+	return true;
+}
+
+// Runs engine over ready_queue and drains it, like the per-tick versions did
+static bool run_and_drain(dyn_array_t *ready_queue, ScheduleResult_t *result, ScheduleEngine_t engine, const void *params, const ScheduleColumns_t *columns)
+{
+	if (run_engine(ready_queue, result, engine, params, columns) == false)
+	{
+		return false;
+	}
+
+	dyn_array_clear(ready_queue);
+	return true;
+}
+
+// What schedule_and_drain hands run_and_drain
+typedef struct
+{
+	ScheduleAlgorithm_t algorithm;
+	size_t quantum;
+}
+AlgorithmParams_t;
+
+static bool run_algorithm_engine(const ProcessControlBlock_t *pcbs, const size_t *order, size_t numPCBs, const void *params, ScheduleTotals_t *totals)
+{
+	const AlgorithmParams_t *algorithm = (const AlgorithmParams_t *)params;
+	return run_algorithm(pcbs, order, numPCBs, algorithm->algorithm, algorithm->quantum, totals);
+}
+
+// Runs algorithm over ready_queue and drains it, like the per-tick versions did
+static bool schedule_and_drain(dyn_array_t *ready_queue, ScheduleResult_t *result, ScheduleAlgorithm_t algorithm, size_t quantum)
+{
+	AlgorithmParams_t params = {algorithm, quantum};
+	return run_and_drain(ready_queue, result, run_algorithm_engine, &params, NULL);
+}
+
+// Runs algorithm over the incoming ready_queue and leaves it as it was
+// The pcbs are only read, so one loaded ready_queue can be scheduled again and again, or from several threads at once.
+// \param ready queue a dyn_array of type ProcessControlBlock_t that contain be up to N elements
+// \param result used for stat tracking \ref ScheduleResult_t
+// \param algorithm which policy to run
+// \param quantum the time slice, only used by round robin (where it must not be 0)
+// \param columns receives per-pcb results in the arrays it points to \ref ScheduleColumns_t, NULL for none
+// \return true if function ran successful else false for an error
+bool schedule_algorithm(const dyn_array_t *ready_queue, ScheduleResult_t *result, ScheduleAlgorithm_t algorithm, size_t quantum,
+	const ScheduleColumns_t *columns)
+{
+	AlgorithmParams_t params = {algorithm, quantum};
+	return run_engine(ready_queue, result, run_algorithm_engine, &params, columns);
+}
+
+// Runs the First Come First Served Process Scheduling algorithm over the incoming ready_queue
+// \param ready queue a dyn_array of type ProcessControlBlock_t that contain be up to N elements
+// \param result used for first come first served stat tracking \ref ScheduleResult_t
+// \return true if function ran successful else false for an error
+bool first_come_first_serve(dyn_array_t *ready_queue, ScheduleResult_t *result) 
+{
+	return schedule_and_drain(ready_queue, result, SCHEDULE_FCFS, 0);
+}
+
+
+// Runs the Shortest Job First Scheduling algorithm over the incoming ready_queue
+// \param ready queue a dyn_array of type ProcessControlBlock_t that contain be up to N elements
+// \param result used for shortest job first stat tracking \ref ScheduleResult_t
+// \return true if function ran successful else false for an error
+bool shortest_job_first(dyn_array_t *ready_queue, ScheduleResult_t *result) 
+{
+	return schedule_and_drain(ready_queue, result, SCHEDULE_SJF, 0);
+}
+
+
+
+// Runs the Priority algorithm over the incoming ready_queue
+// Ties in priority go to the earliest arrival, then to the pcb that comes first in the file
+// \param ready queue a dyn_array of type ProcessControlBlock_t that contain be up to N elements
+// \param result used for shortest job first stat tracking \ref ScheduleResult_t
+// \return true if function ran successful else false for an error
+bool priority(dyn_array_t *ready_queue, ScheduleResult_t *result) 
+{
+	return schedule_and_drain(ready_queue, result, SCHEDULE_PRIORITY, 0);
+}
+
+// Preemptive Priority with optional aging. A waiting pcb's effective priority is
+// priority - (now - queued) / aging_interval, which orders waiting pcbs the same way at every instant as the
+// fixed key priority * aging_interval + queued does, so the ready heap never has to be touched as time passes.
+// The running pcb doesn't age: its effective priority is frozen at dispatch, which makes its key grow by the
+// time it has run. It is preempted once the best waiting pcb is a whole priority level ahead; besides arrivals
+// and completions that is the only event, and its time is known from the two keys, so it is the running pcb's
+// slice. Without aging the keys are the plain priorities and only a strictly higher priority arrival preempts.
+typedef struct
+{
+	ReadyHeap_t ready;
+	uint64_t aging;			// 0 for no aging
+	uint64_t running_key;	// the running pcb's key as of dispatch, or as of preemption once it is handed back
+	uint64_t dispatched;
+	uint64_t maxPriority;	// of the pcbs so far
+	uint64_t work;			// their bursts summed
+}
+PriorityPolicy_t;
+
+// Sets up preemptive Priority with an empty ready set
+// \param policy the policy to set up
+// \param aging the aging interval, 0 for no aging
+// \param capacity pcbs the heap has room for before it grows, 0 for a default
+// \return true if function ran successful else false for an error
+static bool priority_init(PriorityPolicy_t *policy, uint64_t aging, size_t capacity)
+{
+	policy->aging = aging;
+	policy->running_key = 0;
+	policy->dispatched = 0;
+	policy->maxPriority = 0;
+	policy->work = 0;
+	return ready_heap_init(&policy->ready, capacity);
+}
+
+// Whether the aging keys stay clear of 64-bit overflow until the next arrival. A key is priority * aging plus a time,
+// the time a waiting pcb gets ahead adds aging and another time on top, and until another pcb arrives no time passes
+// this arrival plus every burst so far. Checked at every arrival, so it holds for streamed pcbs as well.
+// \return true if no key or event time can wrap before the next arrival
+static bool priority_fits(const PriorityPolicy_t *policy, uint64_t now)
+{
+	uint64_t horizon = now + policy->work;
+	return policy->aging == 0 || (horizon <= UINT64_MAX / 4 && (policy->maxPriority + 1) * policy->aging <= UINT64_MAX - 2 * horizon); // (UINT32_MAX + 1) * UINT32_MAX itself can't wrap
+}
+
+// How long the pcb dispatched with key can run before the best waiting pcb has aged past it
+static uint64_t priority_slice(const PriorityPolicy_t *policy, uint64_t key)
+{
+	return policy->aging && !ready_heap_empty(&policy->ready) ? ready_heap_top(&policy->ready).key + policy->aging - key : UINT64_MAX;
+}
+
+static bool priority_on_arrival(void *state, const ProcessControlBlock_t *pcb, size_t id, uint32_t remaining, uint64_t now, size_t from)
+{
+	(void)remaining;
+	PriorityPolicy_t *policy = (PriorityPolicy_t *)state;
+	if (from == SCHEDULE_POLICY_ARRIVED)
+	{
+		policy->maxPriority = pcb->priority > policy->maxPriority ? pcb->priority : policy->maxPriority;
+		policy->work += pcb->remaining_burst_time;
+		if (priority_fits(policy, now) == false) // an interval this long could wrap the keys from here on
+		{
+			return false;
+		}
+	}
+
+	uint64_t key = policy->aging ? pcb->priority * policy->aging + now : pcb->priority;
+	return ready_heap_push(&policy->ready, from == SCHEDULE_POLICY_ARRIVED ? key : policy->running_key, id); // preempted, it waits with the priority it ran at
+}
+
+static bool priority_select(void *state, size_t cpu, uint64_t now, size_t *id, uint64_t *slice)
+{
+	(void)cpu;
+	PriorityPolicy_t *policy = (PriorityPolicy_t *)state;
+	ReadyEntry_t next = ready_heap_pop(&policy->ready);
+	policy->running_key = next.key;
+	policy->dispatched = now;
+	*id = next.rank;
+	*slice = priority_slice(policy, next.key);
+	return true;
+}
+
+static bool priority_preempt(void *state, size_t cpu, size_t running, uint32_t remaining, uint64_t now, uint64_t *slice)
+{
+	(void)cpu;
+	(void)running;
+	(void)remaining;
+	PriorityPolicy_t *policy = (PriorityPolicy_t *)state;
+
+	if (ready_heap_empty(&policy->ready))
+	{
+		return false;
+	}
+
+	uint64_t key = policy->running_key + (policy->aging ? now - policy->dispatched : 0);
+	uint64_t best = ready_heap_top(&policy->ready).key;
+	if (policy->aging ? best + policy->aging <= key : best < key)
+	{
+		policy->running_key = key;
+		return true;
+	}
+
+	*slice = policy->aging ? best + policy->aging - key : UINT64_MAX;
+	return false;
+}
+
+static const SchedulePolicyOps_t priority_ops = {priority_on_arrival, priority_select, priority_preempt, NULL};
+
+// Runs preemptive Priority, with optional aging
+// \param pcbs the pcbs to schedule, left untouched
+// \param order the arrival order of the pcbs to run, see arrival_order
+// \param numPCBs number of pcbs in order, at least one
+// \param params the aging interval, a uint32_t, 0 for no aging
+// \param totals receives the statistics
+// \return true if function ran successful else false for an error (including an aging interval that could overflow the keys)
+static bool run_priority_preemptive(const ProcessControlBlock_t *pcbs, const size_t *order, size_t numPCBs, const void *params, ScheduleTotals_t *totals)
+{
+	PriorityPolicy_t policy;
+
+	if (priority_init(&policy, *(const uint32_t *)params, numPCBs) == false)
+	{
+		return false;
+	}
+
+	bool success = schedule_policy_run(pcbs, order, numPCBs, 1, &priority_ops, &policy, totals);
+	ready_heap_destroy(&policy.ready);
+	return success;
+}
+
+// Runs the preemptive Priority algorithm, with optional aging, over the incoming ready_queue
+// \param ready queue a dyn_array of type ProcessControlBlock_t that contain be up to N elements
+// \param result used for priority stat tracking \ref ScheduleResult_t
+// \param aging_interval a waiting pcb gains one priority level per aging_interval time units, 0 for no aging
+// \param columns receives per-pcb results in the arrays it points to \ref ScheduleColumns_t, NULL for none
+// \return true if function ran successful else false for an error
+bool priority_preemptive(dyn_array_t *ready_queue, ScheduleResult_t *result, uint32_t aging_interval, const ScheduleColumns_t *columns)
+{
+	return run_and_drain(ready_queue, result, run_priority_preemptive, &aging_interval, columns);
+}
+
+// Frees a policy made by schedule_policy_priority_preemptive
+static void priority_free(void *state)
+{
+	PriorityPolicy_t *policy = (PriorityPolicy_t *)state;
+	ready_heap_destroy(&policy->ready);
+	free(policy);
+}
+
+// Builds preemptive Priority, with optional aging, for running it incrementally (see schedule_session.h)
+// \param policy receives the ops table, the state and how to free it \ref SchedulePolicy_t
+// \param aging_interval a waiting pcb gains one priority level per aging_interval time units, 0 for no aging
+// \return true if function ran successful else false for an error
+bool schedule_policy_priority_preemptive(SchedulePolicy_t *policy, uint32_t aging_interval)
+{
+	PriorityPolicy_t *state = (PriorityPolicy_t *)malloc(sizeof(PriorityPolicy_t));
+
+	if (policy == NULL || state == NULL || priority_init(state, aging_interval, 0) == false)
+	{
+		free(state);
+		return false;
+	}
+
+	return policy_built(policy, &priority_ops, state, priority_free, 1);
+}
+
+// Runs the Earliest Deadline First algorithm over the incoming ready_queue
+// \param ready queue a dyn_array of type ProcessControlBlock_t that contain be up to N elements
+// \param result used for earliest deadline first stat tracking \ref ScheduleResult_t
+// \param preemptive whether an arrival with an earlier deadline takes the CPU from the running pcb
+// \return true if function ran successful else false for an error
+bool earliest_deadline_first(dyn_array_t *ready_queue, ScheduleResult_t *result, bool preemptive)
+{
+	return schedule_and_drain(ready_queue, result, preemptive ? SCHEDULE_EDF_PREEMPTIVE : SCHEDULE_EDF, 0);
+}
+
+
+// One arrival-ordered chunk of the parallel FCFS scan
+typedef struct
+{
+	size_t begin;			// first rank in the chunk
+	size_t end;				// one past the last rank
+	uint64_t work;			// sum of the chunk's bursts
+	uint64_t latest;		// completion of the chunk's last pcb if the CPU were free when the chunk starts
+	uint64_t carry_in;		// completion time of the previous chunk's last pcb
+	ScheduleTotals_t totals;
+}
+FcfsChunk_t;
+
+typedef struct
+{
+	const ProcessControlBlock_t *pcbs;
+	const size_t *order;
+	FcfsChunk_t *chunks;
+}
+FcfsScan_t;
+
+// Pass 1: summarize a chunk as the max-plus map C_out = max(C_in + work, latest).
+// Folding in pcb i, C -> max(C, arrival_i) + burst_i, turns (work, latest) into (work + burst_i, max(latest, arrival_i) + burst_i).
+static void fcfs_scan_summarize(void *arg, size_t index)
+{
+	const FcfsScan_t *scan = (const FcfsScan_t *)arg;
+	FcfsChunk_t *chunk = &scan->chunks[index];
+	uint64_t work = 0;
+	uint64_t latest = 0;
+
+	for (size_t rank = chunk->begin; rank < chunk->end; rank++)
+	{
+		const ProcessControlBlock_t *pcb = &scan->pcbs[scan->order[rank]];
+		work += pcb->remaining_burst_time;
+		latest = (latest > pcb->arrival ? latest : pcb->arrival) + pcb->remaining_burst_time;
+	}
+
+	chunk->work = work;
+	chunk->latest = latest;
+}
+
+// Pass 2: replay the chunk from its real starting completion time and sum its waiting and turnaround
+static void fcfs_scan_replay(void *arg, size_t index)
+{
+	const FcfsScan_t *scan = (const FcfsScan_t *)arg;
+	FcfsChunk_t *chunk = &scan->chunks[index];
+	uint64_t currentTime = chunk->carry_in;
+
+	for (size_t rank = chunk->begin; rank < chunk->end; rank++)
+	{
+		const ProcessControlBlock_t *pcb = &scan->pcbs[scan->order[rank]];
+		if (currentTime < pcb->arrival)
+		{
+			currentTime = pcb->arrival;
+		}
+		currentTime += pcb->remaining_burst_time;
+		totals_complete(&chunk->totals, pcb, currentTime);
+	}
+}
+
+// Runs the First Come First Served Process Scheduling algorithm over the incoming ready_queue on several threads
+// Completion times follow C_i = max(C_i-1, arrival_i) + burst_i, an associative max-plus scan, so the arrival
+// ordered pcbs are split into one chunk per thread: each chunk is summarized in parallel, the summaries are chained
+// to find every chunk's starting time, and the chunks are replayed in parallel. The sums are exact integers, so
+// the result is identical to first_come_first_serve.
+// \param ready queue a dyn_array of type ProcessControlBlock_t that contain be up to N elements
+// \param result used for first come first served stat tracking \ref ScheduleResult_t
+// \param num_threads how many threads to use, 0 for one per online CPU
+// \return true if function ran successful else false for an error
+bool first_come_first_serve_parallel(dyn_array_t *ready_queue, ScheduleResult_t *result, size_t num_threads)
+{
+	if (ready_queue == NULL || result == NULL || dyn_array_size(ready_queue) == 0) // check for invalid parameters or no processes to be scheduled
+	{
+		return false;
+	}
+
+	const ProcessControlBlock_t *pcbs = (const ProcessControlBlock_t *)dyn_array_export(ready_queue);
+	size_t numPCBs = dyn_array_size(ready_queue);
+	thread_pool_t *pool = thread_pool_create(num_threads);
+	size_t *order = arrival_order(pcbs, numPCBs);
+	size_t numChunks = pool ? thread_pool_size(pool) : 1;
+
+	if (numChunks > numPCBs)
+	{
+		numChunks = numPCBs;
+	}
+
+	FcfsChunk_t *chunks = (FcfsChunk_t *)calloc(numChunks, sizeof(FcfsChunk_t));
+
+	if (pool == NULL || order == NULL || chunks == NULL)
+	{
+		thread_pool_destroy(pool);
+		free(order);
+		free(chunks);
+		return false;
+	}
+
+	for (size_t i = 0; i < numChunks; i++) // even split of the arrival order
+	{
+		chunks[i].begin = numPCBs * i / numChunks;
+		chunks[i].end = numPCBs * (i + 1) / numChunks;
+	}
+
+	FcfsScan_t scan = {.pcbs = pcbs, .order = order, .chunks = chunks};
+	thread_pool_run(pool, numChunks, fcfs_scan_summarize, &scan);
+
+	for (size_t i = 1; i < numChunks; i++) // chain the summaries, this is the only sequential step
+	{
+		uint64_t shifted = chunks[i - 1].carry_in + chunks[i - 1].work;
+		chunks[i].carry_in = shifted > chunks[i - 1].latest ? shifted : chunks[i - 1].latest;
+	}
+
+	thread_pool_run(pool, numChunks, fcfs_scan_replay, &scan);
+
+	ScheduleTotals_t totals = {0};
+	for (size_t i = 0; i < numChunks; i++)
+	{
+		totals_merge(&totals, &chunks[i].totals);
+	}
+
+	thread_pool_destroy(pool);
+	free(order);
+	free(chunks);
+
+	totals_to_result(&totals, result);
+	dyn_array_clear(ready_queue);
+	return true;
+}
+
+
+// Splits the arrival order into busy periods. A new period starts wherever a pcb arrives after all the work
+// that came before it is done; that depends only on arrivals and bursts, so the CPU idles at the same points
+// under every work-conserving policy and each period can be scheduled on its own, as if it were the whole trace.
+// \param starts receives the first rank of every period followed by numPCBs, room for numPCBs + 1 entries
+// \return the number of busy periods
+static size_t busy_periods(const ProcessControlBlock_t *pcbs, const size_t *order, size_t numPCBs, size_t *starts)
+{
+	size_t numPeriods = 0;
+	uint64_t workDone = 0; // when the CPU would finish everything that has arrived so far
+
+	for (size_t rank = 0; rank < numPCBs; rank++)
+	{
+		const ProcessControlBlock_t *pcb = &pcbs[order[rank]];
+		if (rank == 0 || pcb->arrival > workDone) // the CPU went idle before this arrival
+		{
+			starts[numPeriods++] = rank;
+			workDone = pcb->arrival;
+		}
+		workDone += pcb->remaining_burst_time;
+	}
+
+	starts[numPeriods] = numPCBs;
+	return numPeriods;
+}
+
+// Busy periods handed to the thread pool, a batch of consecutive periods per task
+typedef struct
+{
+	const ProcessControlBlock_t *pcbs;
+	const size_t *order;
+	const size_t *periodStarts;	// see busy_periods
+	const size_t *batchStarts;	// first period of each batch, then the period count
+	ScheduleAlgorithm_t algorithm;
+	size_t quantum;
+	ScheduleTotals_t *batchTotals;
+	bool *batchSucceeded;
+}
+BusyPeriodBatches_t;
+
+static void run_busy_period_batch(void *arg, size_t index)
+{
+	const BusyPeriodBatches_t *batches = (const BusyPeriodBatches_t *)arg;
+	bool success = true;
+
+	for (size_t period = batches->batchStarts[index]; period < batches->batchStarts[index + 1] && success; period++)
+	{
+		size_t begin = batches->periodStarts[period];
+		size_t end = batches->periodStarts[period + 1];
+		success = run_algorithm(batches->pcbs, batches->order + begin, end - begin, batches->algorithm, batches->quantum, &batches->batchTotals[index]);
+	}
+
+	batches->batchSucceeded[index] = success;
+}
+
+// Runs a work-conserving algorithm over the incoming ready_queue with its busy periods spread over several threads
+// The trace is cut wherever the CPU would sit idle, the pieces are scheduled independently and their exact sums are
+// merged, so the result is identical to running the algorithm on the whole ready_queue.
+// \param ready queue a dyn_array of type ProcessControlBlock_t that contain be up to N elements
+// \param result used for stat tracking \ref ScheduleResult_t
+// \param algorithm which policy to run
+// \param quantum the time slice, only used by round robin
+// \param num_threads how many threads to use, 0 for one per online CPU
+// \return true if function ran successful else false for an error
+bool schedule_busy_periods_parallel(dyn_array_t *ready_queue, ScheduleResult_t *result, ScheduleAlgorithm_t algorithm, size_t quantum, size_t num_threads)
+{
+	if (ready_queue == NULL || result == NULL || dyn_array_size(ready_queue) == 0) // check for invalid parameters or no processes to be scheduled
+	{
+		return false;
+	}
+
+	const ProcessControlBlock_t *pcbs = (const ProcessControlBlock_t *)dyn_array_export(ready_queue);
+	size_t numPCBs = dyn_array_size(ready_queue);
+	size_t *order = arrival_order(pcbs, numPCBs);
+	size_t *periodStarts = (size_t *)malloc((numPCBs + 1) * sizeof(size_t));
+	thread_pool_t *pool = thread_pool_create(num_threads);
+
+	if (order == NULL || periodStarts == NULL || pool == NULL)
+	{
+		free(order);
+		free(periodStarts);
+		thread_pool_destroy(pool);
+		return false;
+	}
+
+	size_t numPeriods = busy_periods(pcbs, order, numPCBs, periodStarts);
+
+	// Group small periods into batches of roughly numPCBs / (8 * threads) pcbs, enough batches to keep every
+	// thread busy when the periods are uneven without paying task overhead for every tiny period
+	size_t batchTarget = numPCBs / (8 * thread_pool_size(pool)) + 1;
+	size_t *batchStarts = (size_t *)malloc((numPeriods + 1) * sizeof(size_t));
+	size_t numBatches = 0;
+
+	if (batchStarts != NULL)
+	{
+		for (size_t period = 0; period < numPeriods; period++)
+		{
+			if (numBatches == 0 || periodStarts[period] - periodStarts[batchStarts[numBatches - 1]] >= batchTarget)
+			{
+				batchStarts[numBatches++] = period;
+			}
+		}
+		batchStarts[numBatches] = numPeriods;
+	}
+
+	ScheduleTotals_t *batchTotals = (ScheduleTotals_t *)calloc(numBatches, sizeof(ScheduleTotals_t));
+	bool *batchSucceeded = (bool *)calloc(numBatches, sizeof(bool));
+	bool success = batchStarts != NULL && batchTotals != NULL && batchSucceeded != NULL;
+
+	if (success)
+	{
+		BusyPeriodBatches_t batches = {.pcbs = pcbs, .order = order, .periodStarts = periodStarts, .batchStarts = batchStarts,
+			.algorithm = algorithm, .quantum = quantum, .batchTotals = batchTotals, .batchSucceeded = batchSucceeded};
+		thread_pool_run(pool, numBatches, run_busy_period_batch, &batches);
+	}
+
+	ScheduleTotals_t totals = {0};
+	for (size_t i = 0; i < numBatches && success; i++)
+	{
+		success = batchSucceeded[i];
+		totals_merge(&totals, &batchTotals[i]);
+	}
+
+	thread_pool_destroy(pool);
+	free(order);
+	free(periodStarts);
+	free(batchStarts);
+	free(batchTotals);
+	free(batchSucceeded);
+
+	if (success == false)
+	{
+		return false;
+	}
+
+	totals_to_result(&totals, result);
+	dyn_array_clear(ready_queue);
+	return true;
+}
+
+
+// One virtual CPU of the SMP simulation
+typedef struct
+{
+	ReadyHeap_t queue;	// this core's run queue, ordered the way the policy orders its ready set
+	bool running;
+	uint64_t running_key;// the running pcb's key as of dispatch
+	uint64_t dispatched;// when the running pcb got the CPU
+	uint64_t event;		// when its quantum runs out, UINT64_MAX if it has none
+	uint64_t busy;		// total time spent running pcbs
+}
+SmpCore_t;
+
+// The SMP simulation as a policy over the policy core, one core per cpu of the core's loop
+typedef struct
+{
+	SmpCore_t *cores;
+	size_t numCores;
+	ScheduleAlgorithm_t algorithm;	// the policy every core runs
+	size_t quantum;					// the time slice, only used by round robin
+	uint64_t sequence;				// round robin enqueue order
+	uint64_t finished;				// when the last pcb completed
+}
+SmpPolicy_t;
+
+// Picks the core an arriving pcb is queued on: the first idle core with nothing queued, otherwise the core with the fewest pcbs.
+// A core whose quantum runs out now counts as idle, its pcb goes back on its queue after the arrivals.
+static size_t smp_place(const SmpCore_t *cores, size_t numCores, uint64_t now)
+{
+	size_t best = 0;
+	size_t bestLoad = SIZE_MAX;
+
+	for (size_t c = 0; c < numCores; c++)
+	{
+		size_t load = cores[c].queue.size + (cores[c].running && cores[c].event > now ? 1 : 0);
+		if (load == 0)
+		{
+			return c;
+		}
+		if (load < bestLoad)
+		{
+			best = c;
+			bestLoad = load;
+		}
+	}
+	return best;
+}
+
+// Takes the running pcb off core at time now, charging the core for the time it ran
+static void smp_stop(SmpCore_t *core, uint64_t now)
+{
+	core->busy += now - core->dispatched;
+	core->running = false;
+}
+
+static bool smp_on_arrival(void *state, const ProcessControlBlock_t *pcb, size_t id, uint32_t remaining, uint64_t now, size_t from)
+{
+	SmpPolicy_t *policy = (SmpPolicy_t *)state;
+	SmpCore_t *core = &policy->cores[from == SCHEDULE_POLICY_ARRIVED ? smp_place(policy->cores, policy->numCores, now) : from]; // preempted pcbs go back on their core
+	// the same key the single CPU engines order by; round robin keys by a global sequence number, which makes each core's heap a FIFO
+	uint64_t key = policy->algorithm == SCHEDULE_RR ? policy->sequence++ : ready_key(pcb, remaining, algorithm_key(policy->algorithm));
+	return ready_heap_push(&core->queue, key, id);
+}
+
+// Dispatches from the core's own queue or, if that is empty, steals the next pcb of the core with the longest queue
+static bool smp_select(void *state, size_t cpu, uint64_t now, size_t *id, uint64_t *slice)
+{
+	SmpPolicy_t *policy = (SmpPolicy_t *)state;
+	SmpCore_t *core = &policy->cores[cpu];
+	size_t victim = cpu;
+
+	for (size_t v = 0; ready_heap_empty(&core->queue) && v < policy->numCores; v++)
+	{
+		if (policy->cores[v].queue.size > policy->cores[victim].queue.size)
+		{
+			victim = v;
+		}
+	}
+	if (ready_heap_empty(&policy->cores[victim].queue))
+	{
+		return false;
+	}
+
+	ReadyEntry_t next = ready_heap_pop(&policy->cores[victim].queue);
+	*id = next.rank;
+	core->running_key = next.key;
+	*slice = policy->algorithm == SCHEDULE_RR ? policy->quantum : UINT64_MAX;
+	core->running = true;
+	core->dispatched = now;
+	core->event = policy->algorithm == SCHEDULE_RR ? now + policy->quantum : UINT64_MAX;
+	return true;
+}
+
+// A round robin quantum ran out, or a shorter job or an earlier deadline is queued on the core
+static bool smp_preempt(void *state, size_t cpu, size_t running, uint32_t remaining, uint64_t now, uint64_t *slice)
+{
+	SmpPolicy_t *policy = (SmpPolicy_t *)state;
+	SmpCore_t *core = &policy->cores[cpu];
+	bool preempted = *slice == 0;
+
+	if (!preempted && algorithm_preemptive(policy->algorithm) && !ready_heap_empty(&core->queue))
+	{
+		ReadyEntry_t current = {policy->algorithm == SCHEDULE_SRT ? remaining : core->running_key, running};
+		preempted = ready_entry_before(ready_heap_top(&core->queue), current);
+	}
+
+	if (preempted)
+	{
+		smp_stop(core, now);
+	}
+	return preempted;
+}
+
+static void smp_on_complete(void *state, size_t cpu, size_t id, uint64_t now)
+{
+	(void)id;
+	SmpPolicy_t *policy = (SmpPolicy_t *)state;
+	smp_stop(&policy->cores[cpu], now);
+	policy->finished = now;
+}
+
+static const SchedulePolicyOps_t smp_ops = {smp_on_arrival, smp_select, smp_preempt, smp_on_complete};
+
+// Sets up the SMP policy with idle cores and empty run queues; free it with smp_destroy whatever this returns
+// \param policy the policy to set up
+// \param algorithm the policy every core runs, valid
+// \param quantum the time slice, only used by round robin
+// \param numCores how many cores, at least one
+// \return true if function ran successful else false for an error
+static bool smp_init(SmpPolicy_t *policy, ScheduleAlgorithm_t algorithm, size_t quantum, size_t numCores)
+{
+	policy->cores = (SmpCore_t *)calloc(numCores, sizeof(SmpCore_t));
+	policy->numCores = numCores;
+	policy->algorithm = algorithm;
+	policy->quantum = quantum;
+	policy->sequence = 0;
+	policy->finished = 0;
+
+	bool success = policy->cores != NULL;
+	for (size_t c = 0; success && c < numCores; c++)
+	{
+		success = ready_heap_init(&policy->cores[c].queue, 0);
+	}
+	return success;
+}
+
+// Frees what smp_init set up
+static void smp_destroy(SmpPolicy_t *policy)
+{
+	for (size_t c = 0; policy->cores != NULL && c < policy->numCores; c++)
+	{
+		ready_heap_destroy(&policy->cores[c].queue);
+	}
+	free(policy->cores);
+	policy->cores = NULL;
+}
+
+// Runs algorithm over the incoming ready_queue on num_cores virtual CPUs, each with its own run queue
+// Arrivals are queued on the least loaded core and idle cores steal from the core with the longest queue.
+// Time jumps from event to event (an arrival, a completion or the end of a quantum) on the policy core, which runs
+// one cpu per core; with one core this is the single CPU schedule exactly.
+// \param ready queue a dyn_array of type ProcessControlBlock_t that contain be up to N elements
+// \param result used for stat tracking \ref ScheduleResult_t, total_run_time is the CPU time summed over all cores
+// \param algorithm the policy every core runs
+// \param quantum the time slice, only used by round robin
+// \param num_cores how many virtual CPUs to simulate, at least one
+// \param core_utilization optional, receives num_cores fractions of the time from first arrival to last completion each core was busy
+// \param columns receives per-pcb results in the arrays it points to \ref ScheduleColumns_t, NULL for none
+// \return true if function ran successful else false for an error
+bool schedule_smp(dyn_array_t *ready_queue, ScheduleResult_t *result, ScheduleAlgorithm_t algorithm, size_t quantum, size_t num_cores, float *core_utilization,
+	const ScheduleColumns_t *columns)
+{
+	if (ready_queue == NULL || result == NULL || num_cores == 0 || dyn_array_size(ready_queue) == 0 ||
+		(algorithm == SCHEDULE_RR && quantum == 0) || algorithm > SCHEDULE_EDF_PREEMPTIVE) // check for invalid parameters or no processes to be scheduled
+	{
+		return false;
+	}
+
+	const ProcessControlBlock_t *pcbs = (const ProcessControlBlock_t *)dyn_array_export(ready_queue);
+	size_t numPCBs = dyn_array_size(ready_queue);
+	size_t *order = arrival_order(pcbs, numPCBs);
+	SmpPolicy_t policy;
+	bool success = smp_init(&policy, algorithm, quantum, num_cores) && order != NULL;
+	ScheduleTotals_t totals = {0};
+
+	if (success)
+	{
+		totals_columns_begin(&totals, columns, pcbs, numPCBs);
+		success = schedule_policy_run(pcbs, order, numPCBs, num_cores, &smp_ops, &policy, &totals);
+	}
+
+	if (success && core_utilization != NULL)
+	{
+		uint64_t span = policy.finished - pcbs[order[0]].arrival;
+		for (size_t c = 0; c < num_cores; c++)
+		{
+			core_utilization[c] = span ? (float)policy.cores[c].busy/span : 0.0f;
+		}
+	}
+
+	smp_destroy(&policy);
+	free(order);
+
+	if (success == false)
+	{
+		return false;
+	}
+
+	totals_to_result(&totals, result);
+	dyn_array_clear(ready_queue);
+	return true;
+}
+
+// Frees a policy made by schedule_policy_smp
+static void smp_free(void *state)
+{
+	smp_destroy((SmpPolicy_t *)state);
+	free(state);
+}
+
+// Builds the SMP simulation of schedule_smp, for running it incrementally (see schedule_session.h)
+// \param policy receives the ops table, the state and how to free it \ref SchedulePolicy_t, one cpu per core
+// \param algorithm the policy every core runs
+// \param quantum the time slice, only used by round robin (where it must not be 0)
+// \param num_cores how many virtual CPUs to simulate, at least one
+// \return true if function ran successful else false for an error
+bool schedule_policy_smp(SchedulePolicy_t *policy, ScheduleAlgorithm_t algorithm, size_t quantum, size_t num_cores)
+{
+	if (policy == NULL || num_cores == 0 || (algorithm == SCHEDULE_RR && quantum == 0) || algorithm > SCHEDULE_EDF_PREEMPTIVE)
+	{
+		return false;
+	}
+
+	SmpPolicy_t *state = (SmpPolicy_t *)malloc(sizeof(SmpPolicy_t));
+	if (state == NULL)
+	{
+		return false;
+	}
+	if (smp_init(state, algorithm, quantum, num_cores) == false)
+	{
+		smp_free(state);
+		return false;
+	}
+
+	return policy_built(policy, &smp_ops, state, smp_free, num_cores);
+}
+
+
+// Runs the Round Robin Process Scheduling algorithm over the incoming ready_queue
+// \param ready queue a dyn_array of type ProcessControlBlock_t that contain be up to N elements
+// \param result used for round robin stat tracking \ref ScheduleResult_t
+// \param the quantum
+// \return true if function ran successful else false for an error
+bool round_robin(dyn_array_t *ready_queue, ScheduleResult_t *result, size_t quantum) 
+{
+	if (quantum == 0) // a zero quantum would never make progress
+	{
+		return false;
+	}
+
+	return schedule_and_drain(ready_queue, result, SCHEDULE_RR, quantum);
+}
+
+// Independent runs over one shared arrival order, one per thread pool task
+typedef struct
+{
+	const ProcessControlBlock_t *pcbs;
+	const size_t *order;
+	size_t numPCBs;
+	const AlgorithmParams_t *runs;
+	ScheduleResult_t *results;
+	bool *succeeded;
+}
+ScheduleRuns_t;
+
+static void run_schedule_run(void *arg, size_t index)
+{
+	const ScheduleRuns_t *runs = (const ScheduleRuns_t *)arg;
+	ScheduleTotals_t totals = {0};
+
+	runs->succeeded[index] = run_algorithm(runs->pcbs, runs->order, runs->numPCBs, runs->runs[index].algorithm, runs->runs[index].quantum, &totals);
+	if (runs->succeeded[index])
+	{
+		totals_to_result(&totals, &runs->results[index]);
+	}
+}
+
+// Sorts ready_queue by arrival once and spreads the runs over a thread pool, every run reads the same pcbs
+static bool run_in_parallel(const dyn_array_t *ready_queue, const AlgorithmParams_t *runs, size_t numRuns, ScheduleResult_t *results, size_t num_threads)
+{
+	const ProcessControlBlock_t *pcbs = (const ProcessControlBlock_t *)dyn_array_export(ready_queue);
+	size_t numPCBs = dyn_array_size(ready_queue);
+	size_t *order = arrival_order(pcbs, numPCBs);
+	bool *succeeded = (bool *)calloc(numRuns, sizeof(bool));
+	thread_pool_t *pool = thread_pool_create(num_threads < numRuns ? num_threads : numRuns);
+
+	bool success = order != NULL && succeeded != NULL && pool != NULL;
+	if (success)
+	{
+		ScheduleRuns_t batch = {.pcbs = pcbs, .order = order, .numPCBs = numPCBs, .runs = runs, .results = results, .succeeded = succeeded};
+		thread_pool_run(pool, numRuns, run_schedule_run, &batch);
+	}
+
+	for (size_t i = 0; i < numRuns && success; i++)
+	{
+		success = succeeded[i];
+	}
+
+	thread_pool_destroy(pool);
+	free(order);
+	free(succeeded);
+	return success;
+}
+
+// Runs Round Robin once per quantum over the same ready_queue, the quanta spread over several threads
+// The input is sorted by arrival once and shared read-only by every run; ready_queue is left as it was.
+// \param ready queue a dyn_array of type ProcessControlBlock_t that contain be up to N elements
+// \param quanta the quanta to try, none of them 0
+// \param num_quanta number of quanta
+// \param results receives one \ref ScheduleResult_t per quantum, in the order of quanta
+// \param num_threads how many threads to use, 0 for one per online CPU
+// \return true if function ran successful else false for an error
+bool round_robin_sweep(const dyn_array_t *ready_queue, const size_t *quanta, size_t num_quanta, ScheduleResult_t *results, size_t num_threads)
+{
+	if (ready_queue == NULL || quanta == NULL || results == NULL || num_quanta == 0 || dyn_array_size(ready_queue) == 0)
+	{
+		return false;
+	}
+
+	AlgorithmParams_t *runs = (AlgorithmParams_t *)malloc(num_quanta * sizeof(AlgorithmParams_t));
+	if (runs == NULL)
+	{
+		return false;
+	}
+
+	bool success = true;
+	for (size_t i = 0; i < num_quanta; i++)
+	{
+		runs[i].algorithm = SCHEDULE_RR;
+		runs[i].quantum = quanta[i];
+		success = success && quanta[i] > 0; // a zero quantum would never make progress
+	}
+
+	success = success && run_in_parallel(ready_queue, runs, num_quanta, results, num_threads);
+	free(runs);
+	return success;
+}
+
+// Runs several algorithms over the same ready_queue, each on its own thread
+// The input is sorted by arrival once and shared read-only by every run; ready_queue is left as it was.
+// \param ready queue a dyn_array of type ProcessControlBlock_t that contain be up to N elements
+// \param algorithms the policies to run
+// \param num_algorithms number of algorithms
+// \param quantum the time slice, only used by round robin
+// \param results receives one \ref ScheduleResult_t per algorithm, in the order of algorithms
+// \param num_threads how many threads to use, 0 for one per online CPU
+// \return true if function ran successful else false for an error
+bool schedule_compare(const dyn_array_t *ready_queue, const ScheduleAlgorithm_t *algorithms, size_t num_algorithms, size_t quantum,
+	ScheduleResult_t *results, size_t num_threads)
+{
+	if (ready_queue == NULL || algorithms == NULL || results == NULL || num_algorithms == 0 || dyn_array_size(ready_queue) == 0)
+	{
+		return false;
+	}
+
+	AlgorithmParams_t *runs = (AlgorithmParams_t *)malloc(num_algorithms * sizeof(AlgorithmParams_t));
+	if (runs == NULL)
+	{
+		return false;
+	}
+
+	bool success = true;
+	for (size_t i = 0; i < num_algorithms; i++)
+	{
+		runs[i].algorithm = algorithms[i];
+		runs[i].quantum = quantum;
+		success = success && algorithms[i] <= SCHEDULE_EDF_PREEMPTIVE && (algorithms[i] != SCHEDULE_RR || quantum > 0);
+	}
+
+	success = success && run_in_parallel(ready_queue, runs, num_algorithms, results, num_threads);
+	free(runs);
+	return success;
+}
 
 
-// You might find this handy.  I put it around unused parameters, but you should
-// remove it before you submit. Just allows things to compile initially.
-#define UNUSED(x) (void)(x)
+// Per pcb state of the multi-level feedback queue, taken from the policy's job pool
+typedef struct mlfq_job
+{
+	struct mlfq_job *next;	// next pcb in its level's queue
+	uint64_t used;			// time used of the allotment at its level
+	uint64_t epoch;			// the boost its level and allotment are from
+	size_t id;
+	uint32_t remaining;		// burst still to run
+	uint32_t level;
+}
+MlfqJob_t;
 
-// private function
-void virtual_cpu(ProcessControlBlock_t *process_control_block) 
+// Every level is an intrusive FIFO threaded through MlfqJob_t.next, bit i of nonEmpty is set while level i has pcbs
+typedef struct
 {
-	// decrement the burst time of the pcb
-	--process_control_block->remaining_burst_time;
+	MlfqJob_t *head[MLFQ_MAX_LEVELS];
+	MlfqJob_t *tail[MLFQ_MAX_LEVELS];
+	uint64_t nonEmpty;
 }
+MlfqQueues_t;
 
+static void mlfq_push(MlfqQueues_t *queues, size_t level, MlfqJob_t *job)
+{
+	job->next = NULL;
+	if (queues->head[level] == NULL)
+	{
+		queues->head[level] = job;
+		queues->nonEmpty |= UINT64_C(1) << level;
+	}
+	else
+	{
+		queues->tail[level]->next = job;
+	}
+	queues->tail[level] = job;
+}
 
-int compareByArrival(const void *a, const void *b) // creates a custom comparator function to compare based on arrival time
+static MlfqJob_t *mlfq_pop(MlfqQueues_t *queues, size_t level)
 {
-	ProcessControlBlock_t * PCB1 = (ProcessControlBlock_t *)a;
-	ProcessControlBlock_t * PCB2 = (ProcessControlBlock_t *)b;
-	return (PCB1->arrival - PCB2->arrival);
+	MlfqJob_t *job = queues->head[level];
+	queues->head[level] = job->next;
+	if (queues->head[level] == NULL)
+	{
+		queues->nonEmpty &= ~(UINT64_C(1) << level);
+	}
+	return job;
 }
 
-// Runs the First Come First Served Process Scheduling algorithm over the incoming ready_queue
-// \param ready queue a dyn_array of type ProcessControlBlock_t that contain be up to N elements
-// \param result used for first come first served stat tracking \ref ScheduleResult_t
-// \return true if function ran successful else false for an error
-bool first_come_first_serve(dyn_array_t *ready_queue, ScheduleResult_t *result) 
+// Priority boost: appends every lower level, in order, to the top level. O(levels), the pcbs themselves are
+// only told when they are next dispatched, through their stale epoch.
+static void mlfq_boost(MlfqQueues_t *queues, size_t levels)
 {
-	if (ready_queue == NULL || result == NULL || dyn_array_size(ready_queue) == 0) // check for invalid parameters or no processes to be scheduled
+	for (size_t level = 1; level < levels; level++)
+	{
+		if (queues->head[level] == NULL)
+		{
+			continue;
+		}
+		if (queues->head[0] == NULL)
+		{
+			queues->head[0] = queues->head[level];
+		}
+		else
+		{
+			queues->tail[0]->next = queues->head[level];
+		}
+		queues->tail[0] = queues->tail[level];
+		queues->head[level] = NULL;
+	}
+	queues->nonEmpty = queues->head[0] == NULL ? 0 : 1;
+}
+
+// Multi-level feedback queue. New pcbs enter the top level; a pcb that uses up its level's allotment (the level's
+// quantum, summed over however many dispatches it took) drops a level; a pcb on a higher level preempts the running
+// one; every boost_period time units everything goes back to the top. The highest non-empty level is the lowest set
+// bit of a bitmap, so picking the next pcb is O(1) for any number of levels. A slice ends when the allotment runs out
+// or at the next boost, so the core wakes the policy at quantum ends and boosts as well as arrivals and completions.
+// The config is copied in, quanta included, so a streamed policy doesn't hold on to the caller's arrays.
+typedef struct
+{
+	MlfqQueues_t queues;
+	JobPool_t jobs;
+	MlfqJob_t *running;
+	size_t levels;
+	size_t quanta[MLFQ_MAX_LEVELS];
+	size_t boostPeriod;
+	uint64_t epoch;		// boosts so far
+	uint64_t nextBoost;	// UINT64_MAX without boosts
+}
+MlfqPolicy_t;
+
+// Whether config describes a multi-level feedback queue that makes progress
+static bool mlfq_config_valid(const MlfqConfig_t *config)
+{
+	if (config == NULL || config->levels == 0 || config->levels > MLFQ_MAX_LEVELS || config->quanta == NULL)
 	{
 		return false;
 	}
 
-	uint32_t currentTime = 0;
-	uint32_t totalRunTime = 0;
-	uint32_t totalTurnAroundTime = 0;
-	uint32_t totalWaitingTime = 0;
+	for (size_t level = 0; level < config->levels; level++)
+	{
+		if (config->quanta[level] == 0) // a zero quantum would never make progress
+		{
+			return false;
+		}
+	}
+	return true;
+}
 
-	size_t numPCBs = dyn_array_size(ready_queue); // gets the number of processes
+// Sets up a multi-level feedback queue with empty levels
+// \param policy the policy to set up
+// \param config the levels, their quanta and the boost period, already validated
+// \param capacity pcbs the job pool has room for before it grows, 0 for a default
+static void mlfq_init(MlfqPolicy_t *policy, const MlfqConfig_t *config, size_t capacity)
+{
+	for (size_t level = 0; level < MLFQ_MAX_LEVELS; level++)
+	{
+		policy->queues.head[level] = policy->queues.tail[level] = NULL;
+		policy->quanta[level] = level < config->levels ? config->quanta[level] : 0;
+	}
+	policy->queues.nonEmpty = 0;
+	job_pool_init(&policy->jobs, sizeof(MlfqJob_t), capacity);
+	policy->running = NULL;
+	policy->levels = config->levels;
+	policy->boostPeriod = config->boost_period;
+	policy->epoch = 0;
+	policy->nextBoost = config->boost_period ? config->boost_period : UINT64_MAX;
+}
 
-	if (dyn_array_sort(ready_queue, compareByArrival) == false) // sort by arrival
+// Boosts every pcb back to the top level once now reaches the next boost. The running pcb, if any, keeps the CPU
+// with a fresh top level allotment.
+static void mlfq_boost_due(MlfqPolicy_t *policy, uint64_t now)
+{
+	if (now < policy->nextBoost)
 	{
-		return false; // if dyn_array_sort fails, the algorithm fails
+		return;
 	}
 
-	while (dyn_array_size(ready_queue) > 0) // for all of the processes in the queue
+	policy->epoch++;
+	mlfq_boost(&policy->queues, policy->levels);
+	if (policy->running != NULL)
 	{
+		policy->running->used = 0;
+		policy->running->epoch = policy->epoch;
+		policy->running->level = 0;
+	}
+	policy->nextBoost = (now / policy->boostPeriod + 1) * policy->boostPeriod;
+}
 
-		ProcessControlBlock_t processToRun; // make a local pcb variable to store the process we want to run
+// The time job can run from now: what is left of its allotment, or up to the next boost
+static uint64_t mlfq_slice(const MlfqPolicy_t *policy, const MlfqJob_t *job, uint64_t now)
+{
+	uint64_t allotment = policy->quanta[job->level] - job->used;
+	return allotment < policy->nextBoost - now ? allotment : policy->nextBoost - now;
+}
 
-		if (dyn_array_extract_front(ready_queue, &processToRun) == false) // grabs the pcb and removes it from the ready_queue
-		{
-			return false; // if dyn_array_extract_front fails, the algorithm fails
-		} // now we have the process we want to run
+static bool mlfq_on_arrival(void *state, const ProcessControlBlock_t *pcb, size_t id, uint32_t remaining, uint64_t now, size_t from)
+{
+	(void)pcb;
+	(void)now;
+	MlfqPolicy_t *policy = (MlfqPolicy_t *)state;
+	MlfqJob_t *job = policy->running; // preempted pcbs keep the allotment used so far
 
-		if (currentTime <= processToRun.arrival) // ensures that the process has arrived
+	if (from == SCHEDULE_POLICY_ARRIVED) // arrivals enter the top level
+	{
+		job = (MlfqJob_t *)job_pool_take(&policy->jobs);
+		if (job == NULL)
 		{
-			currentTime = processToRun.arrival; // we don't necessarily care what the first arrival time is, we've already sorted by arrival so the one with the shortest arrival time should be first
+			return false;
 		}
+		*job = (MlfqJob_t){NULL, 0, policy->epoch, id, remaining, 0};
+	}
+	else
+	{
+		policy->running = NULL;
+	}
+	mlfq_push(&policy->queues, job->level, job);
+	return true;
+}
 
-		uint32_t waitTime = currentTime - processToRun.arrival; // time between arrival of the process and the first time the process is scheduled to run on the CPU which is the current time right before we run the process
-    	totalWaitingTime += waitTime;
+static bool mlfq_select(void *state, size_t cpu, uint64_t now, size_t *id, uint64_t *slice)
+{
+	(void)cpu;
+	MlfqPolicy_t *policy = (MlfqPolicy_t *)state;
+	mlfq_boost_due(policy, now);
+
+	MlfqJob_t *job = mlfq_pop(&policy->queues, (size_t)__builtin_ctzll(policy->queues.nonEmpty));
+	if (job->epoch != policy->epoch) // boosted while it waited
+	{
+		job->epoch = policy->epoch;
+		job->level = 0;
+		job->used = 0;
+	}
+	policy->running = job;
+	*id = job->id;
+	*slice = mlfq_slice(policy, job, now);
+	return true;
+}
 
-		while(processToRun.remaining_burst_time > 0) // this moves the process through units of time until it is completed
+static bool mlfq_preempt(void *state, size_t cpu, size_t running, uint32_t remaining, uint64_t now, uint64_t *slice)
+{
+	(void)cpu;
+	(void)running;
+	MlfqPolicy_t *policy = (MlfqPolicy_t *)state;
+	MlfqJob_t *job = policy->running;
+	job->used += job->remaining - remaining;
+	job->remaining = remaining;
+
+	if (job->used == policy->quanta[job->level]) // used up its allotment, drop a level before any boost
+	{
+		if (job->level + 1 < policy->levels)
 		{
-			virtual_cpu(&processToRun); // decrement remaining_burst_time
-			currentTime++; // keep current time tracker up to date
-			totalRunTime++; // sums up all the burst times
+			job->level++;
 		}
+		job->used = 0;
+		return true;
+	}
 
-		uint32_t turnAroundTime = currentTime - processToRun.arrival; // the time a process takes to complete (from arrival to completion), the current time after a process completes is it's completion time
-		totalTurnAroundTime += turnAroundTime;
+	mlfq_boost_due(policy, now);
+	if (policy->queues.nonEmpty != 0 && (uint32_t)__builtin_ctzll(policy->queues.nonEmpty) < job->level) // a higher level is ready
+	{
+		return true;
 	}
 
-	result->average_waiting_time = (float)totalWaitingTime/numPCBs;
-	result->average_turnaround_time = (float)totalTurnAroundTime/numPCBs;
-	result->total_run_time = totalRunTime;
+	*slice = mlfq_slice(policy, job, now);
+	return false;
+}
 
-	return true;
+static void mlfq_on_complete(void *state, size_t cpu, size_t id, uint64_t now)
+{
+	(void)cpu;
+	(void)id;
+	(void)now;
+	MlfqPolicy_t *policy = (MlfqPolicy_t *)state;
+	job_pool_give(&policy->jobs, policy->running);
+	policy->running = NULL;
 }
 
+static const SchedulePolicyOps_t mlfq_ops = {mlfq_on_arrival, mlfq_select, mlfq_preempt, mlfq_on_complete};
 
-// Runs the Shortest Job First Scheduling algorithm over the incoming ready_queue
+// Runs the multi-level feedback queue
+// \param pcbs the pcbs to schedule, left untouched
+// \param order the arrival order of the pcbs to run, see arrival_order
+// \param numPCBs number of pcbs in order, at least one
+// \param params the MlfqConfig_t, already validated
+// \param totals receives the statistics
+// \return true if function ran successful else false for an error
+static bool run_multi_level_feedback_queue(const ProcessControlBlock_t *pcbs, const size_t *order, size_t numPCBs, const void *params, ScheduleTotals_t *totals)
+{
+	MlfqPolicy_t policy;
+	mlfq_init(&policy, (const MlfqConfig_t *)params, numPCBs);
+
+	bool success = schedule_policy_run(pcbs, order, numPCBs, 1, &mlfq_ops, &policy, totals);
+	job_pool_destroy(&policy.jobs);
+	return success;
+}
+
+// Runs the Multi-Level Feedback Queue Process Scheduling algorithm over the incoming ready_queue
 // \param ready queue a dyn_array of type ProcessControlBlock_t that contain be up to N elements
-// \param result used for shortest job first stat tracking \ref ScheduleResult_t
+// \param result used for multi-level feedback queue stat tracking \ref ScheduleResult_t
+// \param config the levels, their quanta and the boost period \ref MlfqConfig_t
+// \param columns receives per-pcb results in the arrays it points to \ref ScheduleColumns_t, NULL for none
 // \return true if function ran successful else false for an error
-bool shortest_job_first(dyn_array_t *ready_queue, ScheduleResult_t *result) 
+bool multi_level_feedback_queue(dyn_array_t *ready_queue, ScheduleResult_t *result, const MlfqConfig_t *config, const ScheduleColumns_t *columns)
 {
-	if (ready_queue == NULL || result == NULL || dyn_array_size(ready_queue) == 0) // check for invalid parameters or no processes to be scheduled
+	if (mlfq_config_valid(config) == false) // check for invalid parameters
 	{
 		return false;
 	}
 
-	uint32_t currentTime = 0;
-	uint32_t totalRunTime = 0;
-	uint32_t totalTurnAroundTime = 0;
-	uint32_t totalWaitingTime = 0;
+	return run_and_drain(ready_queue, result, run_multi_level_feedback_queue, config, columns);
+}
 
-	size_t numPCBs = dyn_array_size(ready_queue);
+// Frees a policy made by schedule_policy_mlfq
+static void mlfq_free(void *state)
+{
+	job_pool_destroy(&((MlfqPolicy_t *)state)->jobs);
+	free(state);
+}
+
+// Builds the multi-level feedback queue, for running it incrementally (see schedule_session.h)
+// \param policy receives the ops table, the state and how to free it \ref SchedulePolicy_t
+// \param config the levels, their quanta and the boost period \ref MlfqConfig_t, copied
+// \return true if function ran successful else false for an error
+bool schedule_policy_mlfq(SchedulePolicy_t *policy, const MlfqConfig_t *config)
+{
+	MlfqPolicy_t *state = (MlfqPolicy_t *)malloc(sizeof(MlfqPolicy_t));
 
-	if (dyn_array_sort(ready_queue, compareByArrival) == false) // this will be used to get the next arrival time if there are gaps in arrival time
+	if (policy == NULL || state == NULL || mlfq_config_valid(config) == false)
 	{
-		return false; // if this operation fails, scheduling algorithm fails
+		free(state);
+		return false;
 	}
 
-	int minBTIndex = -1;
-	int noProcessArrivedFlag = 1;
+	mlfq_init(state, config, 0);
+	return policy_built(policy, &mlfq_ops, state, mlfq_free, 1);
+}
 
-	while (dyn_array_size(ready_queue) > 0) // while we still have processes to run
-	{
 
-		ProcessControlBlock_t* pcbWithMinBT = NULL;
-		minBTIndex = -1;
-		noProcessArrivedFlag = 1;
+// Load weight of each nice level, -20 to 19, as in Linux's sched_prio_to_weight: one nice level is about 10% CPU
+static const uint32_t cfs_nice_weights[40] =
+{
+	88761, 71755, 56483, 46273, 36291,
+	29154, 23254, 18705, 14949, 11916,
+	9548, 7620, 6100, 4904, 3906,
+	3121, 2501, 1991, 1586, 1277,
+	1024, 820, 655, 526, 423,
+	335, 272, 215, 172, 137,
+	110, 87, 70, 56, 45,
+	36, 29, 23, 18, 15
+};
+
+#define CFS_NICE_0_PRIORITY 20
+
+// Virtual runtime is kept in 1/64ths of a nice 0 time unit, so heavy pcbs still advance every tick
+#define CFS_VRUNTIME_SCALE (1024 * 64)
+
+// Maps a pcb's priority to a load weight: priority is nice + 20, clamped to nice 19, lower is heavier
+static uint32_t cfs_weight(const ProcessControlBlock_t *pcb)
+{
+	return cfs_nice_weights[pcb->priority < 40 ? pcb->priority : 39];
+}
 
-		for (size_t i = 0; i < dyn_array_size(ready_queue); i++)
-		{
-			ProcessControlBlock_t* pcb = (ProcessControlBlock_t *)dyn_array_at(ready_queue,i);
+// Per pcb state of the completely fair scheduler, taken from the policy's job pool; node.key is the virtual runtime
+typedef struct cfs_job
+{
+	RbNode_t node;			// first, so the leftmost node is the job
+	struct cfs_job *held;	// next arrival held back with it
+	uint32_t remaining;
+	uint32_t weight;
+}
+CfsJob_t;
 
-			if (currentTime >= pcb->arrival) // if a process has arrived, the current time is greater than or equal to the process arrival time
-			{
-				if(pcbWithMinBT == NULL || pcb->remaining_burst_time < pcbWithMinBT->remaining_burst_time) // ensures that at least one process gets selected
-				{
-					minBTIndex = i;
-					pcbWithMinBT = pcb;
-					noProcessArrivedFlag = 0;
-				}
-			}
-		}
+typedef struct
+{
+	size_t target_latency;
+	size_t min_granularity;
+}
+CfsParams_t;
+
+// Completely fair scheduler. Runnable pcbs sit in a red-black tree ordered by virtual runtime (time run, divided by
+// their weight) and the leftmost, the one that has had the least, runs next. It gets its weight's share of the
+// scheduling period, the target latency stretched to min_granularity per runnable pcb, and never less than
+// min_granularity. A whole slice is one step: arrivals during it are held back and queued at min_vruntime, as it
+// stands once the slice is charged, before the pcb that ran goes back in.
+typedef struct
+{
+	RbTree_t runnable;
+	JobPool_t jobs;
+	CfsJob_t *running;		// NULL while the cpu is idle
+	CfsJob_t *held;			// arrivals held back during the running slice
+	CfsParams_t params;
+	uint64_t minVruntime;
+	uint64_t totalWeight;	// of the runnable pcbs, the running one and those held back included
+}
+CfsPolicy_t;
 
-		if (noProcessArrivedFlag)
-		{
-			ProcessControlBlock_t* pcbNextArrived = (ProcessControlBlock_t *)dyn_array_front(ready_queue); 
-			currentTime = pcbNextArrived->arrival; // set currentTime to the next smallest arrival time you have in the ready_queue, this is the process that has arrived next, we want to start running it
-		}
-		else // the alternative is one or more processes have arrived
-		{
-			ProcessControlBlock_t processToRun; // temporary variable to hold pcb we want to run
+// Sets up a completely fair scheduler with nothing runnable
+// \param policy the policy to set up
+// \param params the target latency and minimum granularity, both non-zero
+// \param capacity pcbs the job pool has room for before it grows, 0 for a default
+static void cfs_init(CfsPolicy_t *policy, const CfsParams_t *params, size_t capacity)
+{
+	rb_tree_init(&policy->runnable);
+	job_pool_init(&policy->jobs, sizeof(CfsJob_t), capacity);
+	policy->running = NULL;
+	policy->held = NULL;
+	policy->params = *params;
+	policy->minVruntime = 0;
+	policy->totalWeight = 0;
+}
 
-			if (dyn_array_extract(ready_queue, minBTIndex, &processToRun) == false)
-			{
-				return false; // scheduling algorithm fails
-			}
+// Queues the held back arrivals, level with the fairest runnable pcb so they can't claim the CPU for the time they missed.
+// They all get the same key, so the order they go in doesn't matter: the tree breaks the tie by arrival.
+static void cfs_enqueue_arrived(CfsPolicy_t *policy)
+{
+	for (; policy->held != NULL; policy->held = policy->held->held)
+	{
+		policy->held->node.key = policy->minVruntime;
+		rb_tree_insert(&policy->runnable, &policy->held->node);
+	}
+}
 
-			// now we can run the process and calculate the times
-			uint32_t waitTime = currentTime - processToRun.arrival; // time between arrival of the process and the first time the process is scheduled to run on the CPU which is the current time right before we run the process
-    		totalWaitingTime += waitTime;
+// Charges the pcb that ran for its slice and moves min_vruntime forward to the fairest runnable pcb
+static void cfs_charge(CfsPolicy_t *policy, CfsJob_t *job, uint32_t remaining)
+{
+	job->node.key += (uint64_t)(job->remaining - remaining) * CFS_VRUNTIME_SCALE / job->weight;
+	job->remaining = remaining;
+	policy->running = NULL;
 
-			while(processToRun.remaining_burst_time > 0) // this moves the process through units of time until it is completed
-			{
-				virtual_cpu(&processToRun); // decrement remaining_burst_time
-				currentTime++; // keep current time tracker up to date
-				totalRunTime++; // sums up all the burst times
-			}
+	RbNode_t *leftmost = rb_tree_first(&policy->runnable);
+	uint64_t fairest = job->remaining ? job->node.key : UINT64_MAX;
+	if (leftmost != NULL && leftmost->key < fairest)
+	{
+		fairest = leftmost->key;
+	}
+	if (fairest != UINT64_MAX && fairest > policy->minVruntime) // min_vruntime only moves forward
+	{
+		policy->minVruntime = fairest;
+	}
+}
 
-			uint32_t turnAroundTime = currentTime - processToRun.arrival; // the time a process takes to complete (from arrival to completion), the current time after a process completes is it's completion time
-			totalTurnAroundTime += turnAroundTime;
+static bool cfs_on_arrival(void *state, const ProcessControlBlock_t *pcb, size_t id, uint32_t remaining, uint64_t now, size_t from)
+{
+	(void)now;
+	CfsPolicy_t *policy = (CfsPolicy_t *)state;
+
+	if (from == SCHEDULE_POLICY_ARRIVED)
+	{
+		CfsJob_t *job = (CfsJob_t *)job_pool_take(&policy->jobs);
+		if (job == NULL)
+		{
+			return false;
 		}
+
+		job->node.rank = id;
+		job->remaining = remaining;
+		job->weight = cfs_weight(pcb);
+		job->held = policy->held;
+		policy->held = job;
+		policy->totalWeight += job->weight;
+		if (policy->running == NULL)
+		{
+			cfs_enqueue_arrived(policy);
+		}
+		return true;
 	}
-	
-	result->average_waiting_time = (float)totalWaitingTime/numPCBs;
-	result->average_turnaround_time = (float)totalTurnAroundTime/numPCBs;
-	result->total_run_time = totalRunTime;
 
+	CfsJob_t *job = policy->running;
+	cfs_charge(policy, job, remaining); // the slice is over, arrivals during it go in first
+	cfs_enqueue_arrived(policy);
+	rb_tree_insert(&policy->runnable, &job->node);
+	return true;
+}
+
+static bool cfs_select(void *state, size_t cpu, uint64_t now, size_t *id, uint64_t *slice)
+{
+	(void)cpu;
+	(void)now;
+	CfsPolicy_t *policy = (CfsPolicy_t *)state;
+	const CfsParams_t *cfs = &policy->params;
+	CfsJob_t *job = (CfsJob_t *)rb_tree_first(&policy->runnable);
+	rb_tree_erase(&policy->runnable, &job->node);
+
+	uint64_t count = policy->runnable.size + 1;
+	uint64_t period = count > cfs->target_latency / cfs->min_granularity ? count * cfs->min_granularity : cfs->target_latency;
+	*slice = period * job->weight / policy->totalWeight;
+	if (*slice < cfs->min_granularity)
+	{
+		*slice = cfs->min_granularity;
+	}
+	*id = job->node.rank;
+	policy->running = job;
 	return true;
 }
 
+static void cfs_on_complete(void *state, size_t cpu, size_t id, uint64_t now)
+{
+	(void)cpu;
+	(void)id;
+	(void)now;
+	CfsPolicy_t *policy = (CfsPolicy_t *)state;
+	CfsJob_t *job = policy->running;
+	cfs_charge(policy, job, 0);
+	policy->totalWeight -= job->weight;
+	job_pool_give(&policy->jobs, job);
+	cfs_enqueue_arrived(policy);
+}
 
+static const SchedulePolicyOps_t cfs_ops = {cfs_on_arrival, cfs_select, NULL, cfs_on_complete};
 
-// Runs the Priority algorithm over the incoming ready_queue
+// Runs the completely fair scheduler
+// \param pcbs the pcbs to schedule, left untouched
+// \param order the arrival order of the pcbs to run, see arrival_order
+// \param numPCBs number of pcbs in order, at least one
+// \param params the CfsParams_t, already validated
+// \param totals receives the statistics
+// \return true if function ran successful else false for an error
+static bool run_completely_fair(const ProcessControlBlock_t *pcbs, const size_t *order, size_t numPCBs, const void *params, ScheduleTotals_t *totals)
+{
+	CfsPolicy_t policy;
+	cfs_init(&policy, (const CfsParams_t *)params, numPCBs);
+
+	bool success = schedule_policy_run(pcbs, order, numPCBs, 1, &cfs_ops, &policy, totals);
+	job_pool_destroy(&policy.jobs);
+	return success;
+}
+
+// Runs the Completely Fair Scheduler over the incoming ready_queue
 // \param ready queue a dyn_array of type ProcessControlBlock_t that contain be up to N elements
-// \param result used for shortest job first stat tracking \ref ScheduleResult_t
+// \param result used for completely fair scheduler stat tracking \ref ScheduleResult_t
+// \param target_latency the period in which every runnable pcb should get to run once
+// \param min_granularity the shortest slice a pcb is given
+// \param columns receives per-pcb results in the arrays it points to \ref ScheduleColumns_t, NULL for none
 // \return true if function ran successful else false for an error
-bool priority(dyn_array_t *ready_queue, ScheduleResult_t *result) 
+bool completely_fair_scheduler(dyn_array_t *ready_queue, ScheduleResult_t *result, size_t target_latency, size_t min_granularity,
+	const ScheduleColumns_t *columns)
 {
-	if (ready_queue == NULL || result == NULL || dyn_array_size(ready_queue) == 0) // check for invalid parameters or no processes to be scheduled
+	if (target_latency == 0 || min_granularity == 0) // zero slices would never make progress
 	{
 		return false;
 	}
 
-	uint32_t currentTime = 0;
-	uint32_t totalRunTime = 0;
-	uint32_t totalTurnAroundTime = 0;
-	uint32_t totalWaitingTime = 0;
+	CfsParams_t params = {target_latency, min_granularity};
+	return run_and_drain(ready_queue, result, run_completely_fair, &params, columns);
+}
 
-	size_t numPCBs = dyn_array_size(ready_queue);
+// Frees a policy made by schedule_policy_cfs
+static void cfs_free(void *state)
+{
+	job_pool_destroy(&((CfsPolicy_t *)state)->jobs);
+	free(state);
+}
 
-	if (dyn_array_sort(ready_queue, compareByArrival) == false) // this will be used to get the next arrival time if there are gaps in arrival time
+// Builds the Completely Fair Scheduler, for running it incrementally (see schedule_session.h)
+// \param policy receives the ops table, the state and how to free it \ref SchedulePolicy_t
+// \param target_latency the period in which every runnable pcb should get to run once
+// \param min_granularity the shortest slice a pcb is given
+// \return true if function ran successful else false for an error
+bool schedule_policy_cfs(SchedulePolicy_t *policy, size_t target_latency, size_t min_granularity)
+{
+	CfsPolicy_t *state = (CfsPolicy_t *)malloc(sizeof(CfsPolicy_t));
+
+	if (policy == NULL || state == NULL || target_latency == 0 || min_granularity == 0) // zero slices would never make progress
 	{
-		return false; // if this operation fails, scheduling algorithm fails
+		free(state);
+		return false;
 	}
 
-	int highestPIndex = -1;
-	int noProcessArrivedFlag = 1;
-
-	while (dyn_array_size(ready_queue) > 0) // while we still have processes to run
-	{
+	CfsParams_t params = {target_latency, min_granularity};
+	cfs_init(state, &params, 0);
+	return policy_built(policy, &cfs_ops, state, cfs_free, 1);
+}
 
-		ProcessControlBlock_t* pcbWithMaxP = NULL;
-		highestPIndex = -1;
-		noProcessArrivedFlag = 1;
 
-		for (size_t i = 0; i < dyn_array_size(ready_queue); i++)
-		{
-			ProcessControlBlock_t* pcb = (ProcessControlBlock_t *)dyn_array_at(ready_queue,i);
 
-			if (currentTime >= pcb->arrival) // if a process has arrived, the current time is greater than or equal to the process arrival time
-			{
-				if(pcbWithMaxP == NULL || pcb->priority < pcbWithMaxP->priority) // ensures that at least one process gets selected
-				{
-					highestPIndex = i;
-					pcbWithMaxP = pcb;
-					noProcessArrivedFlag = 0;
-				}
-			}
-		}
+// Stride of a pcb holding one ticket; a pcb with t tickets advances its pass by STRIDE_ONE / t per quantum.
+// 2^40 gives every 32-bit ticket count a non-zero stride, and distinct ones up to 2^20 tickets.
+#define STRIDE_ONE (UINT64_C(1) << 40)
 
-		if (noProcessArrivedFlag)
-		{
-			ProcessControlBlock_t* pcbNextArrived = (ProcessControlBlock_t *)dyn_array_front(ready_queue); 
-			currentTime = pcbNextArrived->arrival; // set currentTime to the next smallest arrival time you have in the ready_queue, this is the process that has arrived next, we want to start running it
-		}
-		else // the alternative is one or more processes have arrived
-		{
-			ProcessControlBlock_t processToRun; // temporary variable to hold pcb we want to run
+// Once the global pass is past this the passes are shifted down, see stride_select
+#define STRIDE_REBASE (UINT64_MAX / 2)
 
-			if (dyn_array_extract(ready_queue, highestPIndex, &processToRun) == false)
-			{
-				return false; // scheduling algorithm fails
-			}
+// A pcb's tickets are its priority, with at least one so every pcb makes progress
+static uint64_t stride_of(const ProcessControlBlock_t *pcb)
+{
+	return STRIDE_ONE / (pcb->priority ? pcb->priority : 1);
+}
 
-			// now we can run the process and calculate the times
-			uint32_t waitTime = currentTime - processToRun.arrival; // time between arrival of the process and the first time the process is scheduled to run on the CPU which is the current time right before we run the process
-    		totalWaitingTime += waitTime;
+// Stride scheduling. Every pcb holds priority tickets (at least one) and a pass value; the pcb with the
+// smallest pass runs for a quantum and its pass advances by its stride, so over time each pcb gets CPU in
+// proportion to its tickets, deterministically. The ready set is a heap keyed on pass, with the arrival rank
+// settling ties. A newcomer starts one stride past the pass of the last dispatched pcb, so it can't monopolize
+// the CPU to catch up. Every pass therefore lies within STRIDE_ONE of the global pass, so subtracting the global
+// pass from all of them now and then keeps them in 64 bits without changing any decision.
+typedef struct
+{
+	ReadyHeap_t ready;
+	size_t quantum;
+	uint64_t globalPass;	// pass of the last dispatched pcb
+}
+StridePolicy_t;
 
-			while(processToRun.remaining_burst_time > 0) // this moves the process through units of time until it is completed
-			{
-				virtual_cpu(&processToRun); // decrement remaining_burst_time
-				currentTime++; // keep current time tracker up to date
-				totalRunTime++; // sums up all the burst times
-			}
+static bool stride_on_arrival(void *state, const ProcessControlBlock_t *pcb, size_t id, uint32_t remaining, uint64_t now, size_t from)
+{
+	(void)remaining;
+	(void)now;
+	(void)from; // a pcb that ran was the last one dispatched, so it too goes one stride past the global pass
+	StridePolicy_t *policy = (StridePolicy_t *)state;
+	return ready_heap_push(&policy->ready, policy->globalPass + stride_of(pcb), id);
+}
 
-			uint32_t turnAroundTime = currentTime - processToRun.arrival; // the time a process takes to complete (from arrival to completion), the current time after a process completes is it's completion time
-			totalTurnAroundTime += turnAroundTime;
-		}
+static bool stride_select(void *state, size_t cpu, uint64_t now, size_t *id, uint64_t *slice)
+{
+	(void)cpu;
+	(void)now;
+	StridePolicy_t *policy = (StridePolicy_t *)state;
+	ReadyEntry_t next = ready_heap_pop(&policy->ready);
+	if (next.key > STRIDE_REBASE) // at most once per 2^23 quanta
+	{
+		ready_heap_rebase(&policy->ready, next.key);
+		next.key = 0;
 	}
-	
-	result->average_waiting_time = (float)totalWaitingTime/numPCBs;
-	result->average_turnaround_time = (float)totalTurnAroundTime/numPCBs;
-	result->total_run_time = totalRunTime;
-
+	policy->globalPass = next.key;
+	*id = next.rank;
+	*slice = policy->quantum;
 	return true;
 }
 
+static const SchedulePolicyOps_t stride_ops = {stride_on_arrival, stride_select, NULL, NULL};
 
-// Runs the Round Robin Process Scheduling algorithm over the incoming ready_queue
-// \param ready queue a dyn_array of type ProcessControlBlock_t that contain be up to N elements
-// \param result used for round robin stat tracking \ref ScheduleResult_t
-// \param the quantum
+// Sets up stride scheduling with an empty ready set
+// \param policy the policy to set up
+// \param quantum the time slice, at least one
+// \param capacity pcbs the heap has room for before it grows, 0 for a default
 // \return true if function ran successful else false for an error
-bool round_robin(dyn_array_t *ready_queue, ScheduleResult_t *result, size_t quantum) 
+static bool stride_init(StridePolicy_t *policy, size_t quantum, size_t capacity)
 {
-	
-	if (ready_queue == NULL || result == NULL || quantum == 0 || dyn_array_size(ready_queue) == 0) // check for null parameters, bad paramater or no processes to be scheduled
-	{
-		return false;
-	}
-	
-	uint32_t currentTime = UINT32_MAX; //Set starting varibles
-	uint32_t totalTurnAroundTime = 0;
-	uint32_t totalWaitingTime = 0;
-	
-	size_t numPCB = dyn_array_size(ready_queue); //Counts number of processes
-	
-	for(size_t i = 0; i < numPCB; i++){ //Creates a foor loop to check for null processes and set current time
-	
-	    if(dyn_array_at(ready_queue,i) == NULL){ 
-	    
-	        return false;
-	    }
-	    else{
-	        ProcessControlBlock_t* pcb = (ProcessControlBlock_t *)dyn_array_at(ready_queue,i); //Checks the processes and if its arrival time is less than the current time, set the current time to the fastest arrival times
-			currentTime = currentTime > pcb->arrival ? pcb->arrival : currentTime;
-	    }
-	
-	}
-
-
-	if (dyn_array_sort(ready_queue, compareByArrival) == false) //Sorts the queue by arrival time
-	{
-		return false;
-	}
-	
-	dyn_array_t* work_queue = dyn_array_create((int)numPCB, sizeof(ProcessControlBlock_t), NULL); //Creates array to hold working elements, (these are only ones that have arrived)
-	dyn_array_t* int_queue = dyn_array_create((int)numPCB, sizeof(uint32_t), NULL); //Creates an array to hold ints that keep track of 
-	
-	
-	for(size_t i = 0; i < numPCB; i++){ //Puts the first elements into the working array
-	    ProcessControlBlock_t* pcb = (ProcessControlBlock_t*)malloc(sizeof(ProcessControlBlock_t));
-	    dyn_array_extract_front(ready_queue, pcb); //gets the element
-	    if(currentTime == pcb->arrival){
-	    
-	         if(dyn_array_push_back(work_queue, (void *)pcb)){ //tries to push the process in the back of the queue
-	         
-	                uint32_t j = 0;
-	                uint32_t *pointer = &j;
-	                if(dyn_array_push_back(int_queue, (void *)pointer)){ //tries to push the process in the back of the queue
-	                
-	                }
-	                else {
-	                    dyn_array_destroy(work_queue);
-	                    dyn_array_destroy(int_queue);
-                        free(pcb);
-	                    return false;
-	                
-	                }
-	            }
-	            else{
-	            dyn_array_destroy(work_queue);
-	                    dyn_array_destroy(int_queue);
-	                free(pcb);
-	                return false;
-	        
-	               }
-	    
-	    }
-	    else{
-	        
-	                    if(dyn_array_push_back(ready_queue, (void *)pcb)){ //tries to push the process in the back of the queue
-	         
-	                    }
-	                    else{
-	                    dyn_array_destroy(work_queue);
-	                    dyn_array_destroy(int_queue);
-	                        free(pcb);
-	                        return false;
-	         
-	                    }
-	    
-	                }  
-	    free(pcb);
-	    pcb = NULL;
-	}
-	
-	bool done = false;
-	while((!dyn_array_empty(ready_queue)|| !dyn_array_empty(work_queue)) && !done){ //Keeps the loop going why the size is greater than zero
-	
-	    size_t Check = dyn_array_size(work_queue); //Gets the size of the array
-	    size_t RCheck = dyn_array_size(ready_queue); //Gets the size of the array
-	    
-	    if(Check > 0){
-	    
-	    ProcessControlBlock_t* pcb = (ProcessControlBlock_t*)malloc(sizeof(ProcessControlBlock_t));
-	    dyn_array_extract_front(work_queue, pcb); //Gets the first element
-	    uint32_t* inter = (uint32_t*)malloc(sizeof(uint32_t));
-	    dyn_array_extract_front(int_queue, inter); //Gets the first element
-	    
-	    
-	    
-	    
-	    
-	    uint32_t waitTime = 0; //Create a local wait time
-	    
-	    
-	    if(!(pcb->started)) {  //If the process has not started  
-	    
-	         waitTime = currentTime - pcb->arrival; //Wait time is the current minus arrival
-	        
-	    }
-	    else{
-	    
-	        waitTime = currentTime - (pcb->arrival + (*inter * quantum)); //Other wise wait time is current minus arrival minus the number of times processes times the quantum (C - (A + (Q*T)))
-	    }
-
-
-	        
-	        (*inter)++;
-	        if(pcb->remaining_burst_time > quantum){ //If burst time is greater than the quantum
-	        
-	            pcb-> started = true; //Set the started to true
-	        
-	        
-	            for(size_t j = 0; j < quantum; j++){ //Create a for loop for times to run the CPU
-	                
-	                virtual_cpu(pcb); //Run the CPU
-	                
-		            currentTime++;//Increment the times
-		            (result->total_run_time)++;
-		            
-		            
-		            for(size_t p = 0; p < RCheck; p++){ //Goes through ready queue to add new arrivals
-		            
-		                ProcessControlBlock_t* pcb3 = (ProcessControlBlock_t*)malloc(sizeof(ProcessControlBlock_t));
-	                    dyn_array_extract_front(ready_queue, pcb3); //Gets the first element of ready queue
-	                    if(pcb3->arrival == currentTime){
-	                    
-	                        if(dyn_array_push_back(work_queue, (void *)pcb3)){ //tries to push the process in the back of the queue
-	         
-	                            uint32_t m = 0;
-	                            uint32_t *pointer = &m;
-	                            if(dyn_array_push_back(int_queue, (void *)pointer)){ //tries to push the process in the back of the queue
-	                            }
-	                            else {
-	                             dyn_array_destroy(work_queue);
-	                                dyn_array_destroy(int_queue);
-	                                free(inter);
-	                                free(pcb);
-	                                free(pcb3);         
-	                                return false;
-	                
-	                            }
-	                        }
-	                        else{
-	                            dyn_array_destroy(work_queue);
-	                                dyn_array_destroy(int_queue);
-	                                free(inter);
-	                                free(pcb);
-	                                free(pcb3);              
-	                            return false;
-	        
-	                        }
-	                    
-	                    }
-	                    else{
-	                    
-	                        if(dyn_array_push_back(ready_queue, (void *)pcb3)){ //tries to push the process in the back of the queue
-	                
-	                        }
-	                        else {
-	                             dyn_array_destroy(work_queue);
-	                                dyn_array_destroy(int_queue);
-	                                free(inter);
-	                                free(pcb);
-	                                free(pcb3);  
-	                            return false;
-	                
-	                        }
-	                    
-	                    }
-		                
-		            free(pcb3);
-		            pcb3 = NULL;
-		            }
-		            
-		            
-	            }
-	            if(dyn_array_push_back(work_queue, (void *)pcb)){ //Try to push the process back on the stack
-	            
-	                if(dyn_array_push_back(int_queue, (void *)inter)){ //Try to push the int back on the stack
-	  
-	                }
-	                else{
-	                                dyn_array_destroy(work_queue);
-	                                dyn_array_destroy(int_queue);
-	                                free(inter);
-	                                free(pcb);
-	                                
-	                    return false; //If theres an error adding it back, return false;
-	                }
-	  
-	            }
-	            else{
-	                                dyn_array_destroy(work_queue);
-	                                dyn_array_destroy(int_queue);
-	                                free(inter);
-	                                free(pcb);
-	                return false; //If theres an error adding it back, return false;
-	            }
-	            
-	        }
-	        
-	        
-	        else{ //If the burst time is less than the quantum
-	        
-	            while(pcb->remaining_burst_time > 0) // this moves the process through units of time until it is completed
-			    {
-				    virtual_cpu(pcb); //Run the cpu
-				    
-				    currentTime++;//Increment the times
-				    result->total_run_time++;
-				    
-				    for(size_t p = 0; p < RCheck; p++){ //Goes through ready queue to add new arrivals
-		            
-		                ProcessControlBlock_t* pcb3 = (ProcessControlBlock_t*)malloc(sizeof(ProcessControlBlock_t)); 
-	                    dyn_array_extract_front(ready_queue, pcb3); //Gets the first element of ready queue
-	                    if(pcb3->arrival == currentTime){
-	                    
-	                        if(dyn_array_push_back(work_queue, (void *)pcb3)){ //tries to push the process in the back of the queue
-	         
-	                            uint32_t j = 0;
-	                            uint32_t *pointer = &j;
-	                            if(dyn_array_push_back(int_queue, (void *)pointer)){ //tries to push the process in the back of the queue
-	                            }
-	                            else {
-	                            
-	                                
-	                                dyn_array_destroy(work_queue);
-	                                dyn_array_destroy(int_queue);
-	                                free(inter);
-	                                free(pcb);
-	                                free(pcb3);
-	                                return false;
-	                                
-	                            }
-	                        }
-	                        else{
-	                            dyn_array_destroy(work_queue);
-	                                dyn_array_destroy(int_queue);
-	                                free(inter);
-	                                free(pcb);
-	                                free(pcb3);
-	                                return false;
-	        
-	                        }
-	                    
-	                    }
-	                    else{
-	                    
-	                        if(dyn_array_push_back(ready_queue, (void *)pcb3)){ //tries to push the process in the back of the queue
-	                
-	                        }
-	                        else {
-	                                dyn_array_destroy(work_queue);
-	                                dyn_array_destroy(int_queue);
-	                                free(inter);
-	                                free(pcb);
-	                                free(pcb3);
-	                                return false;
-	                
-	                        }
-	                    
-	                    }
-		                
-		            free(pcb3);
-		            pcb3 = NULL;
-		            }
-				    
-			    }
-			    
-			    totalTurnAroundTime += currentTime - pcb->arrival; //Add the turnaround time to the result varible
-			   
-			    totalWaitingTime += waitTime; //Add the wait time to the result varible
-	            
-	        }
-	        free(inter);
-	        inter = NULL;
-	        free(pcb);
-	        pcb = NULL;
-	    
-	    }
-	    else{ 
-
-	    
-	            ProcessControlBlock_t* pcb = (ProcessControlBlock_t *)dyn_array_at(ready_queue,0); //Gets the first element
-	            currentTime = pcb->arrival; //Sets the current time to the current processes arrival
-	            
-	            if(currentTime != 0){
-	            
-	            
-	            for(size_t k = 0; k < RCheck; k++){ //Puts the first elements into the working array
-	            
-	                ProcessControlBlock_t* pcb2 = (ProcessControlBlock_t*)malloc(sizeof(ProcessControlBlock_t)); 
-	                dyn_array_extract_front(ready_queue, pcb2); //gets the element
-	                if(currentTime == pcb2->arrival){
-	    
-	                    
-	                    if(dyn_array_push_back(work_queue, (void *)pcb2)){ //tries to push the process in the back of the queue
-	         
-	                        uint32_t j = 0;
-	                        uint32_t *pointer = &j;
-	                
-	                            if(dyn_array_push_back(int_queue, (void *)pointer)){ //tries to push the process in the back of the queue
-	                            }
-	                            else {
-	                            
-	                                dyn_array_destroy(work_queue);
-	                                dyn_array_destroy(int_queue);
-	                                free(pcb2);
-	                                return false;
-	                
-	                            }
-	                   }
-	                    else{
-        	                        dyn_array_destroy(work_queue);
-	                                dyn_array_destroy(int_queue);
-	                                free(pcb2);
-	                        return false;
-	        
-	                    }
-	    
-	                }
-	                else{
-	        
-	                    if(dyn_array_push_back(ready_queue, (void *)pcb2)){ //tries to push the process in the back of the queue
-	         
-	                    }
-	                    else{
-	                        dyn_array_destroy(work_queue);
-	                        dyn_array_destroy(int_queue);
-	                        free(pcb2);
-	                        return false;
-	         
-	                    }
-	    
-	                }  
-	                free(pcb2);
-	                pcb2 = NULL;
-	            }
-	    }
-	    else{
-	        
-	        done = true;
-	        
-	    }
-	    
-	    
-	  }
-	}
-	
-	//Figure out the results
-	
-	result->average_waiting_time = (float)totalWaitingTime/numPCB;
-	result->average_turnaround_time = (float)totalTurnAroundTime/numPCB;
-	
-	dyn_array_destroy(work_queue);
-    dyn_array_destroy(int_queue);
-	
-	return true;
-	
-	
-	                               
-	
+	policy->quantum = quantum;
+	policy->globalPass = 0;
+	return ready_heap_init(&policy->ready, capacity);
 }
 
-
-
-// Reads the PCB burst time values from the binary file into ProcessControlBlock_t remaining_burst_time field
-// for N number of PCB burst time stored in the file.
-// \param input_file the file containing the PCB burst times
-// \return a populated dyn_array of ProcessControlBlocks if function ran successful else NULL for an error
-dyn_array_t *load_process_control_blocks(const char *input_file) 
+// Runs stride scheduling
+// \param pcbs the pcbs to schedule, left untouched
+// \param order the arrival order of the pcbs to run, see arrival_order
+// \param numPCBs number of pcbs in order, at least one
+// \param params the quantum, a size_t, at least one
+// \param totals receives the statistics
+// \return true if function ran successful else false for an error
+static bool run_stride(const ProcessControlBlock_t *pcbs, const size_t *order, size_t numPCBs, const void *params, ScheduleTotals_t *totals)
 {
-	if (input_file == NULL) // check for invalid parameters
+	StridePolicy_t policy;
+
+	if (stride_init(&policy, *(const size_t *)params, numPCBs) == false)
 	{
-		return NULL;
+		return false;
 	}
 
-	FILE* fptr = fopen(input_file, "rb"); // opening file given to function
-
-	if (fptr == NULL) // if opening the file fails
+	bool success = schedule_policy_run(pcbs, order, numPCBs, 1, &stride_ops, &policy, totals);
+	ready_heap_destroy(&policy.ready);
+	return success;
+}
 
+// Runs the Stride Scheduling algorithm over the incoming ready_queue
+// \param ready queue a dyn_array of type ProcessControlBlock_t that contain be up to N elements
+// \param result used for stride scheduling stat tracking \ref ScheduleResult_t
+// \param quantum the time slice
+// \param columns receives per-pcb results in the arrays it points to \ref ScheduleColumns_t, NULL for none
+// \return true if function ran successful else false for an error
+bool stride_scheduling(dyn_array_t *ready_queue, ScheduleResult_t *result, size_t quantum, const ScheduleColumns_t *columns)
+{
+	if (quantum == 0) // a zero quantum would never make progress
 	{
-		return NULL; // load_process_control_blocks fails and returns NULL
+		return false;
 	}
 
-	uint32_t numPCBs;
+	return run_and_drain(ready_queue, result, run_stride, &quantum, columns);
+}
+
+// Frees a policy made by schedule_policy_stride
+static void stride_free(void *state)
+{
+	ready_heap_destroy(&((StridePolicy_t *)state)->ready);
+	free(state);
+}
 
-	if (fread(&numPCBs, sizeof(uint32_t), 1, fptr) == 1) // if the read of the first uint32 was successful we have the number of processes
+// Builds stride scheduling, for running it incrementally (see schedule_session.h)
+// \param policy receives the ops table, the state and how to free it \ref SchedulePolicy_t
+// \param quantum the time slice, not 0
+// \return true if function ran successful else false for an error
+bool schedule_policy_stride(SchedulePolicy_t *policy, size_t quantum)
+{
+	StridePolicy_t *state = (StridePolicy_t *)malloc(sizeof(StridePolicy_t));
+
+	if (policy == NULL || state == NULL || quantum == 0 || stride_init(state, quantum, 0) == false) // a zero quantum would never make progress
 	{
+		free(state);
+		return false;
+	}
 
-		dyn_array_t* pcbArray = dyn_array_create(numPCBs, sizeof(ProcessControlBlock_t), NULL); // creating the dyn_array we are about to fill with processes created from the file
+	return policy_built(policy, &stride_ops, state, stride_free, 1);
+}
 
-		if (pcbArray == NULL) // if dyn_array_create fails
-		{
-			fclose(fptr); // close the file
-			return NULL; // load_process_control_blocks fails and returns NULL
-		}
 
-		for (uint32_t i = 0; i < numPCBs; i++) // for the number of processes we think are in the file
-		{
-			ProcessControlBlock_t pcb; // create a new pcb
+// The arrival order the built in engines use, for the policy core
+size_t *schedule_arrival_order(const ProcessControlBlock_t *pcbs, size_t numPCBs)
+{
+	return pcbs ? arrival_order(pcbs, numPCBs) : NULL;
+}
 
-			if (fread(&pcb.remaining_burst_time, sizeof(uint32_t), 1, fptr) == 1 &&
-			fread(&pcb.priority, sizeof(uint32_t), 1, fptr) == 1 &&
-			fread(&pcb.arrival, sizeof(uint32_t), 1, fptr) == 1) // read the data in the pcb struct, if all the reads were successful
-			{
-				if(dyn_array_push_back(pcbArray,&pcb) == false) // try to put the pcb onto the array, if this fails
-				{
-					dyn_array_destroy(pcbArray); // clean up allocations
-					fclose(fptr); // close the file
-					return NULL; // load_process_control_blocks fails and returns NULL
-				}
-			}
-			else // reading in the data to the pcb failed
-			{
-				dyn_array_destroy(pcbArray); // clean up allocations
-				fclose(fptr); // close the file
-				return NULL; // load_process_control_blocks fails and returns NULL
-			}
-		}
+// Runs a policy chosen at runtime over ready_queue and drains it
+// \param ready queue a dyn_array of type ProcessControlBlock_t that contain be up to N elements
+// \param result used for stat tracking \ref ScheduleResult_t
+// \param ops the policy's hooks, on_arrival and select are required
+// \param state passed to every hook
+// \return true if function ran successful else false for an error
+bool schedule_with_policy(dyn_array_t *ready_queue, ScheduleResult_t *result, const SchedulePolicyOps_t *ops, void *state)
+{
+	return schedule_policy_drain(ready_queue, result, ops, state);
+}
 
-		// the following code checks that the file does not data for more than N pcbs
-		uint32_t extraData;
 
-		if (fread(&extraData, sizeof(uint32_t), 1, fptr) == 1)
-		{
-			//binary file contains more data than it should
-			dyn_array_destroy(pcbArray); // clean up allocations
-			fclose(fptr); // close the file
-			return NULL; // load_process_control_blocks fails and returns NULL
-		}
-		
-		fclose(fptr); // close the file
-		return pcbArray; // if we get to here and haven't returned NULL we have successfully populated dyn_array with ProcessControlBlocks
-	}
-	else // reading for N failed
+// Reads N pcb records from the binary file: burst, priority and arrival, then the deadline when withDeadlines is set
+// \param input_file the file containing the PCB burst times
+// \param withDeadlines whether every record has a fourth uint32, the deadline
+// \return a populated dyn_array of ProcessControlBlocks if function ran successful else NULL for an error
+static dyn_array_t *load_pcb_records(const char *input_file, bool withDeadlines)
+{
+	if (input_file == NULL) // check for invalid parameters
 	{
-		fclose(fptr); // close the file
-		return NULL; // load_process_control_blocks fails and returns NULL
+		return NULL;
 	}
+
+	return pcb_file_load(input_file, withDeadlines); // v1 or v2, checks for truncated or extra data
+}
+
+
+// Reads the PCB burst time values from the binary file into ProcessControlBlock_t remaining_burst_time field
+// for N number of PCB burst time stored in the file.
+// \param input_file the file containing the PCB burst times
+// \return a populated dyn_array of ProcessControlBlocks if function ran successful else NULL for an error
+dyn_array_t *load_process_control_blocks(const char *input_file) 
+{
+	return load_pcb_records(input_file, false);
+}
+
+// Reads pcbs from a binary file whose records carry a deadline after the arrival time
+// \param input_file the file containing N and then N (burst, priority, arrival, deadline) records
+// \return a populated dyn_array of ProcessControlBlocks if function ran successful else NULL for an error
+dyn_array_t *load_process_control_blocks_with_deadlines(const char *input_file)
+{
+	return load_pcb_records(input_file, true);
 }
 
 
@@ -723,99 +2071,5 @@ dyn_array_t *load_process_control_blocks(const char *input_file)
 // \return true if function ran successful else false for an error
 bool shortest_remaining_time_first(dyn_array_t *ready_queue, ScheduleResult_t *result) 
 {
-	if(ready_queue == NULL || result == NULL || dyn_array_empty(ready_queue))
-    {
-        return false;
-    }
-
-    if (dyn_array_sort(ready_queue, compareByArrival) == false)
-	{
-		return false;
-	}
-
-	ProcessControlBlock_t* pcb = (ProcessControlBlock_t*)dyn_array_front(ready_queue);
-	if (pcb == NULL)
-	{
-		return false;
-	}
-	
-	//Intialize variables to return to result
-    uint32_t current_time = 0;
-    uint32_t total_waiting_time = 0;
-    uint32_t total_turnaround_time = 0;
-    
-    //Get size of the array and create arrays to keep track of times
-    size_t length = dyn_array_size(ready_queue);
-    
-	uint32_t original_burst_time[length];
-    
-    size_t num_completed = 0;
-    uint32_t waiting_time[length];
-    //get the total time needed to run all processes and the remaining burst time for each process
-    for (size_t i = 0; i < length; i++) 
-    {
-		original_burst_time[i] = pcb[i].remaining_burst_time;
-        result->total_run_time += pcb[i].remaining_burst_time;
-    }
-    
-    
-    
-    //Loop until all processes are completed 
-    while(num_completed < length)
-    {
-		//Reset variables 
-        uint32_t  min_remaining_time = UINT32_MAX;
-        uint32_t shortest_loc = 0;
-        bool shortest_found = false;
-		//Check to see what processes have arrived and aren't finished then which has the least remaining time left
-        for(size_t i = 0; i < length; i++)
-        {
-            if (pcb[i].arrival <= current_time && pcb[i].remaining_burst_time > 0)
-            {
-                if(pcb[i].remaining_burst_time < min_remaining_time)
-                {
-                    min_remaining_time = pcb[i].remaining_burst_time;
-                    shortest_loc = i;
-                    shortest_found = true;
-					
-                }
-                
-            }
-        }
-        
-        //if nothing has arrived advance time
-        if (!shortest_found)
-        {
-            current_time++;
-            continue;
-        }
-        //Start the process if it hasn't started
-        if(!pcb[shortest_loc].started)
-        {
-            pcb[shortest_loc].started = true;
-        }
-		//Advance the waiting time for all processes that have arrived and not finished that don't have the shortest time
-		for (size_t i = 0; i < length; i++)
-        {
-            if (pcb[i].arrival <= current_time && pcb[i].remaining_burst_time > 0 && i != shortest_loc)
-            {
-                waiting_time[i]++;
-            }
-        }
-		
-        pcb[shortest_loc].remaining_burst_time--;
-        current_time++;
-		//If the processes is finished update the number of completed processes and calculate TAT and WT
-        if (pcb[shortest_loc].remaining_burst_time == 0) 
-        {
-            num_completed++;
-			int turnAroundTime = current_time - pcb[shortest_loc].arrival;
-            total_turnaround_time += current_time - pcb[shortest_loc].arrival;
-			total_waiting_time += turnAroundTime - original_burst_time[shortest_loc];
-        }
-    }
-    //Calculate averages and return true
-    result->average_waiting_time = (float)total_waiting_time / length;
-    result->average_turnaround_time = (float)total_turnaround_time / length;
-	return true;
-}
\ No newline at end of file
+	return schedule_and_drain(ready_queue, result, SCHEDULE_SRT, 0);
+}
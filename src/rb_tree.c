@@ -0,0 +1,300 @@
+#include "rb_tree.h"
+
+// same order as the ready heap: key, then rank
+static bool rb_node_before(const RbNode_t *a, const RbNode_t *b)
+{
+	return a->key < b->key || (a->key == b->key && a->rank < b->rank);
+}
+
+static bool rb_is_red(const RbNode_t *node)
+{
+	return node != NULL && node->red;
+}
+
+// points whatever pointed at old (its parent's child link or the root) at replacement
+static void rb_replace_child(RbTree_t *tree, RbNode_t *old, RbNode_t *replacement)
+{
+	if (old->parent == NULL)
+	{
+		tree->root = replacement;
+	}
+	else if (old->parent->left == old)
+	{
+		old->parent->left = replacement;
+	}
+	else
+	{
+		old->parent->right = replacement;
+	}
+	if (replacement != NULL)
+	{
+		replacement->parent = old->parent;
+	}
+}
+
+static void rb_rotate_left(RbTree_t *tree, RbNode_t *node)
+{
+	RbNode_t *pivot = node->right;
+
+	node->right = pivot->left;
+	if (pivot->left != NULL)
+	{
+		pivot->left->parent = node;
+	}
+	rb_replace_child(tree, node, pivot);
+	pivot->left = node;
+	node->parent = pivot;
+}
+
+static void rb_rotate_right(RbTree_t *tree, RbNode_t *node)
+{
+	RbNode_t *pivot = node->left;
+
+	node->left = pivot->right;
+	if (pivot->right != NULL)
+	{
+		pivot->right->parent = node;
+	}
+	rb_replace_child(tree, node, pivot);
+	pivot->right = node;
+	node->parent = pivot;
+}
+
+void rb_tree_init(RbTree_t *const tree)
+{
+	if (tree)
+	{
+		tree->root = tree->leftmost = NULL;
+		tree->size = 0;
+	}
+}
+
+void rb_tree_insert(RbTree_t *const tree, RbNode_t *const node)
+{
+	if (tree == NULL || node == NULL)
+	{
+		return;
+	}
+
+	RbNode_t *parent = NULL;
+	RbNode_t **link = &tree->root;
+	bool leftmost = true;
+
+	while (*link != NULL)
+	{
+		parent = *link;
+		if (rb_node_before(node, parent))
+		{
+			link = &parent->left;
+		}
+		else
+		{
+			link = &parent->right;
+			leftmost = false;
+		}
+	}
+
+	node->parent = parent;
+	node->left = node->right = NULL;
+	node->red = true;
+	*link = node;
+	tree->size++;
+	if (leftmost)
+	{
+		tree->leftmost = node;
+	}
+
+	RbNode_t *current = node;
+	while (rb_is_red(current->parent)) // the parent is red, so it isn't the root and the grandparent exists
+	{
+		RbNode_t *up = current->parent;
+		RbNode_t *grandparent = up->parent;
+
+		if (up == grandparent->left)
+		{
+			RbNode_t *uncle = grandparent->right;
+			if (rb_is_red(uncle)) // recolor and move the problem up
+			{
+				up->red = uncle->red = false;
+				grandparent->red = true;
+				current = grandparent;
+				continue;
+			}
+			if (current == up->right)
+			{
+				rb_rotate_left(tree, up);
+				current = up;
+				up = current->parent;
+			}
+			up->red = false;
+			grandparent->red = true;
+			rb_rotate_right(tree, grandparent);
+		}
+		else
+		{
+			RbNode_t *uncle = grandparent->left;
+			if (rb_is_red(uncle))
+			{
+				up->red = uncle->red = false;
+				grandparent->red = true;
+				current = grandparent;
+				continue;
+			}
+			if (current == up->left)
+			{
+				rb_rotate_right(tree, up);
+				current = up;
+				up = current->parent;
+			}
+			up->red = false;
+			grandparent->red = true;
+			rb_rotate_left(tree, grandparent);
+		}
+	}
+	tree->root->red = false;
+}
+
+void rb_tree_erase(RbTree_t *const tree, RbNode_t *const node)
+{
+	if (tree == NULL || node == NULL)
+	{
+		return;
+	}
+
+	if (tree->leftmost == node) // its successor is its right child's leftmost node, or its parent
+	{
+		RbNode_t *next = node->right;
+		if (next != NULL)
+		{
+			while (next->left != NULL)
+			{
+				next = next->left;
+			}
+		}
+		else
+		{
+			next = node->parent;
+		}
+		tree->leftmost = next;
+	}
+
+	RbNode_t *child;		// the node that moves into the removed position
+	RbNode_t *parent;		// child's parent after the unlink (child may be NULL)
+	bool removedRed;
+
+	if (node->left == NULL || node->right == NULL)
+	{
+		child = node->left ? node->left : node->right;
+		parent = node->parent;
+		removedRed = node->red;
+		rb_replace_child(tree, node, child);
+	}
+	else // two children, splice out the successor and put it in node's place
+	{
+		RbNode_t *successor = node->right;
+		while (successor->left != NULL)
+		{
+			successor = successor->left;
+		}
+
+		child = successor->right;
+		removedRed = successor->red;
+
+		if (successor->parent == node)
+		{
+			parent = successor;
+		}
+		else
+		{
+			parent = successor->parent;
+			rb_replace_child(tree, successor, child);
+			successor->right = node->right;
+			successor->right->parent = successor;
+		}
+
+		rb_replace_child(tree, node, successor);
+		successor->left = node->left;
+		successor->left->parent = successor;
+		successor->red = node->red;
+	}
+
+	tree->size--;
+
+	if (removedRed)
+	{
+		return;
+	}
+
+	while (child != tree->root && !rb_is_red(child)) // child carries an extra black
+	{
+		if (child == parent->left)
+		{
+			RbNode_t *sibling = parent->right;
+			if (rb_is_red(sibling))
+			{
+				sibling->red = false;
+				parent->red = true;
+				rb_rotate_left(tree, parent);
+				sibling = parent->right;
+			}
+			if (!rb_is_red(sibling->left) && !rb_is_red(sibling->right))
+			{
+				sibling->red = true;
+				child = parent;
+				parent = child->parent;
+				continue;
+			}
+			if (!rb_is_red(sibling->right))
+			{
+				sibling->left->red = false;
+				sibling->red = true;
+				rb_rotate_right(tree, sibling);
+				sibling = parent->right;
+			}
+			sibling->red = parent->red;
+			parent->red = false;
+			sibling->right->red = false;
+			rb_rotate_left(tree, parent);
+			child = tree->root;
+		}
+		else
+		{
+			RbNode_t *sibling = parent->left;
+			if (rb_is_red(sibling))
+			{
+				sibling->red = false;
+				parent->red = true;
+				rb_rotate_right(tree, parent);
+				sibling = parent->left;
+			}
+			if (!rb_is_red(sibling->left) && !rb_is_red(sibling->right))
+			{
+				sibling->red = true;
+				child = parent;
+				parent = child->parent;
+				continue;
+			}
+			if (!rb_is_red(sibling->left))
+			{
+				sibling->right->red = false;
+				sibling->red = true;
+				rb_rotate_left(tree, sibling);
+				sibling = parent->left;
+			}
+			sibling->red = parent->red;
+			parent->red = false;
+			sibling->left->red = false;
+			rb_rotate_right(tree, parent);
+			child = tree->root;
+		}
+	}
+	if (child != NULL)
+	{
+		child->red = false;
+	}
+}
+
+RbNode_t *rb_tree_first(const RbTree_t *const tree)
+{
+	return tree ? tree->leftmost : NULL;
+}
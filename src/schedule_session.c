@@ -0,0 +1,269 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "schedule_policy.h"
+#include "schedule_session.h"
+#include "schedule_totals.h"
+
+#define SESSION_EMPTY SIZE_MAX	// id of a free table entry
+
+// A submitted pcb that hasn't finished
+typedef struct
+{
+	size_t id;			// submission order, the id the policy knows it by (arrival, then submission)
+	ProcessControlBlock_t pcb;
+	uint32_t remaining;
+}
+SessionJob_t;
+
+struct schedule_session
+{
+	SchedulePolicy_t policy;
+	SchedulePolicyCore_t core;	// the policy loop's state between advances
+
+	SessionJob_t *jobs;			// open addressing table of the live pcbs, by id
+	size_t mask;				// table size - 1, the size is a power of two
+	unsigned bits;				// log2 of the table size
+	size_t live;
+
+	uint64_t now;
+	uint64_t last_arrival;
+	size_t submitted;			// next id
+	size_t arrived;				// ids below it have been handed to the policy
+
+	ScheduleTotals_t totals;	// its columns are indexed by submission order
+	size_t columns_capacity;	// pcbs the columns have room for
+};
+
+// The slot an id's probe run starts at. Fibonacci hashing: the live ids are a sparse, shifting window of
+// consecutive numbers, which would pile up into long runs under the low bits alone.
+static size_t session_home(const schedule_session_t *session, size_t id)
+{
+	return (size_t)(((uint64_t)id * UINT64_C(0x9E3779B97F4A7C15)) >> (64 - session->bits));
+}
+
+// Finds a live pcb by id, NULL if it isn't one
+static SessionJob_t *session_find(const schedule_session_t *session, size_t id)
+{
+	for (size_t i = session_home(session, id); ; i = (i + 1) & session->mask)
+	{
+		if (session->jobs[i].id == id)
+		{
+			return &session->jobs[i];
+		}
+		if (session->jobs[i].id == SESSION_EMPTY)
+		{
+			return NULL;
+		}
+	}
+}
+
+// Puts a job in the table, which has room for it
+static void session_insert(schedule_session_t *session, const SessionJob_t *job)
+{
+	size_t i = session_home(session, job->id);
+	while (session->jobs[i].id != SESSION_EMPTY)
+	{
+		i = (i + 1) & session->mask;
+	}
+	session->jobs[i] = *job;
+}
+
+// Takes a finished pcb out of the table, moving later entries of its probe run back into the hole
+static void session_remove(schedule_session_t *session, size_t id)
+{
+	size_t hole = (size_t)(session_find(session, id) - session->jobs);
+
+	for (size_t i = (hole + 1) & session->mask; session->jobs[i].id != SESSION_EMPTY; i = (i + 1) & session->mask)
+	{
+		size_t home = session_home(session, session->jobs[i].id);
+		if (((i - home) & session->mask) >= ((i - hole) & session->mask)) // its probe run passes through the hole
+		{
+			session->jobs[hole] = session->jobs[i];
+			hole = i;
+		}
+	}
+	session->jobs[hole].id = SESSION_EMPTY;
+	session->live--;
+}
+
+// Resizes the table to 2^bits entries, more than the live count
+static bool session_resize(schedule_session_t *session, unsigned bits)
+{
+	SessionJob_t *old = session->jobs;
+	size_t oldSize = old != NULL ? session->mask + 1 : 0;
+	size_t size = (size_t)1 << bits;
+	SessionJob_t *jobs = (SessionJob_t *)malloc(size * sizeof(SessionJob_t));
+
+	if (jobs == NULL)
+	{
+		return false;
+	}
+
+	for (size_t i = 0; i < size; i++)
+	{
+		jobs[i].id = SESSION_EMPTY;
+	}
+	session->jobs = jobs;
+	session->mask = size - 1;
+	session->bits = bits;
+
+	for (size_t i = 0; i < oldSize; i++)
+	{
+		if (old[i].id != SESSION_EMPTY)
+		{
+			session_insert(session, &old[i]);
+		}
+	}
+	free(old);
+	return true;
+}
+
+schedule_session_t *schedule_session_create(ScheduleAlgorithm_t algorithm, size_t quantum)
+{
+	SchedulePolicy_t policy;
+	if (schedule_policy_algorithm(&policy, algorithm, quantum) == false)
+	{
+		return NULL;
+	}
+	return schedule_session_create_policy(&policy);
+}
+
+schedule_session_t *schedule_session_create_policy(const SchedulePolicy_t *policy)
+{
+	if (policy == NULL)
+	{
+		return NULL;
+	}
+
+	SchedulePolicy_t owned = *policy;
+	schedule_session_t *session = NULL;
+
+	if (owned.ops != NULL && owned.ops->on_arrival != NULL && owned.ops->select != NULL)
+	{
+		session = (schedule_session_t *)calloc(1, sizeof(schedule_session_t));
+	}
+	if (session == NULL)
+	{
+		schedule_policy_destroy(&owned);
+		return NULL;
+	}
+
+	session->policy = owned;
+	if (schedule_policy_core_init(&session->core, owned.cpus) == false || session_resize(session, 4) == false)
+	{
+		schedule_session_destroy(session);
+		return NULL;
+	}
+	return session;
+}
+
+bool schedule_session_submit(schedule_session_t *const session, const ProcessControlBlock_t *const pcb)
+{
+	if (session == NULL || pcb == NULL || pcb->arrival < session->now || pcb->arrival < session->last_arrival ||
+		(session->totals.columns != NULL && session->submitted >= session->columns_capacity)) // no room left in the columns
+	{
+		return false;
+	}
+
+	if (2 * (session->live + 1) > session->mask + 1 && session_resize(session, session->bits + 1) == false) // keep the table at most half full
+	{
+		return false;
+	}
+
+	SessionJob_t job = {.id = session->submitted++, .pcb = *pcb, .remaining = pcb->remaining_burst_time};
+	session_insert(session, &job);
+	session->last_arrival = pcb->arrival;
+	session->live++;
+	return true;
+}
+
+bool schedule_session_columns(schedule_session_t *const session, const ScheduleColumns_t *columns, size_t capacity)
+{
+	if (session == NULL || session->submitted > 0) // the columns are indexed from the first submission
+	{
+		return false;
+	}
+
+	totals_columns_begin(&session->totals, columns, NULL, capacity);
+	session->columns_capacity = capacity;
+	return true;
+}
+
+bool schedule_session_advance(schedule_session_t *const session, const uint64_t time)
+{
+	if (session == NULL || time < session->now)
+	{
+		return false;
+	}
+	if (time == session->now) // the events at now belong to the next advance, more pcbs may still arrive at now
+	{
+		return true;
+	}
+
+	// The policy loop over the submitted pcbs, stopping before time: events at time itself wait, more pcbs may still arrive then
+	const SchedulePolicyOps_t *ops = session->policy.ops;
+	void *state = session->policy.state;
+	SchedulePolicyCore_t *core = &session->core;
+	ScheduleTotals_t *totals = &session->totals;
+	uint64_t until = time;
+	bool success;
+
+#define SCHEDULE_POLICY_ON_ARRIVAL(pcb, id, remaining, now, from) ops->on_arrival(state, pcb, id, remaining, now, from)
+#define SCHEDULE_POLICY_SELECT(cpu, now, id, slice) ops->select(state, cpu, now, id, slice)
+#define SCHEDULE_POLICY_PREEMPT(cpu, running, remaining, now, slice) ops->preempt(state, cpu, running, remaining, now, slice)
+#define SCHEDULE_POLICY_ON_COMPLETE(cpu, id, now) ops->on_complete(state, cpu, id, now)
+#define SCHEDULE_POLICY_HAS_PREEMPT (ops->preempt != NULL)
+#define SCHEDULE_POLICY_HAS_ON_COMPLETE (ops->on_complete != NULL)
+#define SCHEDULE_POLICY_NEXT_ARRIVAL (session->arrived < session->submitted ? (uint64_t)session_find(session, session->arrived)->pcb.arrival : UINT64_MAX)
+#define SCHEDULE_POLICY_ARRIVE(id) ((id) = session->arrived++)
+#define SCHEDULE_POLICY_PCB(id) (&session_find(session, id)->pcb)
+#define SCHEDULE_POLICY_REMAINING(id) session_find(session, id)->remaining
+#define SCHEDULE_POLICY_COLUMN(id) (id)
+#define SCHEDULE_POLICY_LIVE(id) ((id) < session->arrived && session_find(session, id) != NULL)
+#define SCHEDULE_POLICY_FINISHED(id) session_remove(session, id)
+#include "schedule_policy_loop.h"
+
+	if (success == false)
+	{
+		return false;
+	}
+
+	session->now = time;
+	return true;
+}
+
+bool schedule_session_snapshot(const schedule_session_t *const session, ScheduleResult_t *const result)
+{
+	if (session == NULL || result == NULL)
+	{
+		return false;
+	}
+
+	if (session->totals.completed == 0)
+	{
+		memset(result, 0, sizeof(ScheduleResult_t));
+		return true;
+	}
+
+	totals_to_result(&session->totals, result);
+	return true;
+}
+
+size_t schedule_session_live(const schedule_session_t *const session)
+{
+	return session ? session->live : 0;
+}
+
+void schedule_session_destroy(schedule_session_t *const session)
+{
+	if (session == NULL)
+	{
+		return;
+	}
+
+	schedule_policy_destroy(&session->policy);
+	schedule_policy_core_destroy(&session->core);
+	free(session->jobs);
+	free(session);
+}
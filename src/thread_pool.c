@@ -0,0 +1,204 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "thread_pool.h"
+
+struct thread_pool
+{
+	size_t num_threads;		// including the caller of thread_pool_run
+	pthread_t *workers;		// num_threads - 1 of them
+	size_t num_workers;		// how many actually started
+
+	pthread_mutex_t lock;
+	pthread_cond_t work_ready;	// a batch was posted (or the pool is shutting down)
+	pthread_cond_t work_done;	// the last worker left the batch
+
+	// the current batch, guarded by lock except for next_index
+	void (*task)(void *, size_t);
+	void *arg;
+	size_t count;
+	atomic_size_t next_index;
+	unsigned long generation;	// bumped per batch so workers don't run one twice
+	size_t busy_workers;
+	bool shutting_down;
+};
+
+// claims indices of the current batch until there are none left
+static void thread_pool_drain(thread_pool_t *pool, void (*task)(void *, size_t), void *arg, size_t count)
+{
+	size_t i;
+	while ((i = atomic_fetch_add(&pool->next_index, 1)) < count)
+	{
+		task(arg, i);
+	}
+}
+
+static void *thread_pool_worker(void *param)
+{
+	thread_pool_t *pool = (thread_pool_t *)param;
+	unsigned long seen = 0;
+
+	pthread_mutex_lock(&pool->lock);
+	for (;;)
+	{
+		while (!pool->shutting_down && pool->generation == seen)
+		{
+			pthread_cond_wait(&pool->work_ready, &pool->lock);
+		}
+		if (pool->shutting_down)
+		{
+			break;
+		}
+
+		seen = pool->generation;
+		void (*task)(void *, size_t) = pool->task;
+		void *arg = pool->arg;
+		size_t count = pool->count;
+		pthread_mutex_unlock(&pool->lock);
+
+		thread_pool_drain(pool, task, arg, count);
+
+		pthread_mutex_lock(&pool->lock);
+		if (--pool->busy_workers == 0)
+		{
+			pthread_cond_signal(&pool->work_done);
+		}
+	}
+	pthread_mutex_unlock(&pool->lock);
+
+	return NULL;
+}
+
+size_t thread_pool_default_threads(void)
+{
+	long online = sysconf(_SC_NPROCESSORS_ONLN);
+	return online > 0 ? (size_t)online : 1;
+}
+
+thread_pool_t *thread_pool_create(size_t num_threads)
+{
+	if (num_threads == 0)
+	{
+		num_threads = thread_pool_default_threads();
+	}
+
+	thread_pool_t *pool = (thread_pool_t *)calloc(1, sizeof(thread_pool_t));
+	if (pool == NULL)
+	{
+		return NULL;
+	}
+
+	pool->num_threads = num_threads;
+	atomic_init(&pool->next_index, 0);
+
+	if (pthread_mutex_init(&pool->lock, NULL) != 0)
+	{
+		free(pool);
+		return NULL;
+	}
+	if (pthread_cond_init(&pool->work_ready, NULL) != 0)
+	{
+		pthread_mutex_destroy(&pool->lock);
+		free(pool);
+		return NULL;
+	}
+	if (pthread_cond_init(&pool->work_done, NULL) != 0)
+	{
+		pthread_cond_destroy(&pool->work_ready);
+		pthread_mutex_destroy(&pool->lock);
+		free(pool);
+		return NULL;
+	}
+
+	if (num_threads > 1)
+	{
+		pool->workers = (pthread_t *)malloc((num_threads - 1) * sizeof(pthread_t));
+		if (pool->workers == NULL)
+		{
+			thread_pool_destroy(pool);
+			return NULL;
+		}
+
+		for (; pool->num_workers < num_threads - 1; pool->num_workers++)
+		{
+			if (pthread_create(&pool->workers[pool->num_workers], NULL, thread_pool_worker, pool) != 0)
+			{
+				thread_pool_destroy(pool);
+				return NULL;
+			}
+		}
+	}
+
+	return pool;
+}
+
+size_t thread_pool_size(const thread_pool_t *const pool)
+{
+	return pool ? pool->num_threads : 0;
+}
+
+bool thread_pool_run(thread_pool_t *const pool, const size_t count, void (*const task)(void *, size_t), void *arg)
+{
+	if (pool == NULL || task == NULL)
+	{
+		return false;
+	}
+
+	if (pool->num_workers == 0 || count < 2) // nothing to share, run it here
+	{
+		for (size_t i = 0; i < count; i++)
+		{
+			task(arg, i);
+		}
+		return true;
+	}
+
+	pthread_mutex_lock(&pool->lock);
+	pool->task = task;
+	pool->arg = arg;
+	pool->count = count;
+	atomic_store(&pool->next_index, 0);
+	pool->busy_workers = pool->num_workers;
+	pool->generation++;
+	pthread_cond_broadcast(&pool->work_ready);
+	pthread_mutex_unlock(&pool->lock);
+
+	thread_pool_drain(pool, task, arg, count); // the caller pitches in
+
+	pthread_mutex_lock(&pool->lock);
+	while (pool->busy_workers > 0)
+	{
+		pthread_cond_wait(&pool->work_done, &pool->lock);
+	}
+	pthread_mutex_unlock(&pool->lock);
+
+	return true;
+}
+
+void thread_pool_destroy(thread_pool_t *const pool)
+{
+	if (pool == NULL)
+	{
+		return;
+	}
+
+	pthread_mutex_lock(&pool->lock);
+	pool->shutting_down = true;
+	pthread_cond_broadcast(&pool->work_ready);
+	pthread_mutex_unlock(&pool->lock);
+
+	for (size_t i = 0; i < pool->num_workers; i++)
+	{
+		pthread_join(pool->workers[i], NULL);
+	}
+
+	pthread_cond_destroy(&pool->work_done);
+	pthread_cond_destroy(&pool->work_ready);
+	pthread_mutex_destroy(&pool->lock);
+	free(pool->workers);
+	free(pool);
+}
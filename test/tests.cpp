@@ -1,8 +1,23 @@
 #include <fcntl.h>
+#include <unistd.h>
 #include <stdio.h>
 #include <pthread.h>
 #include "gtest/gtest.h"
+#include "../include/latency_histogram.h"
+#include "../include/pcb_file.h"
+#include "../include/pcb_trace.h"
 #include "../include/processing_scheduling.h"
+#include "../include/rb_tree.h"
+#include "../include/schedule_policy.hpp"
+#include "../include/schedule_session.h"
+#include <algorithm>
+#include <climits>
+#include <deque>
+#include <functional>
+#include <queue>
+#include <thread>
+#include <utility>
+#include <vector>
 
 // Using a C library requires extern "C" to prevent function mangling
 extern "C"
@@ -25,7 +40,8 @@ extern "C"
 // if ready_queue == NULL
 TEST (first_come_first_serve, ReadyQueueNULL) 
 {
-	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0};
+	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+		.waiting_latency = {}, .turnaround_latency = {}};
 	EXPECT_EQ(false,first_come_first_serve(NULL, &result));
 
 	EXPECT_EQ(result.total_run_time, 0UL);
@@ -37,9 +53,9 @@ TEST (first_come_first_serve, ReadyQueueNULL)
 // if result == NULL
 TEST (first_come_first_serve, ResultNULL) 
 {
-	ProcessControlBlock_t newPCB1 = {.remaining_burst_time = 5, .priority = 1, .arrival = 0, .started = false};
-	ProcessControlBlock_t newPCB2 = {.remaining_burst_time = 3, .priority = 1, .arrival = 0, .started = false};
-	ProcessControlBlock_t newPCB3 = {.remaining_burst_time = 8, .priority = 1, .arrival = 0, .started = false};
+	ProcessControlBlock_t newPCB1 = {.remaining_burst_time = 5, .priority = 1, .arrival = 0, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB2 = {.remaining_burst_time = 3, .priority = 1, .arrival = 0, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB3 = {.remaining_burst_time = 8, .priority = 1, .arrival = 0, .deadline = 0, .started = false};
 	
 	dyn_array_t* ready_queue = dyn_array_create(3, sizeof(ProcessControlBlock_t), NULL);
 	
@@ -64,7 +80,8 @@ TEST (first_come_first_serve, ZeroSizeArray)
 
 	// Not adding any ProcessControlBlock_t to ready_queue, no processes to schedule
 
-	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0};
+	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+		.waiting_latency = {}, .turnaround_latency = {}};
 	
 	EXPECT_EQ(false,first_come_first_serve(ready_queue, &result));
 
@@ -81,13 +98,14 @@ TEST (first_come_first_serve, ZeroSizeArray)
 
 TEST (first_come_first_serve, OneProcess)
 {
-	ProcessControlBlock_t newPCB1 = {.remaining_burst_time = 5, .priority = 1, .arrival = 0, .started = false};
+	ProcessControlBlock_t newPCB1 = {.remaining_burst_time = 5, .priority = 1, .arrival = 0, .deadline = 0, .started = false};
 	
 	dyn_array_t* ready_queue = dyn_array_create(1, sizeof(ProcessControlBlock_t), NULL);
 	
 	dyn_array_push_back(ready_queue, &newPCB1);
 	
-	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0};
+	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+		.waiting_latency = {}, .turnaround_latency = {}};
 	
 	EXPECT_EQ(true,first_come_first_serve(ready_queue, &result));
 	
@@ -104,9 +122,9 @@ TEST (first_come_first_serve, OneProcess)
 
 TEST (first_come_first_serve, SameArrivalTimes) 
 {
-	ProcessControlBlock_t newPCB1 = {.remaining_burst_time = 5, .priority = 1, .arrival = 0, .started = false};
-	ProcessControlBlock_t newPCB2 = {.remaining_burst_time = 3, .priority = 1, .arrival = 0, .started = false};
-	ProcessControlBlock_t newPCB3 = {.remaining_burst_time = 4, .priority = 1, .arrival = 0, .started = false};
+	ProcessControlBlock_t newPCB1 = {.remaining_burst_time = 5, .priority = 1, .arrival = 0, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB2 = {.remaining_burst_time = 3, .priority = 1, .arrival = 0, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB3 = {.remaining_burst_time = 4, .priority = 1, .arrival = 0, .deadline = 0, .started = false};
 	
 	dyn_array_t* ready_queue = dyn_array_create(3, sizeof(ProcessControlBlock_t), NULL);
 	
@@ -114,7 +132,8 @@ TEST (first_come_first_serve, SameArrivalTimes)
 	dyn_array_push_back(ready_queue, &newPCB2);
 	dyn_array_push_back(ready_queue, &newPCB3);
 	
-	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0};
+	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+		.waiting_latency = {}, .turnaround_latency = {}};
 	
 	EXPECT_EQ(true,first_come_first_serve(ready_queue, &result));
 	
@@ -127,9 +146,9 @@ TEST (first_come_first_serve, SameArrivalTimes)
 
 TEST (first_come_first_serve, DifferentArrivalTimes) 
 {
-	ProcessControlBlock_t newPCB1 = {.remaining_burst_time = 5, .priority = 1, .arrival = 2, .started = false};
-	ProcessControlBlock_t newPCB2 = {.remaining_burst_time = 3, .priority = 1, .arrival = 0, .started = false};
-	ProcessControlBlock_t newPCB3 = {.remaining_burst_time = 4, .priority = 1, .arrival = 4, .started = false};
+	ProcessControlBlock_t newPCB1 = {.remaining_burst_time = 5, .priority = 1, .arrival = 2, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB2 = {.remaining_burst_time = 3, .priority = 1, .arrival = 0, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB3 = {.remaining_burst_time = 4, .priority = 1, .arrival = 4, .deadline = 0, .started = false};
 	
 	dyn_array_t* ready_queue = dyn_array_create(3, sizeof(ProcessControlBlock_t), NULL);
 	
@@ -137,7 +156,8 @@ TEST (first_come_first_serve, DifferentArrivalTimes)
 	dyn_array_push_back(ready_queue, &newPCB2);
 	dyn_array_push_back(ready_queue, &newPCB3);
 	
-	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0};
+	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+		.waiting_latency = {}, .turnaround_latency = {}};
 	
 	EXPECT_EQ(true,first_come_first_serve(ready_queue, &result));
 	
@@ -150,9 +170,9 @@ TEST (first_come_first_serve, DifferentArrivalTimes)
 
 TEST (first_come_first_serve, ProcessArrivesRightAfterPreviousCompletes) 
 {
-	ProcessControlBlock_t newPCB1 = {.remaining_burst_time = 5, .priority = 1, .arrival = 0, .started = false};
-	ProcessControlBlock_t newPCB2 = {.remaining_burst_time = 3, .priority = 1, .arrival = 5, .started = false};
-	ProcessControlBlock_t newPCB3 = {.remaining_burst_time = 4, .priority = 1, .arrival = 8, .started = false};
+	ProcessControlBlock_t newPCB1 = {.remaining_burst_time = 5, .priority = 1, .arrival = 0, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB2 = {.remaining_burst_time = 3, .priority = 1, .arrival = 5, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB3 = {.remaining_burst_time = 4, .priority = 1, .arrival = 8, .deadline = 0, .started = false};
 	
 	dyn_array_t* ready_queue = dyn_array_create(3, sizeof(ProcessControlBlock_t), NULL);
 	
@@ -160,7 +180,8 @@ TEST (first_come_first_serve, ProcessArrivesRightAfterPreviousCompletes)
 	dyn_array_push_back(ready_queue, &newPCB2);
 	dyn_array_push_back(ready_queue, &newPCB3);
 	
-	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0};
+	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+		.waiting_latency = {}, .turnaround_latency = {}};
 	
 	EXPECT_EQ(true,first_come_first_serve(ready_queue, &result));
 	
@@ -173,9 +194,9 @@ TEST (first_come_first_serve, ProcessArrivesRightAfterPreviousCompletes)
 
 TEST (first_come_first_serve, GapsInArrivalTimes) 
 {
-	ProcessControlBlock_t newPCB1 = {.remaining_burst_time = 5, .priority = 1, .arrival = 0, .started = false};
-	ProcessControlBlock_t newPCB2 = {.remaining_burst_time = 3, .priority = 1, .arrival = 8, .started = false};
-	ProcessControlBlock_t newPCB3 = {.remaining_burst_time = 4, .priority = 1, .arrival = 20, .started = false};
+	ProcessControlBlock_t newPCB1 = {.remaining_burst_time = 5, .priority = 1, .arrival = 0, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB2 = {.remaining_burst_time = 3, .priority = 1, .arrival = 8, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB3 = {.remaining_burst_time = 4, .priority = 1, .arrival = 20, .deadline = 0, .started = false};
 	
 	dyn_array_t* ready_queue = dyn_array_create(3, sizeof(ProcessControlBlock_t), NULL);
 	
@@ -183,7 +204,8 @@ TEST (first_come_first_serve, GapsInArrivalTimes)
 	dyn_array_push_back(ready_queue, &newPCB2);
 	dyn_array_push_back(ready_queue, &newPCB3);
 	
-	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0};
+	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+		.waiting_latency = {}, .turnaround_latency = {}};
 	
 	EXPECT_EQ(true,first_come_first_serve(ready_queue, &result));
 	
@@ -196,9 +218,9 @@ TEST (first_come_first_serve, GapsInArrivalTimes)
 
 TEST (first_come_first_serve, NoProcessArrivesAtZero) 
 {
-	ProcessControlBlock_t newPCB1 = {.remaining_burst_time = 5, .priority = 1, .arrival = 2, .started = false};
-	ProcessControlBlock_t newPCB2 = {.remaining_burst_time = 3, .priority = 1, .arrival = 4, .started = false};
-	ProcessControlBlock_t newPCB3 = {.remaining_burst_time = 4, .priority = 1, .arrival = 6, .started = false};
+	ProcessControlBlock_t newPCB1 = {.remaining_burst_time = 5, .priority = 1, .arrival = 2, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB2 = {.remaining_burst_time = 3, .priority = 1, .arrival = 4, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB3 = {.remaining_burst_time = 4, .priority = 1, .arrival = 6, .deadline = 0, .started = false};
 	
 	dyn_array_t* ready_queue = dyn_array_create(3, sizeof(ProcessControlBlock_t), NULL);
 	
@@ -206,7 +228,8 @@ TEST (first_come_first_serve, NoProcessArrivesAtZero)
 	dyn_array_push_back(ready_queue, &newPCB2);
 	dyn_array_push_back(ready_queue, &newPCB3);
 	
-	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0};
+	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+		.waiting_latency = {}, .turnaround_latency = {}};
 	
 	EXPECT_EQ(true,first_come_first_serve(ready_queue, &result));
 	
@@ -223,9 +246,9 @@ TEST (first_come_first_serve, NoProcessArrivesAtZero)
 
 TEST (first_come_first_serve, ProcessesWithZeroBurstTime)
 {
-	ProcessControlBlock_t newPCB1 = {.remaining_burst_time = 0, .priority = 1, .arrival = 0, .started = false};
-	ProcessControlBlock_t newPCB2 = {.remaining_burst_time = 0, .priority = 1, .arrival = 1, .started = false};
-	ProcessControlBlock_t newPCB3 = {.remaining_burst_time = 0, .priority = 1, .arrival = 2, .started = false};
+	ProcessControlBlock_t newPCB1 = {.remaining_burst_time = 0, .priority = 1, .arrival = 0, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB2 = {.remaining_burst_time = 0, .priority = 1, .arrival = 1, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB3 = {.remaining_burst_time = 0, .priority = 1, .arrival = 2, .deadline = 0, .started = false};
 	
 	dyn_array_t* ready_queue = dyn_array_create(3, sizeof(ProcessControlBlock_t), NULL);
 	
@@ -233,7 +256,8 @@ TEST (first_come_first_serve, ProcessesWithZeroBurstTime)
 	dyn_array_push_back(ready_queue, &newPCB2);
 	dyn_array_push_back(ready_queue, &newPCB3);
 	
-	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0};
+	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+		.waiting_latency = {}, .turnaround_latency = {}};
 	
 	EXPECT_EQ(true,first_come_first_serve(ready_queue, &result));
 	
@@ -250,9 +274,9 @@ TEST (first_come_first_serve, ProcessesWithZeroBurstTime)
 
 TEST (first_come_first_serve, IgnoringDifferentPriorities) 
 {
-	ProcessControlBlock_t newPCB1 = {.remaining_burst_time = 5, .priority = 1, .arrival = 0, .started = false};
-	ProcessControlBlock_t newPCB2 = {.remaining_burst_time = 3, .priority = 2, .arrival = 1, .started = false};
-	ProcessControlBlock_t newPCB3 = {.remaining_burst_time = 4, .priority = 3, .arrival = 2, .started = false};
+	ProcessControlBlock_t newPCB1 = {.remaining_burst_time = 5, .priority = 1, .arrival = 0, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB2 = {.remaining_burst_time = 3, .priority = 2, .arrival = 1, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB3 = {.remaining_burst_time = 4, .priority = 3, .arrival = 2, .deadline = 0, .started = false};
 	
 	dyn_array_t* ready_queue = dyn_array_create(3, sizeof(ProcessControlBlock_t), NULL);
 	
@@ -260,7 +284,8 @@ TEST (first_come_first_serve, IgnoringDifferentPriorities)
 	dyn_array_push_back(ready_queue, &newPCB2);
 	dyn_array_push_back(ready_queue, &newPCB3);
 	
-	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0};
+	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+		.waiting_latency = {}, .turnaround_latency = {}};
 	
 	EXPECT_EQ(true,first_come_first_serve(ready_queue, &result));
 	
@@ -271,6 +296,172 @@ TEST (first_come_first_serve, IgnoringDifferentPriorities)
 	dyn_array_destroy(ready_queue);
 }
 
+/*
+*  Tests related to huge burst times -- the clock has to jump rather than tick
+**/
+
+TEST (first_come_first_serve, HugeBurstTimes)
+{
+	ProcessControlBlock_t newPCB1 = {.remaining_burst_time = 4000000000, .priority = 1, .arrival = 0, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB2 = {.remaining_burst_time = 4000000000, .priority = 1, .arrival = 10, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB3 = {.remaining_burst_time = 5, .priority = 1, .arrival = 20, .deadline = 0, .started = false};
+	
+	dyn_array_t* ready_queue = dyn_array_create(3, sizeof(ProcessControlBlock_t), NULL);
+	
+	dyn_array_push_back(ready_queue, &newPCB1);
+	dyn_array_push_back(ready_queue, &newPCB2);
+	dyn_array_push_back(ready_queue, &newPCB3);
+	
+	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+		.waiting_latency = {}, .turnaround_latency = {}};
+	
+	EXPECT_EQ(true,first_come_first_serve(ready_queue, &result));
+	
+	EXPECT_EQ(result.total_run_time, 8000000005UL);
+	EXPECT_NEAR(result.average_waiting_time, 3999999990.0, 1000.0);
+	EXPECT_NEAR(result.average_turnaround_time, 6666666658.33, 1000.0);
+	
+	dyn_array_destroy(ready_queue);
+}
+
+
+/*
+*  Parallel FCFS UNIT TEST CASES
+**/
+
+// Builds a ready_queue of numPCBs pseudo-random pcbs (same seed, same trace) with bursts in [0, maxBurst)
+// and gaps between consecutive arrivals in [0, maxGap), shuffled out of arrival order
+static dyn_array_t *random_ready_queue(uint32_t numPCBs, uint32_t seed, uint32_t maxBurst, uint32_t maxGap)
+{
+	dyn_array_t* ready_queue = dyn_array_create(numPCBs, sizeof(ProcessControlBlock_t), NULL);
+	uint64_t state = seed;
+	uint32_t arrival = 0;
+
+	for (uint32_t i = 0; i < numPCBs; i++)
+	{
+		state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+		uint32_t burst = (uint32_t)(state >> 33) % maxBurst;
+		state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+		arrival += (uint32_t)(state >> 33) % maxGap;
+		state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+		uint32_t priority = (uint32_t)(state >> 33) % 16;
+
+		ProcessControlBlock_t newPCB = {.remaining_burst_time = burst, .priority = priority, .arrival = arrival, .deadline = 0, .started = false};
+		dyn_array_push_back(ready_queue, &newPCB);
+	}
+
+	for (uint32_t i = numPCBs - 1; i > 0; i--) // shuffle so the schedulers have to sort
+	{
+		state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+		uint32_t j = (uint32_t)(state >> 33) % (i + 1);
+		ProcessControlBlock_t *a = (ProcessControlBlock_t *)dyn_array_at(ready_queue, i);
+		ProcessControlBlock_t *b = (ProcessControlBlock_t *)dyn_array_at(ready_queue, j);
+		ProcessControlBlock_t swap = *a;
+		*a = *b;
+		*b = swap;
+	}
+
+	return ready_queue;
+}
+
+// Copies the pcbs out of a ready_queue, the engines drain it
+static std::vector<ProcessControlBlock_t> pcbs_of(const dyn_array_t *ready_queue)
+{
+	const ProcessControlBlock_t *pcbs = (const ProcessControlBlock_t *)dyn_array_export(ready_queue);
+	return std::vector<ProcessControlBlock_t>(pcbs, pcbs + dyn_array_size(ready_queue));
+}
+
+// Indices of pcbs in arrival order, ties in file order: the ranks the engines break ties with
+static std::vector<size_t> arrival_ranks(const std::vector<ProcessControlBlock_t> &pcbs)
+{
+	std::vector<size_t> order(pcbs.size());
+	for (size_t i = 0; i < order.size(); i++)
+	{
+		order[i] = i;
+	}
+	std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) { return pcbs[a].arrival < pcbs[b].arrival; });
+	return order;
+}
+
+// Checks an engine's run against the completion times a reference worked out, per pcb and in the averages
+static void expect_completions(const std::vector<ProcessControlBlock_t> &pcbs, const std::vector<uint64_t> &expected,
+	const uint64_t *completion, const ScheduleResult_t &result)
+{
+	double waiting = 0, turnaround = 0;
+	for (size_t i = 0; i < pcbs.size(); i++)
+	{
+		EXPECT_EQ(expected[i], completion[i]) << "pcb " << i;
+		turnaround += expected[i] - pcbs[i].arrival;
+		waiting += expected[i] - pcbs[i].arrival - pcbs[i].remaining_burst_time;
+	}
+	EXPECT_FLOAT_EQ((float)(waiting / pcbs.size()), result.average_waiting_time);
+	EXPECT_FLOAT_EQ((float)(turnaround / pcbs.size()), result.average_turnaround_time);
+}
+
+TEST (first_come_first_serve_parallel, NULLParams)
+{
+	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+		.waiting_latency = {}, .turnaround_latency = {}};
+	EXPECT_EQ(false, first_come_first_serve_parallel(NULL, &result, 4));
+
+	dyn_array_t* ready_queue = random_ready_queue(3, 1, 10, 5);
+	EXPECT_EQ(false, first_come_first_serve_parallel(ready_queue, NULL, 4));
+	dyn_array_destroy(ready_queue);
+
+	ready_queue = dyn_array_create(3, sizeof(ProcessControlBlock_t), NULL);
+	EXPECT_EQ(false, first_come_first_serve_parallel(ready_queue, &result, 4));
+	dyn_array_destroy(ready_queue);
+}
+
+TEST (first_come_first_serve_parallel, MoreThreadsThanProcesses)
+{
+	ProcessControlBlock_t newPCB1 = {.remaining_burst_time = 5, .priority = 1, .arrival = 2, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB2 = {.remaining_burst_time = 3, .priority = 1, .arrival = 0, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB3 = {.remaining_burst_time = 4, .priority = 1, .arrival = 4, .deadline = 0, .started = false};
+	
+	dyn_array_t* ready_queue = dyn_array_create(3, sizeof(ProcessControlBlock_t), NULL);
+	
+	dyn_array_push_back(ready_queue, &newPCB1);
+	dyn_array_push_back(ready_queue, &newPCB2);
+	dyn_array_push_back(ready_queue, &newPCB3);
+	
+	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+		.waiting_latency = {}, .turnaround_latency = {}};
+	
+	EXPECT_EQ(true, first_come_first_serve_parallel(ready_queue, &result, 8));
+	
+	EXPECT_EQ(result.total_run_time, 12UL);
+	EXPECT_NEAR(result.average_waiting_time, 1.67, 0.01);
+	EXPECT_NEAR(result.average_turnaround_time, 5.67, 0.01);
+	
+	dyn_array_destroy(ready_queue);
+}
+
+TEST (first_come_first_serve_parallel, MatchesSequential) // idle gaps and backlogs land in every chunk
+{
+	for (size_t threads = 1; threads <= 8; threads++)
+	{
+		dyn_array_t* sequential_queue = random_ready_queue(200000, 7, 100, 100);
+		dyn_array_t* parallel_queue = random_ready_queue(200000, 7, 100, 100);
+
+		ScheduleResult_t expected = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+			.waiting_latency = {}, .turnaround_latency = {}};
+		ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+			.waiting_latency = {}, .turnaround_latency = {}};
+
+		EXPECT_EQ(true, first_come_first_serve(sequential_queue, &expected));
+		EXPECT_EQ(true, first_come_first_serve_parallel(parallel_queue, &result, threads));
+
+		EXPECT_EQ(expected.total_run_time, result.total_run_time);
+		EXPECT_EQ(expected.average_waiting_time, result.average_waiting_time);
+		EXPECT_EQ(expected.average_turnaround_time, result.average_turnaround_time);
+
+		dyn_array_destroy(sequential_queue);
+		dyn_array_destroy(parallel_queue);
+	}
+}
+
+
 /*
 *  Shortest Job First UNIT TEST CASES
 **/
@@ -282,7 +473,8 @@ TEST (first_come_first_serve, IgnoringDifferentPriorities)
 // if ready_queue == NULL
 TEST (shortest_job_first, ReadyQueueNULL) 
 {
-	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0};
+	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+		.waiting_latency = {}, .turnaround_latency = {}};
 	EXPECT_EQ(false,shortest_job_first(NULL, &result));
 
 	EXPECT_EQ(result.total_run_time, 0UL);
@@ -294,9 +486,9 @@ TEST (shortest_job_first, ReadyQueueNULL)
 // if result == NULL
 TEST (shortest_job_first, ResultNULL) 
 {
-	ProcessControlBlock_t newPCB1 = {.remaining_burst_time = 5, .priority = 1, .arrival = 0, .started = false};
-	ProcessControlBlock_t newPCB2 = {.remaining_burst_time = 3, .priority = 1, .arrival = 0, .started = false};
-	ProcessControlBlock_t newPCB3 = {.remaining_burst_time = 8, .priority = 1, .arrival = 0, .started = false};
+	ProcessControlBlock_t newPCB1 = {.remaining_burst_time = 5, .priority = 1, .arrival = 0, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB2 = {.remaining_burst_time = 3, .priority = 1, .arrival = 0, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB3 = {.remaining_burst_time = 8, .priority = 1, .arrival = 0, .deadline = 0, .started = false};
 	
 	dyn_array_t* ready_queue = dyn_array_create(3, sizeof(ProcessControlBlock_t), NULL);
 	
@@ -321,7 +513,8 @@ TEST (shortest_job_first, ZeroSizeArray)
 
 	// Not adding any ProcessControlBlock_t to ready_queue, no processes to schedule
 
-	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0};
+	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+		.waiting_latency = {}, .turnaround_latency = {}};
 	
 	EXPECT_EQ(false,shortest_job_first(ready_queue, &result));
 
@@ -338,13 +531,14 @@ TEST (shortest_job_first, ZeroSizeArray)
 
 TEST (shortest_job_first, OneProcess) // tests for just one process
 {
-	ProcessControlBlock_t newPCB1 = {.remaining_burst_time = 5, .priority = 1, .arrival = 0, .started = false};
+	ProcessControlBlock_t newPCB1 = {.remaining_burst_time = 5, .priority = 1, .arrival = 0, .deadline = 0, .started = false};
 	
 	dyn_array_t* ready_queue = dyn_array_create(1, sizeof(ProcessControlBlock_t), NULL);
 	
 	dyn_array_push_back(ready_queue, &newPCB1);
 	
-	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0};
+	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+		.waiting_latency = {}, .turnaround_latency = {}};
 	
 	EXPECT_EQ(true,shortest_job_first(ready_queue, &result));
 	
@@ -361,9 +555,9 @@ TEST (shortest_job_first, OneProcess) // tests for just one process
 
 TEST (shortest_job_first, ProcessesWithZeroBurstTime)
 {
-	ProcessControlBlock_t newPCB1 = {.remaining_burst_time = 0, .priority = 1, .arrival = 0, .started = false};
-	ProcessControlBlock_t newPCB2 = {.remaining_burst_time = 0, .priority = 1, .arrival = 1, .started = false};
-	ProcessControlBlock_t newPCB3 = {.remaining_burst_time = 0, .priority = 1, .arrival = 2, .started = false};
+	ProcessControlBlock_t newPCB1 = {.remaining_burst_time = 0, .priority = 1, .arrival = 0, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB2 = {.remaining_burst_time = 0, .priority = 1, .arrival = 1, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB3 = {.remaining_burst_time = 0, .priority = 1, .arrival = 2, .deadline = 0, .started = false};
 	
 	dyn_array_t* ready_queue = dyn_array_create(3, sizeof(ProcessControlBlock_t), NULL);
 	
@@ -371,7 +565,8 @@ TEST (shortest_job_first, ProcessesWithZeroBurstTime)
 	dyn_array_push_back(ready_queue, &newPCB2);
 	dyn_array_push_back(ready_queue, &newPCB3);
 	
-	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0};
+	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+		.waiting_latency = {}, .turnaround_latency = {}};
 	
 	EXPECT_EQ(true,shortest_job_first(ready_queue, &result));
 	
@@ -388,9 +583,9 @@ TEST (shortest_job_first, ProcessesWithZeroBurstTime)
 
 TEST (shortest_job_first, DiffArrivalSamePriority) // should do schedule according to SJF
 {
-	ProcessControlBlock_t newPCB1 = {.remaining_burst_time = 3, .priority = 1, .arrival = 0, .started = false};
-	ProcessControlBlock_t newPCB2 = {.remaining_burst_time = 8, .priority = 1, .arrival = 1, .started = false};
-	ProcessControlBlock_t newPCB3 = {.remaining_burst_time = 5, .priority = 1, .arrival = 2, .started = false};
+	ProcessControlBlock_t newPCB1 = {.remaining_burst_time = 3, .priority = 1, .arrival = 0, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB2 = {.remaining_burst_time = 8, .priority = 1, .arrival = 1, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB3 = {.remaining_burst_time = 5, .priority = 1, .arrival = 2, .deadline = 0, .started = false};
 	
 	dyn_array_t* ready_queue = dyn_array_create(3, sizeof(ProcessControlBlock_t), NULL);
 	
@@ -398,7 +593,8 @@ TEST (shortest_job_first, DiffArrivalSamePriority) // should do schedule accordi
 	dyn_array_push_back(ready_queue, &newPCB2);
 	dyn_array_push_back(ready_queue, &newPCB3);
 	
-	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0};
+	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+		.waiting_latency = {}, .turnaround_latency = {}};
 	
 	EXPECT_EQ(true,shortest_job_first(ready_queue, &result));
 	
@@ -411,9 +607,9 @@ TEST (shortest_job_first, DiffArrivalSamePriority) // should do schedule accordi
 
 TEST (shortest_job_first, SameArrivalDiffPriority) // should do schedule according to SJF
 {
-	ProcessControlBlock_t newPCB1 = {.remaining_burst_time = 3, .priority = 1, .arrival = 0, .started = false};
-	ProcessControlBlock_t newPCB2 = {.remaining_burst_time = 8, .priority = 2, .arrival = 0, .started = false};
-	ProcessControlBlock_t newPCB3 = {.remaining_burst_time = 5, .priority = 3, .arrival = 0, .started = false};
+	ProcessControlBlock_t newPCB1 = {.remaining_burst_time = 3, .priority = 1, .arrival = 0, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB2 = {.remaining_burst_time = 8, .priority = 2, .arrival = 0, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB3 = {.remaining_burst_time = 5, .priority = 3, .arrival = 0, .deadline = 0, .started = false};
 	
 	dyn_array_t* ready_queue = dyn_array_create(3, sizeof(ProcessControlBlock_t), NULL);
 	
@@ -421,7 +617,8 @@ TEST (shortest_job_first, SameArrivalDiffPriority) // should do schedule accordi
 	dyn_array_push_back(ready_queue, &newPCB2);
 	dyn_array_push_back(ready_queue, &newPCB3);
 	
-	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0};
+	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+		.waiting_latency = {}, .turnaround_latency = {}};
 	
 	EXPECT_EQ(true,shortest_job_first(ready_queue, &result));
 	
@@ -434,9 +631,9 @@ TEST (shortest_job_first, SameArrivalDiffPriority) // should do schedule accordi
 
 TEST (shortest_job_first, SameArrivalSamePriority) // should do schedule according to SJF
 {
-	ProcessControlBlock_t newPCB1 = {.remaining_burst_time = 3, .priority = 1, .arrival = 0, .started = false};
-	ProcessControlBlock_t newPCB2 = {.remaining_burst_time = 8, .priority = 1, .arrival = 0, .started = false};
-	ProcessControlBlock_t newPCB3 = {.remaining_burst_time = 5, .priority = 1, .arrival = 0, .started = false};
+	ProcessControlBlock_t newPCB1 = {.remaining_burst_time = 3, .priority = 1, .arrival = 0, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB2 = {.remaining_burst_time = 8, .priority = 1, .arrival = 0, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB3 = {.remaining_burst_time = 5, .priority = 1, .arrival = 0, .deadline = 0, .started = false};
 	
 	dyn_array_t* ready_queue = dyn_array_create(3, sizeof(ProcessControlBlock_t), NULL);
 	
@@ -444,7 +641,8 @@ TEST (shortest_job_first, SameArrivalSamePriority) // should do schedule accordi
 	dyn_array_push_back(ready_queue, &newPCB2);
 	dyn_array_push_back(ready_queue, &newPCB3);
 	
-	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0};
+	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+		.waiting_latency = {}, .turnaround_latency = {}};
 	
 	EXPECT_EQ(true,shortest_job_first(ready_queue, &result));
 	
@@ -457,9 +655,9 @@ TEST (shortest_job_first, SameArrivalSamePriority) // should do schedule accordi
 
 TEST (shortest_job_first, DiffArrivalDiffPriority) // should do schedule according to SJF
 {
-	ProcessControlBlock_t newPCB1 = {.remaining_burst_time = 3, .priority = 1, .arrival = 0, .started = false};
-	ProcessControlBlock_t newPCB2 = {.remaining_burst_time = 8, .priority = 2, .arrival = 1, .started = false};
-	ProcessControlBlock_t newPCB3 = {.remaining_burst_time = 5, .priority = 3, .arrival = 2, .started = false};
+	ProcessControlBlock_t newPCB1 = {.remaining_burst_time = 3, .priority = 1, .arrival = 0, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB2 = {.remaining_burst_time = 8, .priority = 2, .arrival = 1, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB3 = {.remaining_burst_time = 5, .priority = 3, .arrival = 2, .deadline = 0, .started = false};
 	
 	dyn_array_t* ready_queue = dyn_array_create(3, sizeof(ProcessControlBlock_t), NULL);
 	
@@ -467,7 +665,8 @@ TEST (shortest_job_first, DiffArrivalDiffPriority) // should do schedule accordi
 	dyn_array_push_back(ready_queue, &newPCB2);
 	dyn_array_push_back(ready_queue, &newPCB3);
 	
-	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0};
+	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+		.waiting_latency = {}, .turnaround_latency = {}};
 	
 	EXPECT_EQ(true,shortest_job_first(ready_queue, &result));
 	
@@ -480,9 +679,9 @@ TEST (shortest_job_first, DiffArrivalDiffPriority) // should do schedule accordi
 
 TEST (shortest_job_first, GapsInArrivalTimes) 
 {
-	ProcessControlBlock_t newPCB1 = {.remaining_burst_time = 5, .priority = 1, .arrival = 0, .started = false};
-	ProcessControlBlock_t newPCB2 = {.remaining_burst_time = 3, .priority = 1, .arrival = 8, .started = false};
-	ProcessControlBlock_t newPCB3 = {.remaining_burst_time = 4, .priority = 1, .arrival = 20, .started = false};
+	ProcessControlBlock_t newPCB1 = {.remaining_burst_time = 5, .priority = 1, .arrival = 0, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB2 = {.remaining_burst_time = 3, .priority = 1, .arrival = 8, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB3 = {.remaining_burst_time = 4, .priority = 1, .arrival = 20, .deadline = 0, .started = false};
 	
 	dyn_array_t* ready_queue = dyn_array_create(3, sizeof(ProcessControlBlock_t), NULL);
 	
@@ -490,7 +689,8 @@ TEST (shortest_job_first, GapsInArrivalTimes)
 	dyn_array_push_back(ready_queue, &newPCB2);
 	dyn_array_push_back(ready_queue, &newPCB3);
 	
-	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0};
+	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+		.waiting_latency = {}, .turnaround_latency = {}};
 	
 	EXPECT_EQ(true,shortest_job_first(ready_queue, &result));
 	
@@ -503,9 +703,9 @@ TEST (shortest_job_first, GapsInArrivalTimes)
 
 TEST (shortest_job_first, NoProcessArrivesAtZero) 
 {
-	ProcessControlBlock_t newPCB1 = {.remaining_burst_time = 5, .priority = 1, .arrival = 2, .started = false};
-	ProcessControlBlock_t newPCB2 = {.remaining_burst_time = 3, .priority = 1, .arrival = 4, .started = false};
-	ProcessControlBlock_t newPCB3 = {.remaining_burst_time = 4, .priority = 1, .arrival = 6, .started = false};
+	ProcessControlBlock_t newPCB1 = {.remaining_burst_time = 5, .priority = 1, .arrival = 2, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB2 = {.remaining_burst_time = 3, .priority = 1, .arrival = 4, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB3 = {.remaining_burst_time = 4, .priority = 1, .arrival = 6, .deadline = 0, .started = false};
 	
 	dyn_array_t* ready_queue = dyn_array_create(3, sizeof(ProcessControlBlock_t), NULL);
 	
@@ -513,7 +713,8 @@ TEST (shortest_job_first, NoProcessArrivesAtZero)
 	dyn_array_push_back(ready_queue, &newPCB2);
 	dyn_array_push_back(ready_queue, &newPCB3);
 	
-	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0};
+	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+		.waiting_latency = {}, .turnaround_latency = {}};
 	
 	EXPECT_EQ(true,shortest_job_first(ready_queue, &result));
 	
@@ -532,9 +733,9 @@ TEST (shortest_job_first, NoProcessArrivesAtZero)
 
 TEST (shortest_job_first, TiesInBurstTimeSameArrival)
 {
-	ProcessControlBlock_t newPCB1 = {.remaining_burst_time = 4, .priority = 1, .arrival = 0, .started = false};
-	ProcessControlBlock_t newPCB2 = {.remaining_burst_time = 4, .priority = 1, .arrival = 0, .started = false};
-	ProcessControlBlock_t newPCB3 = {.remaining_burst_time = 6, .priority = 1, .arrival = 0, .started = false};
+	ProcessControlBlock_t newPCB1 = {.remaining_burst_time = 4, .priority = 1, .arrival = 0, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB2 = {.remaining_burst_time = 4, .priority = 1, .arrival = 0, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB3 = {.remaining_burst_time = 6, .priority = 1, .arrival = 0, .deadline = 0, .started = false};
 	
 	dyn_array_t* ready_queue = dyn_array_create(10, sizeof(ProcessControlBlock_t), NULL);
 	
@@ -542,7 +743,8 @@ TEST (shortest_job_first, TiesInBurstTimeSameArrival)
 	dyn_array_push_back(ready_queue, &newPCB2);
 	dyn_array_push_back(ready_queue, &newPCB3);
 
-	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0};
+	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+		.waiting_latency = {}, .turnaround_latency = {}};
 	
 	EXPECT_EQ(true,shortest_job_first(ready_queue, &result));
 	
@@ -558,9 +760,9 @@ TEST (shortest_job_first, TiesInBurstTimeSameArrival)
 // small amount of processes
 TEST (shortest_job_first, SJFShort)
 {
-	ProcessControlBlock_t newPCB1 = {.remaining_burst_time = 4, .priority = 2, .arrival = 0, .started = false};
-	ProcessControlBlock_t newPCB2 = {.remaining_burst_time = 6, .priority = 1, .arrival = 1, .started = false};
-	ProcessControlBlock_t newPCB3 = {.remaining_burst_time = 2, .priority = 3, .arrival = 3, .started = false};
+	ProcessControlBlock_t newPCB1 = {.remaining_burst_time = 4, .priority = 2, .arrival = 0, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB2 = {.remaining_burst_time = 6, .priority = 1, .arrival = 1, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB3 = {.remaining_burst_time = 2, .priority = 3, .arrival = 3, .deadline = 0, .started = false};
 	
 	dyn_array_t* ready_queue = dyn_array_create(10, sizeof(ProcessControlBlock_t), NULL);
 	
@@ -568,7 +770,8 @@ TEST (shortest_job_first, SJFShort)
 	dyn_array_push_back(ready_queue, &newPCB2);
 	dyn_array_push_back(ready_queue, &newPCB3);
 
-	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0};
+	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+		.waiting_latency = {}, .turnaround_latency = {}};
 	
 	EXPECT_EQ(true,shortest_job_first(ready_queue, &result));
 	
@@ -583,16 +786,16 @@ TEST (shortest_job_first, SJFShort)
 // tests with more than 3 processes
 TEST (shortest_job_first, SJFLong)
 {
-	ProcessControlBlock_t newPCB1 = {.remaining_burst_time = 4, .priority = 2, .arrival = 0, .started = false};
-	ProcessControlBlock_t newPCB2 = {.remaining_burst_time = 2, .priority = 1, .arrival = 1, .started = false};
-	ProcessControlBlock_t newPCB3 = {.remaining_burst_time = 6, .priority = 3, .arrival = 3, .started = false};
-	ProcessControlBlock_t newPCB4 = {.remaining_burst_time = 5, .priority = 5, .arrival = 5, .started = false};
-	ProcessControlBlock_t newPCB5 = {.remaining_burst_time = 3, .priority = 4, .arrival = 8, .started = false};
-	ProcessControlBlock_t newPCB6 = {.remaining_burst_time = 7, .priority = 7, .arrival = 10, .started = false};
-	ProcessControlBlock_t newPCB7 = {.remaining_burst_time = 9, .priority = 8, .arrival = 2, .started = false};
-	ProcessControlBlock_t newPCB8 = {.remaining_burst_time = 20, .priority = 10, .arrival = 4, .started = false};
-	ProcessControlBlock_t newPCB9 = {.remaining_burst_time = 5, .priority = 3, .arrival = 6, .started = false};
-	ProcessControlBlock_t newPCB10 = {.remaining_burst_time = 2, .priority = 1, .arrival = 20, .started = false};
+	ProcessControlBlock_t newPCB1 = {.remaining_burst_time = 4, .priority = 2, .arrival = 0, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB2 = {.remaining_burst_time = 2, .priority = 1, .arrival = 1, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB3 = {.remaining_burst_time = 6, .priority = 3, .arrival = 3, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB4 = {.remaining_burst_time = 5, .priority = 5, .arrival = 5, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB5 = {.remaining_burst_time = 3, .priority = 4, .arrival = 8, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB6 = {.remaining_burst_time = 7, .priority = 7, .arrival = 10, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB7 = {.remaining_burst_time = 9, .priority = 8, .arrival = 2, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB8 = {.remaining_burst_time = 20, .priority = 10, .arrival = 4, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB9 = {.remaining_burst_time = 5, .priority = 3, .arrival = 6, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB10 = {.remaining_burst_time = 2, .priority = 1, .arrival = 20, .deadline = 0, .started = false};
 	
 	dyn_array_t* ready_queue = dyn_array_create(10, sizeof(ProcessControlBlock_t), NULL);
 	
@@ -607,7 +810,8 @@ TEST (shortest_job_first, SJFLong)
 	dyn_array_push_back(ready_queue, &newPCB9);
 	dyn_array_push_back(ready_queue, &newPCB10);
 
-	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0};
+	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+		.waiting_latency = {}, .turnaround_latency = {}};
 	
 	EXPECT_EQ(true,shortest_job_first(ready_queue, &result));
 	
@@ -619,19 +823,78 @@ TEST (shortest_job_first, SJFLong)
 }
 
 
+/*
+*  Tests related to huge burst times -- the clock has to jump rather than tick
+**/
+
+TEST (shortest_job_first, HugeBurstTimes)
+{
+	ProcessControlBlock_t newPCB1 = {.remaining_burst_time = 4000000000, .priority = 1, .arrival = 0, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB2 = {.remaining_burst_time = 3000000000, .priority = 1, .arrival = 1, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB3 = {.remaining_burst_time = 2, .priority = 1, .arrival = 2, .deadline = 0, .started = false};
+	
+	dyn_array_t* ready_queue = dyn_array_create(3, sizeof(ProcessControlBlock_t), NULL);
+	
+	dyn_array_push_back(ready_queue, &newPCB1);
+	dyn_array_push_back(ready_queue, &newPCB2);
+	dyn_array_push_back(ready_queue, &newPCB3);
+	
+	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+		.waiting_latency = {}, .turnaround_latency = {}};
+	
+	EXPECT_EQ(true,shortest_job_first(ready_queue, &result));
+	
+	EXPECT_EQ(result.total_run_time, 7000000002UL);
+	EXPECT_NEAR(result.average_waiting_time, 2666666666.33, 1000.0);
+	EXPECT_NEAR(result.average_turnaround_time, 5000000000.33, 1000.0);
+	
+	dyn_array_destroy(ready_queue);
+}
+
+
+/*
+*  Tests related to large traces -- picking the next job must not rescan the queue
+**/
+
+TEST (shortest_job_first, ManyProcesses) // bursts n..1 all arriving at 0, so they run shortest first
+{
+	const uint32_t numPCBs = 100000;
+	
+	dyn_array_t* ready_queue = dyn_array_create(numPCBs, sizeof(ProcessControlBlock_t), NULL);
+	
+	for (uint32_t i = 0; i < numPCBs; i++)
+	{
+		ProcessControlBlock_t newPCB = {.remaining_burst_time = numPCBs - i, .priority = 1, .arrival = 0, .deadline = 0, .started = false};
+		dyn_array_push_back(ready_queue, &newPCB);
+	}
+	
+	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+		.waiting_latency = {}, .turnaround_latency = {}};
+	
+	EXPECT_EQ(true,shortest_job_first(ready_queue, &result));
+	
+	EXPECT_EQ(result.total_run_time, 5000050000UL);
+	EXPECT_NEAR(result.average_waiting_time, 1666666666.5, 1000.0);
+	EXPECT_NEAR(result.average_turnaround_time, 1666716667.0, 1000.0);
+	
+	dyn_array_destroy(ready_queue);
+}
+
+
 /*
 * Round Robin UNIT TEST CASES
 */
 //Null Params
 TEST (round_robin, NULLParams)
 {
-    ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0};
+    ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+	.waiting_latency = {}, .turnaround_latency = {}};
     EXPECT_EQ(false, round_robin(NULL, &result, QUANTUM)); //NULL Queue
     
     
     
-    ProcessControlBlock_t newPCB1 = {.remaining_burst_time = 5, .priority = 0, .arrival = 0, .started = false};
-    ProcessControlBlock_t newPCB2 = {.remaining_burst_time = 3, .priority = 0, .arrival = 0, .started = false};
+    ProcessControlBlock_t newPCB1 = {.remaining_burst_time = 5, .priority = 0, .arrival = 0, .deadline = 0, .started = false};
+    ProcessControlBlock_t newPCB2 = {.remaining_burst_time = 3, .priority = 0, .arrival = 0, .deadline = 0, .started = false};
     dyn_array_t* ready_queue = dyn_array_create(2, sizeof(ProcessControlBlock_t), NULL);
     dyn_array_push_back(ready_queue, &newPCB1);
     dyn_array_push_back(ready_queue, &newPCB2);
@@ -645,7 +908,8 @@ TEST (round_robin, NULLParams)
 //Bad Params
 TEST (round_robin, BadParams)
 {
-    ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0};
+    ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+	.waiting_latency = {}, .turnaround_latency = {}};
     
     
     
@@ -667,13 +931,14 @@ TEST (round_robin, BadParams)
 
 TEST (round_robin, OneProcess) // tests for just one process
 {
-	ProcessControlBlock_t newPCB1 = {.remaining_burst_time = 5, .priority = 1, .arrival = 0, .started = false};
+	ProcessControlBlock_t newPCB1 = {.remaining_burst_time = 5, .priority = 1, .arrival = 0, .deadline = 0, .started = false};
 	
 	dyn_array_t* ready_queue = dyn_array_create(1, sizeof(ProcessControlBlock_t), NULL);
 	
 	dyn_array_push_back(ready_queue, &newPCB1);
 	
-	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0};
+	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+		.waiting_latency = {}, .turnaround_latency = {}};
 	
 	EXPECT_EQ(true, round_robin(ready_queue, &result, QUANTUM));
 	
@@ -692,9 +957,9 @@ So processes arriving "in order" or "out of order" shouldn't make a difference
 
 TEST (round_robin, DiffArrivalInOrderSamePriority) // should do schedule according to RR
 {
-	ProcessControlBlock_t newPCB1 = {.remaining_burst_time = 5, .priority = 1, .arrival = 0, .started = false};
-	ProcessControlBlock_t newPCB2 = {.remaining_burst_time = 8, .priority = 1, .arrival = 1, .started = false};
-	ProcessControlBlock_t newPCB3 = {.remaining_burst_time = 3, .priority = 1, .arrival = 2, .started = false};
+	ProcessControlBlock_t newPCB1 = {.remaining_burst_time = 5, .priority = 1, .arrival = 0, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB2 = {.remaining_burst_time = 8, .priority = 1, .arrival = 1, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB3 = {.remaining_burst_time = 3, .priority = 1, .arrival = 2, .deadline = 0, .started = false};
 	
 	dyn_array_t* ready_queue = dyn_array_create(3, sizeof(ProcessControlBlock_t), NULL);
 	
@@ -702,7 +967,8 @@ TEST (round_robin, DiffArrivalInOrderSamePriority) // should do schedule accordi
 	dyn_array_push_back(ready_queue, &newPCB2);
 	dyn_array_push_back(ready_queue, &newPCB3);
 	
-	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0};
+	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+		.waiting_latency = {}, .turnaround_latency = {}};
 	
 	EXPECT_EQ(true, round_robin(ready_queue, &result, QUANTUM));
 	
@@ -715,9 +981,9 @@ TEST (round_robin, DiffArrivalInOrderSamePriority) // should do schedule accordi
 
 TEST (round_robin, DiffArrivalOutOfOrderSamePriority) // should do schedule according to RR
 {
-	ProcessControlBlock_t newPCB1 = {.remaining_burst_time = 5, .priority = 1, .arrival = 1, .started = false};
-	ProcessControlBlock_t newPCB2 = {.remaining_burst_time = 8, .priority = 1, .arrival = 0, .started = false};
-	ProcessControlBlock_t newPCB3 = {.remaining_burst_time = 3, .priority = 1, .arrival = 2, .started = false};
+	ProcessControlBlock_t newPCB1 = {.remaining_burst_time = 5, .priority = 1, .arrival = 1, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB2 = {.remaining_burst_time = 8, .priority = 1, .arrival = 0, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB3 = {.remaining_burst_time = 3, .priority = 1, .arrival = 2, .deadline = 0, .started = false};
 	
 	dyn_array_t* ready_queue = dyn_array_create(3, sizeof(ProcessControlBlock_t), NULL);
 	
@@ -725,7 +991,8 @@ TEST (round_robin, DiffArrivalOutOfOrderSamePriority) // should do schedule acco
 	dyn_array_push_back(ready_queue, &newPCB2);
 	dyn_array_push_back(ready_queue, &newPCB3);
 	
-	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0};
+	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+		.waiting_latency = {}, .turnaround_latency = {}};
 	
 	EXPECT_EQ(true, round_robin(ready_queue, &result, QUANTUM));
 	
@@ -742,9 +1009,9 @@ TEST (round_robin, DiffArrivalOutOfOrderSamePriority) // should do schedule acco
 
 TEST (round_robin, GapsInArrivalTimes) 
 {
-	ProcessControlBlock_t newPCB1 = {.remaining_burst_time = 5, .priority = 1, .arrival = 0, .started = false};
-	ProcessControlBlock_t newPCB2 = {.remaining_burst_time = 6, .priority = 1, .arrival = 8, .started = false};
-	ProcessControlBlock_t newPCB3 = {.remaining_burst_time = 3, .priority = 1, .arrival = 20, .started = false};
+	ProcessControlBlock_t newPCB1 = {.remaining_burst_time = 5, .priority = 1, .arrival = 0, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB2 = {.remaining_burst_time = 6, .priority = 1, .arrival = 8, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB3 = {.remaining_burst_time = 3, .priority = 1, .arrival = 20, .deadline = 0, .started = false};
 	
 	dyn_array_t* ready_queue = dyn_array_create(3, sizeof(ProcessControlBlock_t), NULL);
 	
@@ -752,7 +1019,8 @@ TEST (round_robin, GapsInArrivalTimes)
 	dyn_array_push_back(ready_queue, &newPCB2);
 	dyn_array_push_back(ready_queue, &newPCB3);
 	
-	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0};
+	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+		.waiting_latency = {}, .turnaround_latency = {}};
 	
 	EXPECT_EQ(true,round_robin(ready_queue, &result, QUANTUM));
 	
@@ -765,9 +1033,9 @@ TEST (round_robin, GapsInArrivalTimes)
 
 TEST (round_robin, NoProcessArrivesAtZero) 
 {
-	ProcessControlBlock_t newPCB1 = {.remaining_burst_time = 5, .priority = 1, .arrival = 2, .started = false};
-	ProcessControlBlock_t newPCB2 = {.remaining_burst_time = 6, .priority = 1, .arrival = 4, .started = false};
-	ProcessControlBlock_t newPCB3 = {.remaining_burst_time = 3, .priority = 1, .arrival = 6, .started = false};
+	ProcessControlBlock_t newPCB1 = {.remaining_burst_time = 5, .priority = 1, .arrival = 2, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB2 = {.remaining_burst_time = 6, .priority = 1, .arrival = 4, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB3 = {.remaining_burst_time = 3, .priority = 1, .arrival = 6, .deadline = 0, .started = false};
 	
 	dyn_array_t* ready_queue = dyn_array_create(3, sizeof(ProcessControlBlock_t), NULL);
 	
@@ -775,7 +1043,8 @@ TEST (round_robin, NoProcessArrivesAtZero)
 	dyn_array_push_back(ready_queue, &newPCB2);
 	dyn_array_push_back(ready_queue, &newPCB3);
 	
-	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0};
+	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+		.waiting_latency = {}, .turnaround_latency = {}};
 	
 	EXPECT_EQ(true,round_robin(ready_queue, &result, QUANTUM));
 	
@@ -792,9 +1061,9 @@ TEST (round_robin, NoProcessArrivesAtZero)
 
 TEST (round_robin, SameArrivalDiffPriority) // should do schedule according to RR
 {
-	ProcessControlBlock_t newPCB1 = {.remaining_burst_time = 5, .priority = 1, .arrival = 0, .started = false};
-	ProcessControlBlock_t newPCB2 = {.remaining_burst_time = 8, .priority = 2, .arrival = 0, .started = false};
-	ProcessControlBlock_t newPCB3 = {.remaining_burst_time = 3, .priority = 3, .arrival = 0, .started = false};
+	ProcessControlBlock_t newPCB1 = {.remaining_burst_time = 5, .priority = 1, .arrival = 0, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB2 = {.remaining_burst_time = 8, .priority = 2, .arrival = 0, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB3 = {.remaining_burst_time = 3, .priority = 3, .arrival = 0, .deadline = 0, .started = false};
 	
 	dyn_array_t* ready_queue = dyn_array_create(3, sizeof(ProcessControlBlock_t), NULL);
 	
@@ -802,7 +1071,8 @@ TEST (round_robin, SameArrivalDiffPriority) // should do schedule according to R
 	dyn_array_push_back(ready_queue, &newPCB2);
 	dyn_array_push_back(ready_queue, &newPCB3);
 	
-	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0};
+	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+		.waiting_latency = {}, .turnaround_latency = {}};
 	
 	EXPECT_EQ(true, round_robin(ready_queue, &result, QUANTUM));
 	
@@ -815,9 +1085,9 @@ TEST (round_robin, SameArrivalDiffPriority) // should do schedule according to R
 
 TEST (round_robin, DiffArrivalDiffPriority) // should do schedule according to RR
 {
-	ProcessControlBlock_t newPCB1 = {.remaining_burst_time = 5, .priority = 1, .arrival = 0, .started = false};
-	ProcessControlBlock_t newPCB2 = {.remaining_burst_time = 8, .priority = 2, .arrival = 1, .started = false};
-	ProcessControlBlock_t newPCB3 = {.remaining_burst_time = 3, .priority = 3, .arrival = 2, .started = false};
+	ProcessControlBlock_t newPCB1 = {.remaining_burst_time = 5, .priority = 1, .arrival = 0, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB2 = {.remaining_burst_time = 8, .priority = 2, .arrival = 1, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB3 = {.remaining_burst_time = 3, .priority = 3, .arrival = 2, .deadline = 0, .started = false};
 	
 	dyn_array_t* ready_queue = dyn_array_create(3, sizeof(ProcessControlBlock_t), NULL);
 	
@@ -825,7 +1095,8 @@ TEST (round_robin, DiffArrivalDiffPriority) // should do schedule according to R
 	dyn_array_push_back(ready_queue, &newPCB2);
 	dyn_array_push_back(ready_queue, &newPCB3);
 	
-	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0};
+	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+		.waiting_latency = {}, .turnaround_latency = {}};
 	
 	EXPECT_EQ(true, round_robin(ready_queue, &result, QUANTUM));
 	
@@ -842,9 +1113,9 @@ TEST (round_robin, DiffArrivalDiffPriority) // should do schedule according to R
 
 TEST (round_robin, RRShort)
 {
-	ProcessControlBlock_t newPCB1 = {.remaining_burst_time = 4, .priority = 2, .arrival = 0, .started = false};
-	ProcessControlBlock_t newPCB2 = {.remaining_burst_time = 6, .priority = 1, .arrival = 1, .started = false};
-	ProcessControlBlock_t newPCB3 = {.remaining_burst_time = 2, .priority = 3, .arrival = 3, .started = false};
+	ProcessControlBlock_t newPCB1 = {.remaining_burst_time = 4, .priority = 2, .arrival = 0, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB2 = {.remaining_burst_time = 6, .priority = 1, .arrival = 1, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB3 = {.remaining_burst_time = 2, .priority = 3, .arrival = 3, .deadline = 0, .started = false};
 	
 	dyn_array_t* ready_queue = dyn_array_create(10, sizeof(ProcessControlBlock_t), NULL);
 	
@@ -852,7 +1123,8 @@ TEST (round_robin, RRShort)
 	dyn_array_push_back(ready_queue, &newPCB2);
 	dyn_array_push_back(ready_queue, &newPCB3);
 
-	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0};
+	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+		.waiting_latency = {}, .turnaround_latency = {}};
 	
 	EXPECT_EQ(true, round_robin(ready_queue, &result, QUANTUM));
 	
@@ -870,16 +1142,16 @@ TEST (round_robin, RRShort)
 
 TEST (round_robin, RRLong) // tests with more than 3 processes
 {
-	ProcessControlBlock_t newPCB1 = {.remaining_burst_time = 4, .priority = 2, .arrival = 0, .started = false};
-	ProcessControlBlock_t newPCB2 = {.remaining_burst_time = 2, .priority = 1, .arrival = 1, .started = false};
-	ProcessControlBlock_t newPCB3 = {.remaining_burst_time = 6, .priority = 3, .arrival = 3, .started = false};
-	ProcessControlBlock_t newPCB4 = {.remaining_burst_time = 5, .priority = 5, .arrival = 5, .started = false};
-	ProcessControlBlock_t newPCB5 = {.remaining_burst_time = 3, .priority = 4, .arrival = 8, .started = false};
-	ProcessControlBlock_t newPCB6 = {.remaining_burst_time = 7, .priority = 7, .arrival = 10, .started = false};
-	ProcessControlBlock_t newPCB7 = {.remaining_burst_time = 9, .priority = 8, .arrival = 2, .started = false};
-	ProcessControlBlock_t newPCB8 = {.remaining_burst_time = 20, .priority = 10, .arrival = 4, .started = false};
-	ProcessControlBlock_t newPCB9 = {.remaining_burst_time = 5, .priority = 3, .arrival = 6, .started = false};
-	ProcessControlBlock_t newPCB10 = {.remaining_burst_time = 2, .priority = 1, .arrival = 20, .started = false};
+	ProcessControlBlock_t newPCB1 = {.remaining_burst_time = 4, .priority = 2, .arrival = 0, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB2 = {.remaining_burst_time = 2, .priority = 1, .arrival = 1, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB3 = {.remaining_burst_time = 6, .priority = 3, .arrival = 3, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB4 = {.remaining_burst_time = 5, .priority = 5, .arrival = 5, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB5 = {.remaining_burst_time = 3, .priority = 4, .arrival = 8, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB6 = {.remaining_burst_time = 7, .priority = 7, .arrival = 10, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB7 = {.remaining_burst_time = 9, .priority = 8, .arrival = 2, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB8 = {.remaining_burst_time = 20, .priority = 10, .arrival = 4, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB9 = {.remaining_burst_time = 5, .priority = 3, .arrival = 6, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB10 = {.remaining_burst_time = 2, .priority = 1, .arrival = 20, .deadline = 0, .started = false};
 	
 	dyn_array_t* ready_queue = dyn_array_create(10, sizeof(ProcessControlBlock_t), NULL);
 	
@@ -894,7 +1166,8 @@ TEST (round_robin, RRLong) // tests with more than 3 processes
 	dyn_array_push_back(ready_queue, &newPCB9);
 	dyn_array_push_back(ready_queue, &newPCB10);
 
-	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0};
+	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+		.waiting_latency = {}, .turnaround_latency = {}};
 	
 	EXPECT_EQ(true, round_robin(ready_queue, &result, QUANTUM));
 	
@@ -907,6 +1180,58 @@ TEST (round_robin, RRLong) // tests with more than 3 processes
 
 
 
+/*
+*  Tests related to huge burst times and large traces -- no per-tick work, no per-dispatch allocation
+**/
+
+TEST (round_robin, HugeBurstTimes)
+{
+	ProcessControlBlock_t newPCB1 = {.remaining_burst_time = 4000000000, .priority = 1, .arrival = 0, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB2 = {.remaining_burst_time = 1000000000, .priority = 1, .arrival = 1, .deadline = 0, .started = false};
+	
+	dyn_array_t* ready_queue = dyn_array_create(2, sizeof(ProcessControlBlock_t), NULL);
+	
+	dyn_array_push_back(ready_queue, &newPCB1);
+	dyn_array_push_back(ready_queue, &newPCB2);
+	
+	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+		.waiting_latency = {}, .turnaround_latency = {}};
+	
+	EXPECT_EQ(true, round_robin(ready_queue, &result, 1000000000));
+	
+	EXPECT_EQ(result.total_run_time, 5000000000UL);
+	EXPECT_NEAR(result.average_waiting_time, 999999999.5, 1000.0);
+	EXPECT_NEAR(result.average_turnaround_time, 3499999999.5, 1000.0);
+	
+	dyn_array_destroy(ready_queue);
+}
+
+TEST (round_robin, ManyProcesses) // everyone gets one unit in the first round and finishes in the second
+{
+	const uint32_t numPCBs = 100000;
+	
+	dyn_array_t* ready_queue = dyn_array_create(numPCBs, sizeof(ProcessControlBlock_t), NULL);
+	
+	for (uint32_t i = 0; i < numPCBs; i++)
+	{
+		ProcessControlBlock_t newPCB = {.remaining_burst_time = 2, .priority = 1, .arrival = 0, .deadline = 0, .started = false};
+		dyn_array_push_back(ready_queue, &newPCB);
+	}
+	
+	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+		.waiting_latency = {}, .turnaround_latency = {}};
+	
+	EXPECT_EQ(true, round_robin(ready_queue, &result, 1));
+	
+	EXPECT_EQ(result.total_run_time, 200000UL);
+	EXPECT_NEAR(result.average_waiting_time, 149998.5, 0.01);
+	EXPECT_NEAR(result.average_turnaround_time, 150000.5, 0.01);
+	
+	dyn_array_destroy(ready_queue);
+}
+
+
+
 /*
 *  Priority UNIT TEST CASES
 **/
@@ -918,7 +1243,8 @@ TEST (round_robin, RRLong) // tests with more than 3 processes
 // if ready_queue == NULL
 TEST (priority, ReadyQueueNULL) 
 {
-	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0};
+	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+		.waiting_latency = {}, .turnaround_latency = {}};
 	EXPECT_EQ(false,priority(NULL, &result));
 
 	EXPECT_EQ(result.total_run_time, 0UL);
@@ -930,9 +1256,9 @@ TEST (priority, ReadyQueueNULL)
 // if result == NULL
 TEST (priority, ResultNULL) 
 {
-	ProcessControlBlock_t newPCB1 = {.remaining_burst_time = 5, .priority = 1, .arrival = 0, .started = false};
-	ProcessControlBlock_t newPCB2 = {.remaining_burst_time = 3, .priority = 1, .arrival = 0, .started = false};
-	ProcessControlBlock_t newPCB3 = {.remaining_burst_time = 8, .priority = 1, .arrival = 0, .started = false};
+	ProcessControlBlock_t newPCB1 = {.remaining_burst_time = 5, .priority = 1, .arrival = 0, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB2 = {.remaining_burst_time = 3, .priority = 1, .arrival = 0, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB3 = {.remaining_burst_time = 8, .priority = 1, .arrival = 0, .deadline = 0, .started = false};
 	
 	dyn_array_t* ready_queue = dyn_array_create(3, sizeof(ProcessControlBlock_t), NULL);
 	
@@ -957,7 +1283,8 @@ TEST (priority, ZeroSizeArray)
 
 	// Not adding any ProcessControlBlock_t to ready_queue, no processes to schedule
 
-	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0};
+	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+		.waiting_latency = {}, .turnaround_latency = {}};
 	
 	EXPECT_EQ(false,priority(ready_queue, &result));
 
@@ -974,13 +1301,14 @@ TEST (priority, ZeroSizeArray)
 
 TEST (priority, OneProcess) // tests for just one process
 {
-	ProcessControlBlock_t newPCB1 = {.remaining_burst_time = 5, .priority = 1, .arrival = 0, .started = false};
+	ProcessControlBlock_t newPCB1 = {.remaining_burst_time = 5, .priority = 1, .arrival = 0, .deadline = 0, .started = false};
 	
 	dyn_array_t* ready_queue = dyn_array_create(1, sizeof(ProcessControlBlock_t), NULL);
 	
 	dyn_array_push_back(ready_queue, &newPCB1);
 	
-	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0};
+	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+		.waiting_latency = {}, .turnaround_latency = {}};
 	
 	EXPECT_EQ(true,priority(ready_queue, &result));
 	
@@ -997,9 +1325,9 @@ TEST (priority, OneProcess) // tests for just one process
 
 TEST (priority, ProcessesWithZeroBurstTime)
 {
-	ProcessControlBlock_t newPCB1 = {.remaining_burst_time = 0, .priority = 1, .arrival = 0, .started = false};
-	ProcessControlBlock_t newPCB2 = {.remaining_burst_time = 0, .priority = 1, .arrival = 1, .started = false};
-	ProcessControlBlock_t newPCB3 = {.remaining_burst_time = 0, .priority = 1, .arrival = 2, .started = false};
+	ProcessControlBlock_t newPCB1 = {.remaining_burst_time = 0, .priority = 1, .arrival = 0, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB2 = {.remaining_burst_time = 0, .priority = 1, .arrival = 1, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB3 = {.remaining_burst_time = 0, .priority = 1, .arrival = 2, .deadline = 0, .started = false};
 	
 	dyn_array_t* ready_queue = dyn_array_create(3, sizeof(ProcessControlBlock_t), NULL);
 	
@@ -1007,7 +1335,8 @@ TEST (priority, ProcessesWithZeroBurstTime)
 	dyn_array_push_back(ready_queue, &newPCB2);
 	dyn_array_push_back(ready_queue, &newPCB3);
 	
-	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0};
+	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+		.waiting_latency = {}, .turnaround_latency = {}};
 	
 	EXPECT_EQ(true,priority(ready_queue, &result));
 	
@@ -1026,9 +1355,9 @@ TEST (priority, ProcessesWithZeroBurstTime)
 
 TEST (priority, SamePrioritiesDiffArrival) // basically doing FCFS algorithm
 {
-	ProcessControlBlock_t newPCB1 = {.remaining_burst_time = 5, .priority = 1, .arrival = 0, .started = false};
-	ProcessControlBlock_t newPCB2 = {.remaining_burst_time = 3, .priority = 1, .arrival = 1, .started = false};
-	ProcessControlBlock_t newPCB3 = {.remaining_burst_time = 8, .priority = 1, .arrival = 2, .started = false};
+	ProcessControlBlock_t newPCB1 = {.remaining_burst_time = 5, .priority = 1, .arrival = 0, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB2 = {.remaining_burst_time = 3, .priority = 1, .arrival = 1, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB3 = {.remaining_burst_time = 8, .priority = 1, .arrival = 2, .deadline = 0, .started = false};
 	
 	dyn_array_t* ready_queue = dyn_array_create(3, sizeof(ProcessControlBlock_t), NULL);
 	
@@ -1036,7 +1365,8 @@ TEST (priority, SamePrioritiesDiffArrival) // basically doing FCFS algorithm
 	dyn_array_push_back(ready_queue, &newPCB2);
 	dyn_array_push_back(ready_queue, &newPCB3);
 	
-	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0};
+	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+		.waiting_latency = {}, .turnaround_latency = {}};
 	
 	EXPECT_EQ(true,priority(ready_queue, &result));
 	
@@ -1049,9 +1379,9 @@ TEST (priority, SamePrioritiesDiffArrival) // basically doing FCFS algorithm
 
 TEST (priority, SamePrioritiesSameArrival) // basically doing FCFS algorithm
 {
-	ProcessControlBlock_t newPCB1 = {.remaining_burst_time = 5, .priority = 1, .arrival = 1, .started = false};
-	ProcessControlBlock_t newPCB2 = {.remaining_burst_time = 3, .priority = 1, .arrival = 1, .started = false};
-	ProcessControlBlock_t newPCB3 = {.remaining_burst_time = 8, .priority = 1, .arrival = 1, .started = false};
+	ProcessControlBlock_t newPCB1 = {.remaining_burst_time = 5, .priority = 1, .arrival = 1, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB2 = {.remaining_burst_time = 3, .priority = 1, .arrival = 1, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB3 = {.remaining_burst_time = 8, .priority = 1, .arrival = 1, .deadline = 0, .started = false};
 	
 	dyn_array_t* ready_queue = dyn_array_create(3, sizeof(ProcessControlBlock_t), NULL);
 	
@@ -1059,7 +1389,8 @@ TEST (priority, SamePrioritiesSameArrival) // basically doing FCFS algorithm
 	dyn_array_push_back(ready_queue, &newPCB2);
 	dyn_array_push_back(ready_queue, &newPCB3);
 	
-	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0};
+	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+		.waiting_latency = {}, .turnaround_latency = {}};
 	
 	EXPECT_EQ(true,priority(ready_queue, &result));
 	
@@ -1072,9 +1403,9 @@ TEST (priority, SamePrioritiesSameArrival) // basically doing FCFS algorithm
 
 TEST (priority, LateArrivingHighPriority) // tests non-preemption
 {
-	ProcessControlBlock_t newPCB1 = {.remaining_burst_time = 4, .priority = 2, .arrival = 0, .started = false};
-	ProcessControlBlock_t newPCB2 = {.remaining_burst_time = 2, .priority = 1, .arrival = 20, .started = false};
-	ProcessControlBlock_t newPCB3 = {.remaining_burst_time = 6, .priority = 3, .arrival = 2, .started = false};
+	ProcessControlBlock_t newPCB1 = {.remaining_burst_time = 4, .priority = 2, .arrival = 0, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB2 = {.remaining_burst_time = 2, .priority = 1, .arrival = 20, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB3 = {.remaining_burst_time = 6, .priority = 3, .arrival = 2, .deadline = 0, .started = false};
 	
 	dyn_array_t* ready_queue = dyn_array_create(3, sizeof(ProcessControlBlock_t), NULL);
 	
@@ -1082,7 +1413,8 @@ TEST (priority, LateArrivingHighPriority) // tests non-preemption
 	dyn_array_push_back(ready_queue, &newPCB2);
 	dyn_array_push_back(ready_queue, &newPCB3);
 	
-	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0};
+	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+		.waiting_latency = {}, .turnaround_latency = {}};
 	
 	EXPECT_EQ(true,priority(ready_queue, &result));
 	
@@ -1096,9 +1428,9 @@ TEST (priority, LateArrivingHighPriority) // tests non-preemption
 
 TEST (priority, GapsInArrivalTimes) 
 {
-	ProcessControlBlock_t newPCB1 = {.remaining_burst_time = 5, .priority = 1, .arrival = 0, .started = false};
-	ProcessControlBlock_t newPCB2 = {.remaining_burst_time = 3, .priority = 3, .arrival = 8, .started = false};
-	ProcessControlBlock_t newPCB3 = {.remaining_burst_time = 4, .priority = 2, .arrival = 20, .started = false};
+	ProcessControlBlock_t newPCB1 = {.remaining_burst_time = 5, .priority = 1, .arrival = 0, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB2 = {.remaining_burst_time = 3, .priority = 3, .arrival = 8, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB3 = {.remaining_burst_time = 4, .priority = 2, .arrival = 20, .deadline = 0, .started = false};
 	
 	dyn_array_t* ready_queue = dyn_array_create(3, sizeof(ProcessControlBlock_t), NULL);
 	
@@ -1106,7 +1438,8 @@ TEST (priority, GapsInArrivalTimes)
 	dyn_array_push_back(ready_queue, &newPCB2);
 	dyn_array_push_back(ready_queue, &newPCB3);
 	
-	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0};
+	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+		.waiting_latency = {}, .turnaround_latency = {}};
 	
 	EXPECT_EQ(true,priority(ready_queue, &result));
 	
@@ -1119,9 +1452,9 @@ TEST (priority, GapsInArrivalTimes)
 
 TEST (priority, NoProcessArrivesAtZero) 
 {
-	ProcessControlBlock_t newPCB1 = {.remaining_burst_time = 5, .priority = 1, .arrival = 2, .started = false};
-	ProcessControlBlock_t newPCB2 = {.remaining_burst_time = 3, .priority = 3, .arrival = 4, .started = false};
-	ProcessControlBlock_t newPCB3 = {.remaining_burst_time = 4, .priority = 2, .arrival = 6, .started = false};
+	ProcessControlBlock_t newPCB1 = {.remaining_burst_time = 5, .priority = 1, .arrival = 2, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB2 = {.remaining_burst_time = 3, .priority = 3, .arrival = 4, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB3 = {.remaining_burst_time = 4, .priority = 2, .arrival = 6, .deadline = 0, .started = false};
 	
 	dyn_array_t* ready_queue = dyn_array_create(3, sizeof(ProcessControlBlock_t), NULL);
 	
@@ -1129,7 +1462,8 @@ TEST (priority, NoProcessArrivesAtZero)
 	dyn_array_push_back(ready_queue, &newPCB2);
 	dyn_array_push_back(ready_queue, &newPCB3);
 	
-	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0};
+	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+		.waiting_latency = {}, .turnaround_latency = {}};
 	
 	EXPECT_EQ(true,priority(ready_queue, &result));
 	
@@ -1146,9 +1480,9 @@ TEST (priority, NoProcessArrivesAtZero)
 
 TEST (priority, TiesInPrioritySameArrival) // should be actually doing the priority algorithm because each process is given a different priority
 {
-	ProcessControlBlock_t newPCB1 = {.remaining_burst_time = 4, .priority = 1, .arrival = 0, .started = false};
-	ProcessControlBlock_t newPCB2 = {.remaining_burst_time = 2, .priority = 2, .arrival = 0, .started = false};
-	ProcessControlBlock_t newPCB3 = {.remaining_burst_time = 6, .priority = 1, .arrival = 0, .started = false};
+	ProcessControlBlock_t newPCB1 = {.remaining_burst_time = 4, .priority = 1, .arrival = 0, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB2 = {.remaining_burst_time = 2, .priority = 2, .arrival = 0, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB3 = {.remaining_burst_time = 6, .priority = 1, .arrival = 0, .deadline = 0, .started = false};
 	
 	dyn_array_t* ready_queue = dyn_array_create(3, sizeof(ProcessControlBlock_t), NULL);
 	
@@ -1156,7 +1490,8 @@ TEST (priority, TiesInPrioritySameArrival) // should be actually doing the prior
 	dyn_array_push_back(ready_queue, &newPCB2);
 	dyn_array_push_back(ready_queue, &newPCB3);
 	
-	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0};
+	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+		.waiting_latency = {}, .turnaround_latency = {}};
 	
 	EXPECT_EQ(true,priority(ready_queue, &result));
 	
@@ -1169,9 +1504,9 @@ TEST (priority, TiesInPrioritySameArrival) // should be actually doing the prior
 
 TEST (priority, DifferentPrioritiesSameArrival) // should be actually doing the priority algorithm because each process is given a different priority
 {
-	ProcessControlBlock_t newPCB1 = {.remaining_burst_time = 4, .priority = 2, .arrival = 0, .started = false};
-	ProcessControlBlock_t newPCB2 = {.remaining_burst_time = 2, .priority = 1, .arrival = 0, .started = false};
-	ProcessControlBlock_t newPCB3 = {.remaining_burst_time = 6, .priority = 3, .arrival = 0, .started = false};
+	ProcessControlBlock_t newPCB1 = {.remaining_burst_time = 4, .priority = 2, .arrival = 0, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB2 = {.remaining_burst_time = 2, .priority = 1, .arrival = 0, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB3 = {.remaining_burst_time = 6, .priority = 3, .arrival = 0, .deadline = 0, .started = false};
 	
 	dyn_array_t* ready_queue = dyn_array_create(3, sizeof(ProcessControlBlock_t), NULL);
 	
@@ -1179,7 +1514,8 @@ TEST (priority, DifferentPrioritiesSameArrival) // should be actually doing the
 	dyn_array_push_back(ready_queue, &newPCB2);
 	dyn_array_push_back(ready_queue, &newPCB3);
 	
-	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0};
+	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+		.waiting_latency = {}, .turnaround_latency = {}};
 	
 	EXPECT_EQ(true,priority(ready_queue, &result));
 	
@@ -1192,9 +1528,9 @@ TEST (priority, DifferentPrioritiesSameArrival) // should be actually doing the
 
 TEST (priority, DifferentPrioritiesDiffArrivalShort) // should be actually doing the priority algorithm because each process is given a different priority
 {
-	ProcessControlBlock_t newPCB1 = {.remaining_burst_time = 4, .priority = 2, .arrival = 0, .started = false};
-	ProcessControlBlock_t newPCB2 = {.remaining_burst_time = 2, .priority = 1, .arrival = 1, .started = false};
-	ProcessControlBlock_t newPCB3 = {.remaining_burst_time = 6, .priority = 3, .arrival = 2, .started = false};
+	ProcessControlBlock_t newPCB1 = {.remaining_burst_time = 4, .priority = 2, .arrival = 0, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB2 = {.remaining_burst_time = 2, .priority = 1, .arrival = 1, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB3 = {.remaining_burst_time = 6, .priority = 3, .arrival = 2, .deadline = 0, .started = false};
 	
 	dyn_array_t* ready_queue = dyn_array_create(3, sizeof(ProcessControlBlock_t), NULL);
 	
@@ -1202,7 +1538,8 @@ TEST (priority, DifferentPrioritiesDiffArrivalShort) // should be actually doing
 	dyn_array_push_back(ready_queue, &newPCB2);
 	dyn_array_push_back(ready_queue, &newPCB3);
 	
-	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0};
+	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+		.waiting_latency = {}, .turnaround_latency = {}};
 	
 	EXPECT_EQ(true,priority(ready_queue, &result));
 	
@@ -1215,16 +1552,16 @@ TEST (priority, DifferentPrioritiesDiffArrivalShort) // should be actually doing
 
 TEST (priority, DifferentPrioritiesDiffArrivalLong) // tests with more than 3 processes
 {
-	ProcessControlBlock_t newPCB1 = {.remaining_burst_time = 4, .priority = 2, .arrival = 0, .started = false};
-	ProcessControlBlock_t newPCB2 = {.remaining_burst_time = 2, .priority = 1, .arrival = 1, .started = false};
-	ProcessControlBlock_t newPCB3 = {.remaining_burst_time = 6, .priority = 3, .arrival = 3, .started = false};
-	ProcessControlBlock_t newPCB4 = {.remaining_burst_time = 5, .priority = 5, .arrival = 5, .started = false};
-	ProcessControlBlock_t newPCB5 = {.remaining_burst_time = 3, .priority = 4, .arrival = 8, .started = false};
-	ProcessControlBlock_t newPCB6 = {.remaining_burst_time = 7, .priority = 7, .arrival = 10, .started = false};
-	ProcessControlBlock_t newPCB7 = {.remaining_burst_time = 9, .priority = 8, .arrival = 2, .started = false};
-	ProcessControlBlock_t newPCB8 = {.remaining_burst_time = 20, .priority = 10, .arrival = 4, .started = false};
-	ProcessControlBlock_t newPCB9 = {.remaining_burst_time = 5, .priority = 3, .arrival = 6, .started = false};
-	ProcessControlBlock_t newPCB10 = {.remaining_burst_time = 2, .priority = 1, .arrival = 20, .started = false};
+	ProcessControlBlock_t newPCB1 = {.remaining_burst_time = 4, .priority = 2, .arrival = 0, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB2 = {.remaining_burst_time = 2, .priority = 1, .arrival = 1, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB3 = {.remaining_burst_time = 6, .priority = 3, .arrival = 3, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB4 = {.remaining_burst_time = 5, .priority = 5, .arrival = 5, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB5 = {.remaining_burst_time = 3, .priority = 4, .arrival = 8, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB6 = {.remaining_burst_time = 7, .priority = 7, .arrival = 10, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB7 = {.remaining_burst_time = 9, .priority = 8, .arrival = 2, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB8 = {.remaining_burst_time = 20, .priority = 10, .arrival = 4, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB9 = {.remaining_burst_time = 5, .priority = 3, .arrival = 6, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB10 = {.remaining_burst_time = 2, .priority = 1, .arrival = 20, .deadline = 0, .started = false};
 	
 	dyn_array_t* ready_queue = dyn_array_create(10, sizeof(ProcessControlBlock_t), NULL);
 	
@@ -1239,7 +1576,8 @@ TEST (priority, DifferentPrioritiesDiffArrivalLong) // tests with more than 3 pr
 	dyn_array_push_back(ready_queue, &newPCB9);
 	dyn_array_push_back(ready_queue, &newPCB10);
 
-	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0};
+	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+		.waiting_latency = {}, .turnaround_latency = {}};
 	
 	EXPECT_EQ(true,priority(ready_queue, &result));
 	
@@ -1250,13 +1588,100 @@ TEST (priority, DifferentPrioritiesDiffArrivalLong) // tests with more than 3 pr
 	dyn_array_destroy(ready_queue);
 }
 
+/*
+*  Tests related to huge burst times -- the clock has to jump rather than tick
+**/
+
+TEST (priority, HugeBurstTimes)
+{
+	ProcessControlBlock_t newPCB1 = {.remaining_burst_time = 4000000000, .priority = 3, .arrival = 0, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB2 = {.remaining_burst_time = 4000000000, .priority = 1, .arrival = 5, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB3 = {.remaining_burst_time = 1, .priority = 2, .arrival = 6, .deadline = 0, .started = false};
+	
+	dyn_array_t* ready_queue = dyn_array_create(3, sizeof(ProcessControlBlock_t), NULL);
+	
+	dyn_array_push_back(ready_queue, &newPCB1);
+	dyn_array_push_back(ready_queue, &newPCB2);
+	dyn_array_push_back(ready_queue, &newPCB3);
+	
+	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+		.waiting_latency = {}, .turnaround_latency = {}};
+	
+	EXPECT_EQ(true,priority(ready_queue, &result));
+	
+	EXPECT_EQ(result.total_run_time, 8000000001UL);
+	EXPECT_NEAR(result.average_waiting_time, 3999999996.33, 1000.0);
+	EXPECT_NEAR(result.average_turnaround_time, 6666666663.33, 1000.0);
+	
+	dyn_array_destroy(ready_queue);
+}
+
+
+/*
+*  Tests related to tie-breaking -- equal priorities go by arrival, then by file order
+**/
+
+TEST (priority, TiesBrokenByArrivalThenFileOrder)
+{
+	ProcessControlBlock_t newPCB1 = {.remaining_burst_time = 4, .priority = 2, .arrival = 1, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB2 = {.remaining_burst_time = 2, .priority = 1, .arrival = 3, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB3 = {.remaining_burst_time = 3, .priority = 1, .arrival = 2, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB4 = {.remaining_burst_time = 6, .priority = 1, .arrival = 2, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB5 = {.remaining_burst_time = 2, .priority = 5, .arrival = 0, .deadline = 0, .started = false};
+	
+	dyn_array_t* ready_queue = dyn_array_create(5, sizeof(ProcessControlBlock_t), NULL);
+	
+	dyn_array_push_back(ready_queue, &newPCB1);
+	dyn_array_push_back(ready_queue, &newPCB2);
+	dyn_array_push_back(ready_queue, &newPCB3);
+	dyn_array_push_back(ready_queue, &newPCB4);
+	dyn_array_push_back(ready_queue, &newPCB5);
+	
+	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+		.waiting_latency = {}, .turnaround_latency = {}};
+	
+	EXPECT_EQ(true,priority(ready_queue, &result));
+	
+	EXPECT_EQ(result.total_run_time, 17UL);
+	EXPECT_NEAR(result.average_waiting_time, 4.60, 0.01);
+	EXPECT_NEAR(result.average_turnaround_time, 8.00, 0.01);
+	
+	dyn_array_destroy(ready_queue);
+}
+
+TEST (priority, ManyProcesses) // priorities n..1 all arriving at 0, so they run in reverse file order
+{
+	const uint32_t numPCBs = 100000;
+	
+	dyn_array_t* ready_queue = dyn_array_create(numPCBs, sizeof(ProcessControlBlock_t), NULL);
+	
+	for (uint32_t i = 0; i < numPCBs; i++)
+	{
+		ProcessControlBlock_t newPCB = {.remaining_burst_time = 1, .priority = numPCBs - i, .arrival = 0, .deadline = 0, .started = false};
+		dyn_array_push_back(ready_queue, &newPCB);
+	}
+	
+	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+		.waiting_latency = {}, .turnaround_latency = {}};
+	
+	EXPECT_EQ(true,priority(ready_queue, &result));
+	
+	EXPECT_EQ(result.total_run_time, 100000UL);
+	EXPECT_NEAR(result.average_waiting_time, 49999.5, 0.01);
+	EXPECT_NEAR(result.average_turnaround_time, 50000.5, 0.01);
+	
+	dyn_array_destroy(ready_queue);
+}
+
+
 /*
 *  Shortest remaining time UNIT TEST CASES
 **/
 // if ready_queue == NULL
 TEST (shortest_remaining_time_first, ReadyQueueNULL) 
 {
-	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0};
+	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+		.waiting_latency = {}, .turnaround_latency = {}};
 	EXPECT_EQ(false,shortest_remaining_time_first(NULL, &result));
 }
 
@@ -1264,9 +1689,9 @@ TEST (shortest_remaining_time_first, ReadyQueueNULL)
 // if result == NULL
 TEST (shortest_remaining_time_first, ResultNULL) 
 {
-	ProcessControlBlock_t newPCB1 = {.remaining_burst_time = 5, .priority = 1, .arrival = 0, .started = false};
-	ProcessControlBlock_t newPCB2 = {.remaining_burst_time = 3, .priority = 1, .arrival = 0, .started = false};
-	ProcessControlBlock_t newPCB3 = {.remaining_burst_time = 8, .priority = 1, .arrival = 0, .started = false};
+	ProcessControlBlock_t newPCB1 = {.remaining_burst_time = 5, .priority = 1, .arrival = 0, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB2 = {.remaining_burst_time = 3, .priority = 1, .arrival = 0, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB3 = {.remaining_burst_time = 8, .priority = 1, .arrival = 0, .deadline = 0, .started = false};
 	
 	dyn_array_t* ready_queue = dyn_array_create(3, sizeof(ProcessControlBlock_t), NULL);
 	
@@ -1286,7 +1711,8 @@ TEST (shortest_remaining_time_first, ZeroSizeArray)
 
 	// Not adding any ProcessControlBlock_t to ready_queue, no processes to schedule
 
-	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0};
+	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+		.waiting_latency = {}, .turnaround_latency = {}};
 	
 	EXPECT_EQ(false,shortest_remaining_time_first(ready_queue, &result));
 	
@@ -1295,9 +1721,9 @@ TEST (shortest_remaining_time_first, ZeroSizeArray)
 
 TEST(shortest_remaining_time_first, ShortestArrivesFirst)
 {
-	ProcessControlBlock_t newPCB1 = {.remaining_burst_time = 3, .priority = 2, .arrival = 0, .started = false};
-	ProcessControlBlock_t newPCB2 = {.remaining_burst_time = 4, .priority = 1, .arrival = 1, .started = false};
-	ProcessControlBlock_t newPCB3 = {.remaining_burst_time = 6, .priority = 3, .arrival = 3, .started = false};
+	ProcessControlBlock_t newPCB1 = {.remaining_burst_time = 3, .priority = 2, .arrival = 0, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB2 = {.remaining_burst_time = 4, .priority = 1, .arrival = 1, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB3 = {.remaining_burst_time = 6, .priority = 3, .arrival = 3, .deadline = 0, .started = false};
 	
 	dyn_array_t* ready_queue = dyn_array_create(3, sizeof(ProcessControlBlock_t), NULL);
 	
@@ -1305,7 +1731,8 @@ TEST(shortest_remaining_time_first, ShortestArrivesFirst)
 	dyn_array_push_back(ready_queue, &newPCB2);
 	dyn_array_push_back(ready_queue, &newPCB3);
 	
-	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0};
+	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+		.waiting_latency = {}, .turnaround_latency = {}};
 	
 	EXPECT_EQ(true, shortest_remaining_time_first(ready_queue, &result));
 	
@@ -1318,9 +1745,9 @@ TEST(shortest_remaining_time_first, ShortestArrivesFirst)
 
 TEST(shortest_remaining_time_first, ShortestArrivesMiddle)
 {
-	ProcessControlBlock_t newPCB2 = {.remaining_burst_time = 4, .priority = 2, .arrival = 0, .started = false};
-	ProcessControlBlock_t newPCB1 = {.remaining_burst_time = 3, .priority = 1, .arrival = 1, .started = false};
-	ProcessControlBlock_t newPCB3 = {.remaining_burst_time = 6, .priority = 3, .arrival = 3, .started = false};
+	ProcessControlBlock_t newPCB2 = {.remaining_burst_time = 4, .priority = 2, .arrival = 0, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB1 = {.remaining_burst_time = 3, .priority = 1, .arrival = 1, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB3 = {.remaining_burst_time = 6, .priority = 3, .arrival = 3, .deadline = 0, .started = false};
 	
 	dyn_array_t* ready_queue = dyn_array_create(3, sizeof(ProcessControlBlock_t), NULL);
 	
@@ -1328,7 +1755,8 @@ TEST(shortest_remaining_time_first, ShortestArrivesMiddle)
 	dyn_array_push_back(ready_queue, &newPCB2);
 	dyn_array_push_back(ready_queue, &newPCB3);
 	
-	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0};
+	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+		.waiting_latency = {}, .turnaround_latency = {}};
 	
 	EXPECT_EQ(true, shortest_remaining_time_first(ready_queue, &result));
 	
@@ -1341,9 +1769,9 @@ TEST(shortest_remaining_time_first, ShortestArrivesMiddle)
 
 TEST(shortest_remaining_time_first, ShortestArrivesLast)
 {
-	ProcessControlBlock_t newPCB1 = {.remaining_burst_time = 6, .priority = 2, .arrival = 0, .started = false};
-	ProcessControlBlock_t newPCB2 = {.remaining_burst_time = 4, .priority = 1, .arrival = 1, .started = false};
-	ProcessControlBlock_t newPCB3 = {.remaining_burst_time = 3, .priority = 3, .arrival = 3, .started = false};
+	ProcessControlBlock_t newPCB1 = {.remaining_burst_time = 6, .priority = 2, .arrival = 0, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB2 = {.remaining_burst_time = 4, .priority = 1, .arrival = 1, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB3 = {.remaining_burst_time = 3, .priority = 3, .arrival = 3, .deadline = 0, .started = false};
 	
 	dyn_array_t* ready_queue = dyn_array_create(3, sizeof(ProcessControlBlock_t), NULL);
 	
@@ -1351,7 +1779,8 @@ TEST(shortest_remaining_time_first, ShortestArrivesLast)
 	dyn_array_push_back(ready_queue, &newPCB2);
 	dyn_array_push_back(ready_queue, &newPCB3);
 	
-	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0};
+	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+		.waiting_latency = {}, .turnaround_latency = {}};
 	
 	EXPECT_EQ(true, shortest_remaining_time_first(ready_queue, &result));
 	
@@ -1364,9 +1793,9 @@ TEST(shortest_remaining_time_first, ShortestArrivesLast)
 
 TEST(shortest_remaining_time_first, SameArrival)
 {
-	ProcessControlBlock_t newPCB2 = {.remaining_burst_time = 4, .priority = 1, .arrival = 0, .started = false};
-	ProcessControlBlock_t newPCB1 = {.remaining_burst_time = 2, .priority = 3, .arrival = 0, .started = false};
-	ProcessControlBlock_t newPCB3 = {.remaining_burst_time = 6, .priority = 2, .arrival = 0, .started = false};
+	ProcessControlBlock_t newPCB2 = {.remaining_burst_time = 4, .priority = 1, .arrival = 0, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB1 = {.remaining_burst_time = 2, .priority = 3, .arrival = 0, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB3 = {.remaining_burst_time = 6, .priority = 2, .arrival = 0, .deadline = 0, .started = false};
 	
 	dyn_array_t* ready_queue = dyn_array_create(3, sizeof(ProcessControlBlock_t), NULL);
 	
@@ -1374,7 +1803,8 @@ TEST(shortest_remaining_time_first, SameArrival)
 	dyn_array_push_back(ready_queue, &newPCB2);
 	dyn_array_push_back(ready_queue, &newPCB3);
 	
-	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0};
+	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+		.waiting_latency = {}, .turnaround_latency = {}};
 	
 	EXPECT_EQ(true, shortest_remaining_time_first(ready_queue, &result));
 	
@@ -1387,9 +1817,9 @@ TEST(shortest_remaining_time_first, SameArrival)
 
 TEST(shortest_remaining_time_first, SameArrivalSamePriority)
 {
-	ProcessControlBlock_t newPCB2 = {.remaining_burst_time = 4, .priority = 1, .arrival = 0, .started = false};
-	ProcessControlBlock_t newPCB1 = {.remaining_burst_time = 2, .priority = 1, .arrival = 0, .started = false};
-	ProcessControlBlock_t newPCB3 = {.remaining_burst_time = 6, .priority = 1, .arrival = 0, .started = false};
+	ProcessControlBlock_t newPCB2 = {.remaining_burst_time = 4, .priority = 1, .arrival = 0, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB1 = {.remaining_burst_time = 2, .priority = 1, .arrival = 0, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB3 = {.remaining_burst_time = 6, .priority = 1, .arrival = 0, .deadline = 0, .started = false};
 	
 	dyn_array_t* ready_queue = dyn_array_create(3, sizeof(ProcessControlBlock_t), NULL);
 	
@@ -1397,7 +1827,8 @@ TEST(shortest_remaining_time_first, SameArrivalSamePriority)
 	dyn_array_push_back(ready_queue, &newPCB2);
 	dyn_array_push_back(ready_queue, &newPCB3);
 	
-	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0};
+	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+		.waiting_latency = {}, .turnaround_latency = {}};
 	
 	EXPECT_EQ(true, shortest_remaining_time_first(ready_queue, &result));
 	
@@ -1410,16 +1841,16 @@ TEST(shortest_remaining_time_first, SameArrivalSamePriority)
 
 TEST(shortest_remaining_time_first, BigData)
 {
-	ProcessControlBlock_t newPCB1 = {.remaining_burst_time = 4, .priority = 2, .arrival = 0, .started = false};
-	ProcessControlBlock_t newPCB2 = {.remaining_burst_time = 2, .priority = 1, .arrival = 1, .started = false};
-	ProcessControlBlock_t newPCB3 = {.remaining_burst_time = 6, .priority = 3, .arrival = 3, .started = false};
-	ProcessControlBlock_t newPCB4 = {.remaining_burst_time = 5, .priority = 5, .arrival = 5, .started = false};
-	ProcessControlBlock_t newPCB5 = {.remaining_burst_time = 3, .priority = 4, .arrival = 8, .started = false};
-	ProcessControlBlock_t newPCB6 = {.remaining_burst_time = 7, .priority = 7, .arrival = 10, .started = false};
-	ProcessControlBlock_t newPCB7 = {.remaining_burst_time = 9, .priority = 8, .arrival = 2, .started = false};
-	ProcessControlBlock_t newPCB8 = {.remaining_burst_time = 10, .priority = 10, .arrival = 4, .started = false};
-	ProcessControlBlock_t newPCB9 = {.remaining_burst_time = 3, .priority = 3, .arrival = 6, .started = false};
-	ProcessControlBlock_t newPCB10 = {.remaining_burst_time = 1, .priority = 1, .arrival = 20, .started = false};
+	ProcessControlBlock_t newPCB1 = {.remaining_burst_time = 4, .priority = 2, .arrival = 0, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB2 = {.remaining_burst_time = 2, .priority = 1, .arrival = 1, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB3 = {.remaining_burst_time = 6, .priority = 3, .arrival = 3, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB4 = {.remaining_burst_time = 5, .priority = 5, .arrival = 5, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB5 = {.remaining_burst_time = 3, .priority = 4, .arrival = 8, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB6 = {.remaining_burst_time = 7, .priority = 7, .arrival = 10, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB7 = {.remaining_burst_time = 9, .priority = 8, .arrival = 2, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB8 = {.remaining_burst_time = 10, .priority = 10, .arrival = 4, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB9 = {.remaining_burst_time = 3, .priority = 3, .arrival = 6, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB10 = {.remaining_burst_time = 1, .priority = 1, .arrival = 20, .deadline = 0, .started = false};
 	
 	dyn_array_t* ready_queue = dyn_array_create(10, sizeof(ProcessControlBlock_t), NULL);
 	
@@ -1434,7 +1865,8 @@ TEST(shortest_remaining_time_first, BigData)
 	dyn_array_push_back(ready_queue, &newPCB9);
 	dyn_array_push_back(ready_queue, &newPCB10);
 	
-	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0};
+	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+		.waiting_latency = {}, .turnaround_latency = {}};
 	
 	EXPECT_EQ(true, shortest_remaining_time_first(ready_queue, &result));
 	
@@ -1446,214 +1878,3400 @@ TEST(shortest_remaining_time_first, BigData)
 }
 
 
-/*
-*  LOAD PROCESS CONTROL BLOCKS UNIT TEST CASES
-**/
-
-/*
-*  Tests related to invalid parameters
-**/
+TEST(shortest_remaining_time_first, ProcessesWithZeroBurstTime)
+{
+	ProcessControlBlock_t newPCB1 = {.remaining_burst_time = 0, .priority = 1, .arrival = 0, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB2 = {.remaining_burst_time = 0, .priority = 1, .arrival = 1, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB3 = {.remaining_burst_time = 0, .priority = 1, .arrival = 2, .deadline = 0, .started = false};
+	
+	dyn_array_t* ready_queue = dyn_array_create(3, sizeof(ProcessControlBlock_t), NULL);
+	
+	dyn_array_push_back(ready_queue, &newPCB1);
+	dyn_array_push_back(ready_queue, &newPCB2);
+	dyn_array_push_back(ready_queue, &newPCB3);
+	
+	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+		.waiting_latency = {}, .turnaround_latency = {}};
+	
+	EXPECT_EQ(true, shortest_remaining_time_first(ready_queue, &result));
+	
+	EXPECT_EQ(result.total_run_time, 0UL);
+	EXPECT_NEAR(result.average_waiting_time, 0.00, 0.01);
+	EXPECT_NEAR(result.average_turnaround_time, 0.00, 0.01);
+	
+	dyn_array_destroy(ready_queue);
+}
 
-// if the filename is NULL
-TEST (load_process_control_blocks, fileNULL) 
+TEST(shortest_remaining_time_first, HugeBurstTimes) // the long job is preempted at each arrival, without ticking through its burst
 {
-	EXPECT_EQ(nullptr,load_process_control_blocks(nullptr));
+	ProcessControlBlock_t newPCB1 = {.remaining_burst_time = 4000000000, .priority = 1, .arrival = 0, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB2 = {.remaining_burst_time = 5, .priority = 1, .arrival = 10, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB3 = {.remaining_burst_time = 3000000000, .priority = 1, .arrival = 12, .deadline = 0, .started = false};
+	
+	dyn_array_t* ready_queue = dyn_array_create(3, sizeof(ProcessControlBlock_t), NULL);
+	
+	dyn_array_push_back(ready_queue, &newPCB1);
+	dyn_array_push_back(ready_queue, &newPCB2);
+	dyn_array_push_back(ready_queue, &newPCB3);
+	
+	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+		.waiting_latency = {}, .turnaround_latency = {}};
+	
+	EXPECT_EQ(true, shortest_remaining_time_first(ready_queue, &result));
+	
+	EXPECT_EQ(result.total_run_time, 7000000005UL);
+	EXPECT_NEAR(result.average_waiting_time, 1000000003.0, 1000.0);
+	EXPECT_NEAR(result.average_turnaround_time, 3333333338.0, 1000.0);
+	
+	dyn_array_destroy(ready_queue);
 }
 
-// if the file doesn't exist
-TEST (load_process_control_blocks, fileDNE) 
+TEST(shortest_remaining_time_first, ManyProcesses) // far more pcbs than fit in stack arrays
 {
-	FILE *fptr = fopen("fileDNE.bin", "wb");
-	fclose(fptr);
-	dyn_array_t * pcbs = load_process_control_blocks("fileDNE.bin");
-	EXPECT_EQ(NULL,pcbs);
-	dyn_array_destroy(pcbs);
-	remove("fileDNE.bin");
+	const uint32_t numPCBs = 1000000;
+	
+	dyn_array_t* ready_queue = dyn_array_create(numPCBs, sizeof(ProcessControlBlock_t), NULL);
+	
+	for (uint32_t i = 0; i < numPCBs; i++)
+	{
+		ProcessControlBlock_t newPCB = {.remaining_burst_time = 2, .priority = 1, .arrival = 2 * (numPCBs - 1 - i), .deadline = 0, .started = false};
+		dyn_array_push_back(ready_queue, &newPCB);
+	}
+	
+	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+		.waiting_latency = {}, .turnaround_latency = {}};
+	
+	EXPECT_EQ(true, shortest_remaining_time_first(ready_queue, &result));
+	
+	EXPECT_EQ(result.total_run_time, 2000000UL);
+	EXPECT_NEAR(result.average_waiting_time, 0.00, 0.01);
+	EXPECT_NEAR(result.average_turnaround_time, 2.00, 0.01);
+	
+	dyn_array_destroy(ready_queue);
 }
 
+
 /*
-*  Tests related to corrupt or malformed file types
+*  Busy period decomposition UNIT TEST CASES
 **/
 
-TEST (load_process_control_blocks, emptyFile) 
+TEST (schedule_busy_periods_parallel, BadParams)
 {
-	FILE *fptr = fopen("test.bin", "wb");
-	fclose(fptr);
-	EXPECT_EQ(NULL,load_process_control_blocks("test.bin"));
-	remove("test.bin");
+	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+		.waiting_latency = {}, .turnaround_latency = {}};
+	EXPECT_EQ(false, schedule_busy_periods_parallel(NULL, &result, SCHEDULE_FCFS, 0, 4));
+
+	dyn_array_t* ready_queue = random_ready_queue(10, 3, 10, 20);
+	EXPECT_EQ(false, schedule_busy_periods_parallel(ready_queue, NULL, SCHEDULE_FCFS, 0, 4));
+	EXPECT_EQ(false, schedule_busy_periods_parallel(ready_queue, &result, SCHEDULE_RR, 0, 4)); // RR without a quantum
+	dyn_array_destroy(ready_queue);
+
+	ready_queue = dyn_array_create(3, sizeof(ProcessControlBlock_t), NULL);
+	EXPECT_EQ(false, schedule_busy_periods_parallel(ready_queue, &result, SCHEDULE_SJF, 0, 4));
+	dyn_array_destroy(ready_queue);
+}
+
+TEST (schedule_busy_periods_parallel, GapsInArrivalTimes) // three busy periods, one pcb each
+{
+	ProcessControlBlock_t newPCB1 = {.remaining_burst_time = 5, .priority = 1, .arrival = 0, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB2 = {.remaining_burst_time = 6, .priority = 1, .arrival = 8, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB3 = {.remaining_burst_time = 3, .priority = 1, .arrival = 20, .deadline = 0, .started = false};
+	
+	dyn_array_t* ready_queue = dyn_array_create(3, sizeof(ProcessControlBlock_t), NULL);
+	
+	dyn_array_push_back(ready_queue, &newPCB1);
+	dyn_array_push_back(ready_queue, &newPCB2);
+	dyn_array_push_back(ready_queue, &newPCB3);
+	
+	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+		.waiting_latency = {}, .turnaround_latency = {}};
+	
+	EXPECT_EQ(true, schedule_busy_periods_parallel(ready_queue, &result, SCHEDULE_RR, QUANTUM, 3));
+	
+	EXPECT_EQ(result.total_run_time, 14UL);
+	EXPECT_NEAR(result.average_waiting_time, 0.00, 0.01);
+	EXPECT_NEAR(result.average_turnaround_time, 4.67, 0.01);
+	
+	dyn_array_destroy(ready_queue);
+}
+
+TEST (schedule_busy_periods_parallel, MatchesSequential) // bursty trace with many idle gaps, every policy
+{
+	const ScheduleAlgorithm_t algorithms[] = {SCHEDULE_FCFS, SCHEDULE_SJF, SCHEDULE_PRIORITY, SCHEDULE_RR, SCHEDULE_SRT, SCHEDULE_EDF, SCHEDULE_EDF_PREEMPTIVE};
+
+	for (ScheduleAlgorithm_t algorithm : algorithms)
+	{
+		dyn_array_t* sequential_queue = random_ready_queue(100000, 11, 100, 110);
+		dyn_array_t* parallel_queue = random_ready_queue(100000, 11, 100, 110);
+
+		ScheduleResult_t expected = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+			.waiting_latency = {}, .turnaround_latency = {}};
+		ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+			.waiting_latency = {}, .turnaround_latency = {}};
+
+		switch (algorithm)
+		{
+			case SCHEDULE_FCFS: EXPECT_EQ(true, first_come_first_serve(sequential_queue, &expected)); break;
+			case SCHEDULE_SJF: EXPECT_EQ(true, shortest_job_first(sequential_queue, &expected)); break;
+			case SCHEDULE_PRIORITY: EXPECT_EQ(true, priority(sequential_queue, &expected)); break;
+			case SCHEDULE_RR: EXPECT_EQ(true, round_robin(sequential_queue, &expected, QUANTUM)); break;
+			case SCHEDULE_SRT: EXPECT_EQ(true, shortest_remaining_time_first(sequential_queue, &expected)); break;
+			case SCHEDULE_EDF: EXPECT_EQ(true, earliest_deadline_first(sequential_queue, &expected, false)); break;
+			case SCHEDULE_EDF_PREEMPTIVE: EXPECT_EQ(true, earliest_deadline_first(sequential_queue, &expected, true)); break;
+		}
+		EXPECT_EQ(true, schedule_busy_periods_parallel(parallel_queue, &result, algorithm, QUANTUM, 4));
+
+		EXPECT_EQ(expected.total_run_time, result.total_run_time);
+		EXPECT_EQ(expected.average_waiting_time, result.average_waiting_time);
+		EXPECT_EQ(expected.average_turnaround_time, result.average_turnaround_time);
+
+		dyn_array_destroy(sequential_queue);
+		dyn_array_destroy(parallel_queue);
+	}
+}
+
+
+/*
+*  Preemptive priority UNIT TEST CASES
+**/
+
+TEST (priority_preemptive, NULLParams)
+{
+	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+		.waiting_latency = {}, .turnaround_latency = {}};
+	EXPECT_EQ(false, priority_preemptive(NULL, &result, 0, NULL));
+
+	dyn_array_t* ready_queue = random_ready_queue(10, 3, 10, 20);
+	EXPECT_EQ(false, priority_preemptive(ready_queue, NULL, 0, NULL));
+	dyn_array_destroy(ready_queue);
+
+	ready_queue = dyn_array_create(3, sizeof(ProcessControlBlock_t), NULL);
+	EXPECT_EQ(false, priority_preemptive(ready_queue, &result, 4, NULL));
+	dyn_array_destroy(ready_queue);
+}
+
+TEST (priority_preemptive, LateArrivingHighPriority) // the long low priority pcb is preempted twice
+{
+	ProcessControlBlock_t newPCB1 = {.remaining_burst_time = 10, .priority = 3, .arrival = 0, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB2 = {.remaining_burst_time = 2, .priority = 1, .arrival = 2, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB3 = {.remaining_burst_time = 3, .priority = 2, .arrival = 3, .deadline = 0, .started = false};
+	
+	dyn_array_t* ready_queue = dyn_array_create(3, sizeof(ProcessControlBlock_t), NULL);
+	
+	dyn_array_push_back(ready_queue, &newPCB1);
+	dyn_array_push_back(ready_queue, &newPCB2);
+	dyn_array_push_back(ready_queue, &newPCB3);
+	
+	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+		.waiting_latency = {}, .turnaround_latency = {}};
+	
+	EXPECT_EQ(true, priority_preemptive(ready_queue, &result, 0, NULL));
+	
+	EXPECT_EQ(result.total_run_time, 15UL);
+	EXPECT_NEAR(result.average_waiting_time, 2.00, 0.01);
+	EXPECT_NEAR(result.average_turnaround_time, 7.00, 0.01);
+	
+	dyn_array_destroy(ready_queue);
+}
+
+TEST (priority_preemptive, AgingPreventsStarvation) // the waiting pcb ages past the running one at time 10
+{
+	const ProcessControlBlock_t pcbs[] = {
+		{.remaining_burst_time = 20, .priority = 1, .arrival = 0, .deadline = 0, .started = false},
+		{.remaining_burst_time = 2, .priority = 5, .arrival = 0, .deadline = 0, .started = false}};
+
+	dyn_array_t* ready_queue = dyn_array_import(pcbs, 2, sizeof(ProcessControlBlock_t), NULL);
+	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+		.waiting_latency = {}, .turnaround_latency = {}};
+
+	EXPECT_EQ(true, priority_preemptive(ready_queue, &result, 0, NULL));
+	EXPECT_EQ(result.total_run_time, 22UL);
+	EXPECT_NEAR(result.average_waiting_time, 10.00, 0.01);
+	EXPECT_NEAR(result.average_turnaround_time, 21.00, 0.01);
+	dyn_array_destroy(ready_queue);
+
+	ready_queue = dyn_array_import(pcbs, 2, sizeof(ProcessControlBlock_t), NULL);
+
+	EXPECT_EQ(true, priority_preemptive(ready_queue, &result, 2, NULL));
+	EXPECT_EQ(result.total_run_time, 22UL);
+	EXPECT_NEAR(result.average_waiting_time, 6.00, 0.01);
+	EXPECT_NEAR(result.average_turnaround_time, 17.00, 0.01);
+	dyn_array_destroy(ready_queue);
+}
+
+TEST (priority_preemptive, AgingOverflowRejected) // priority * aging_interval must leave room for the clock in 64 bits
+{
+	const ProcessControlBlock_t pcbs[] = {
+		{.remaining_burst_time = UINT32_MAX, .priority = UINT32_MAX, .arrival = 0, .deadline = 0, .started = false},
+		{.remaining_burst_time = UINT32_MAX, .priority = 0, .arrival = 1, .deadline = 0, .started = false}};
+
+	dyn_array_t* ready_queue = dyn_array_import(pcbs, 2, sizeof(ProcessControlBlock_t), NULL);
+	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+		.waiting_latency = {}, .turnaround_latency = {}};
+
+	EXPECT_EQ(false, priority_preemptive(ready_queue, &result, UINT32_MAX, NULL));
+	EXPECT_EQ(2U, dyn_array_size(ready_queue)); // left as it was
+
+	EXPECT_EQ(true, priority_preemptive(ready_queue, &result, 1U << 20, NULL)); // still far from wrapping
+	EXPECT_EQ(result.total_run_time, 2 * (unsigned long)UINT32_MAX);
+	dyn_array_destroy(ready_queue);
+}
+
+TEST (priority_preemptive, PreemptionColumns) // once by a higher priority arrival, once by aging
+{
+	const ProcessControlBlock_t pcbs[] = {
+		{.remaining_burst_time = 10, .priority = 3, .arrival = 0, .deadline = 0, .started = false},
+		{.remaining_burst_time = 2, .priority = 1, .arrival = 2, .deadline = 0, .started = false},
+		{.remaining_burst_time = 3, .priority = 2, .arrival = 3, .deadline = 0, .started = false}};
+	const ProcessControlBlock_t aging[] = {
+		{.remaining_burst_time = 20, .priority = 1, .arrival = 0, .deadline = 0, .started = false},
+		{.remaining_burst_time = 2, .priority = 5, .arrival = 0, .deadline = 0, .started = false}};
+	uint64_t firstDispatch[3], completion[3];
+	uint32_t preemptions[3];
+	ScheduleColumns_t columns = {firstDispatch, completion, NULL, NULL, preemptions};
+	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+		.waiting_latency = {}, .turnaround_latency = {}};
+
+	dyn_array_t* ready_queue = dyn_array_import(pcbs, 3, sizeof(ProcessControlBlock_t), NULL);
+	EXPECT_EQ(true, priority_preemptive(ready_queue, &result, 0, &columns)); // 0: 0-2, 1: 2-4, 2: 4-7, 0: 7-15
+	EXPECT_EQ(1U, preemptions[0]);
+	EXPECT_EQ(0U, preemptions[1]);
+	EXPECT_EQ(0U, preemptions[2]);
+	EXPECT_EQ(4UL, firstDispatch[2]);
+	EXPECT_EQ(15UL, completion[0]);
+	dyn_array_destroy(ready_queue);
+
+	ready_queue = dyn_array_import(aging, 2, sizeof(ProcessControlBlock_t), NULL);
+	EXPECT_EQ(true, priority_preemptive(ready_queue, &result, 2, &columns)); // 0: 0-10, 1: 10-12, 0: 12-22
+	EXPECT_EQ(1U, preemptions[0]);
+	EXPECT_EQ(0U, preemptions[1]);
+	EXPECT_EQ(10UL, firstDispatch[1]);
+	EXPECT_EQ(22UL, completion[0]);
+	dyn_array_destroy(ready_queue);
+}
+
+// Preemptive priority worked out tick by tick with linear scans: every tick the waiting pcbs age, and the running
+// pcb is checked against the best of them
+// \return the completion time of every pcb, indexed like pcbs
+static std::vector<uint64_t> priority_preemptive_oracle(const std::vector<ProcessControlBlock_t> &pcbs, uint64_t aging)
+{
+	const std::vector<size_t> order = arrival_ranks(pcbs);
+	const size_t n = pcbs.size();
+	std::vector<uint64_t> key(n, 0), completion(n, 0); // priority * aging + time queued, so older is better
+	std::vector<uint32_t> remaining(n, 0);
+	std::vector<bool> waiting(n, false);
+	uint64_t now = 0, runningKey = 0, dispatched = 0;
+	size_t arrived = 0, done = 0, running = n;
+
+	while (done < n)
+	{
+		for (; arrived < n && pcbs[order[arrived]].arrival <= now; arrived++)
+		{
+			remaining[arrived] = pcbs[order[arrived]].remaining_burst_time;
+			key[arrived] = aging ? pcbs[order[arrived]].priority * aging + now : pcbs[order[arrived]].priority;
+			waiting[arrived] = true;
+		}
+
+		size_t best = n;
+		for (size_t r = 0; r < arrived; r++)
+		{
+			best = waiting[r] && (best == n || key[r] < key[best]) ? r : best;
+		}
+
+		if (running != n && best != n)
+		{
+			uint64_t current = runningKey + (aging ? now - dispatched : 0); // the running pcb doesn't age
+			if (aging ? key[best] + aging <= current : key[best] < current)
+			{
+				key[running] = current;
+				waiting[running] = true;
+				running = n;
+			}
+		}
+		if (running == n && best != n)
+		{
+			running = best;
+			waiting[best] = false;
+			runningKey = key[best];
+			dispatched = now;
+		}
+
+		if (running == n)
+		{
+			now++;
+			continue;
+		}
+		if (remaining[running] > 0)
+		{
+			now++;
+			remaining[running]--;
+		}
+		if (remaining[running] == 0)
+		{
+			completion[order[running]] = now;
+			running = n;
+			done++;
+		}
+	}
+	return completion;
+}
+
+TEST (priority_preemptive, MatchesOracle) // a few hundred pcbs, with and without aging, against the tick by tick version
+{
+	const uint32_t agings[] = {0, 1, 3, 25};
+
+	for (uint32_t aging : agings)
+	{
+		dyn_array_t* ready_queue = random_ready_queue(300, 29, 20, 12);
+		std::vector<ProcessControlBlock_t> pcbs = pcbs_of(ready_queue);
+		std::vector<uint64_t> completion(pcbs.size());
+		ScheduleColumns_t columns = {NULL, completion.data(), NULL, NULL, NULL};
+		ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+			.waiting_latency = {}, .turnaround_latency = {}};
+
+		EXPECT_EQ(true, priority_preemptive(ready_queue, &result, aging, &columns));
+		expect_completions(pcbs, priority_preemptive_oracle(pcbs, aging), completion.data(), result);
+
+		dyn_array_destroy(ready_queue);
+	}
+}
+
+
+/*
+*  Earliest deadline first UNIT TEST CASES
+**/
+
+TEST (earliest_deadline_first, NULLParams)
+{
+	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+		.waiting_latency = {}, .turnaround_latency = {}};
+	EXPECT_EQ(false, earliest_deadline_first(NULL, &result, true));
+
+	dyn_array_t* ready_queue = random_ready_queue(10, 3, 10, 20);
+	EXPECT_EQ(false, earliest_deadline_first(ready_queue, NULL, false));
+	dyn_array_destroy(ready_queue);
+
+	ready_queue = dyn_array_create(3, sizeof(ProcessControlBlock_t), NULL);
+	EXPECT_EQ(false, earliest_deadline_first(ready_queue, &result, true));
+	dyn_array_destroy(ready_queue);
+}
+
+TEST (earliest_deadline_first, NonPreemptive) // the long pcb holds the CPU and both urgent ones miss
+{
+	ProcessControlBlock_t newPCB1 = {.remaining_burst_time = 4, .priority = 1, .arrival = 0, .deadline = 10, .started = false};
+	ProcessControlBlock_t newPCB2 = {.remaining_burst_time = 3, .priority = 1, .arrival = 1, .deadline = 5, .started = false};
+	ProcessControlBlock_t newPCB3 = {.remaining_burst_time = 2, .priority = 1, .arrival = 1, .deadline = 4, .started = false};
+	
+	dyn_array_t* ready_queue = dyn_array_create(3, sizeof(ProcessControlBlock_t), NULL);
+	
+	dyn_array_push_back(ready_queue, &newPCB1);
+	dyn_array_push_back(ready_queue, &newPCB2);
+	dyn_array_push_back(ready_queue, &newPCB3);
+	
+	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+		.waiting_latency = {}, .turnaround_latency = {}};
+	
+	EXPECT_EQ(true, earliest_deadline_first(ready_queue, &result, false));
+	
+	EXPECT_EQ(result.total_run_time, 9UL);
+	EXPECT_NEAR(result.average_waiting_time, 2.67, 0.01);
+	EXPECT_NEAR(result.average_turnaround_time, 5.67, 0.01);
+	EXPECT_EQ(result.deadline_misses, 2UL);
+	EXPECT_EQ(result.max_lateness, 4L);
+	
+	dyn_array_destroy(ready_queue);
+}
+
+TEST (earliest_deadline_first, Preemptive) // the same pcbs, now only one misses
+{
+	ProcessControlBlock_t newPCB1 = {.remaining_burst_time = 4, .priority = 1, .arrival = 0, .deadline = 10, .started = false};
+	ProcessControlBlock_t newPCB2 = {.remaining_burst_time = 3, .priority = 1, .arrival = 1, .deadline = 5, .started = false};
+	ProcessControlBlock_t newPCB3 = {.remaining_burst_time = 2, .priority = 1, .arrival = 1, .deadline = 4, .started = false};
+	
+	dyn_array_t* ready_queue = dyn_array_create(3, sizeof(ProcessControlBlock_t), NULL);
+	
+	dyn_array_push_back(ready_queue, &newPCB1);
+	dyn_array_push_back(ready_queue, &newPCB2);
+	dyn_array_push_back(ready_queue, &newPCB3);
+	
+	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+		.waiting_latency = {}, .turnaround_latency = {}};
+	
+	EXPECT_EQ(true, earliest_deadline_first(ready_queue, &result, true));
+	
+	EXPECT_EQ(result.total_run_time, 9UL);
+	EXPECT_NEAR(result.average_waiting_time, 2.33, 0.01);
+	EXPECT_NEAR(result.average_turnaround_time, 5.33, 0.01);
+	EXPECT_EQ(result.deadline_misses, 1UL);
+	EXPECT_EQ(result.max_lateness, 1L);
+	
+	dyn_array_destroy(ready_queue);
+}
+
+TEST (earliest_deadline_first, NoDeadlineRunsLast) // and doesn't count towards misses or lateness
+{
+	ProcessControlBlock_t newPCB1 = {.remaining_burst_time = 5, .priority = 1, .arrival = 0, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB2 = {.remaining_burst_time = 2, .priority = 1, .arrival = 0, .deadline = 20, .started = false};
+	
+	dyn_array_t* ready_queue = dyn_array_create(2, sizeof(ProcessControlBlock_t), NULL);
+	
+	dyn_array_push_back(ready_queue, &newPCB1);
+	dyn_array_push_back(ready_queue, &newPCB2);
+	
+	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+		.waiting_latency = {}, .turnaround_latency = {}};
+	
+	EXPECT_EQ(true, earliest_deadline_first(ready_queue, &result, false));
+	
+	EXPECT_EQ(result.total_run_time, 7UL);
+	EXPECT_NEAR(result.average_waiting_time, 1.00, 0.01);
+	EXPECT_NEAR(result.average_turnaround_time, 4.50, 0.01);
+	EXPECT_EQ(result.deadline_misses, 0UL);
+	EXPECT_EQ(result.max_lateness, -18L);
+	
+	dyn_array_destroy(ready_queue);
+}
+
+// Earliest deadline first worked out tick by tick with linear scans; preemptive, an arrival that orders before the
+// running pcb by (deadline, arrival rank) takes the cpu
+// \return the completion time of every pcb, indexed like pcbs
+static std::vector<uint64_t> edf_oracle(const std::vector<ProcessControlBlock_t> &pcbs, bool preemptive)
+{
+	const std::vector<size_t> order = arrival_ranks(pcbs);
+	const size_t n = pcbs.size();
+	std::vector<uint64_t> completion(n, 0);
+	std::vector<uint32_t> remaining(n, 0);
+	std::vector<bool> waiting(n, false);
+	uint64_t now = 0;
+	size_t arrived = 0, done = 0, running = n;
+
+	auto before = [&](size_t a, size_t b) // no deadline sorts last
+	{
+		uint64_t da = pcbs[order[a]].deadline ? pcbs[order[a]].deadline : UINT64_MAX;
+		uint64_t db = pcbs[order[b]].deadline ? pcbs[order[b]].deadline : UINT64_MAX;
+		return da < db || (da == db && a < b);
+	};
+
+	while (done < n)
+	{
+		for (; arrived < n && pcbs[order[arrived]].arrival <= now; arrived++)
+		{
+			remaining[arrived] = pcbs[order[arrived]].remaining_burst_time;
+			waiting[arrived] = true;
+		}
+
+		size_t best = n;
+		for (size_t r = 0; r < arrived; r++)
+		{
+			best = waiting[r] && (best == n || before(r, best)) ? r : best;
+		}
+
+		if (preemptive && running != n && best != n && before(best, running))
+		{
+			waiting[running] = true;
+			running = n;
+		}
+		if (running == n && best != n)
+		{
+			running = best;
+			waiting[best] = false;
+		}
+
+		if (running == n)
+		{
+			now++;
+			continue;
+		}
+		if (remaining[running] > 0)
+		{
+			now++;
+			remaining[running]--;
+		}
+		if (remaining[running] == 0)
+		{
+			completion[order[running]] = now;
+			running = n;
+			done++;
+		}
+	}
+	return completion;
+}
+
+TEST (earliest_deadline_first, MatchesOracle) // a few hundred overloaded pcbs, some without a deadline, both modes against the tick by tick version
+{
+	for (int preemptive = 0; preemptive < 2; preemptive++)
+	{
+		dyn_array_t* ready_queue = random_ready_queue(300, 31, 20, 12);
+		std::vector<ProcessControlBlock_t> pcbs = pcbs_of(ready_queue);
+		std::vector<uint64_t> completion(pcbs.size());
+		ScheduleColumns_t columns = {NULL, completion.data(), NULL, NULL, NULL};
+		ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+			.waiting_latency = {}, .turnaround_latency = {}};
+
+		for (size_t i = 0; i < pcbs.size(); i++) // every fifth pcb has no deadline
+		{
+			pcbs[i].deadline = i % 5 ? pcbs[i].arrival + 2 * pcbs[i].remaining_burst_time + 1 + (uint32_t)(i % 7) : 0;
+		}
+		dyn_array_destroy(ready_queue);
+		ready_queue = dyn_array_import(pcbs.data(), pcbs.size(), sizeof(ProcessControlBlock_t), NULL);
+
+		EXPECT_EQ(true, schedule_algorithm(ready_queue, &result, preemptive ? SCHEDULE_EDF_PREEMPTIVE : SCHEDULE_EDF, 0, &columns));
+		std::vector<uint64_t> expected = edf_oracle(pcbs, preemptive);
+		expect_completions(pcbs, expected, completion.data(), result);
+
+		unsigned long misses = 0;
+		long lateness = LONG_MIN;
+		for (size_t i = 0; i < pcbs.size(); i++)
+		{
+			if (pcbs[i].deadline)
+			{
+				misses += expected[i] > pcbs[i].deadline;
+				lateness = std::max(lateness, (long)expected[i] - (long)pcbs[i].deadline);
+			}
+		}
+		EXPECT_GT(misses, 0UL);
+		EXPECT_EQ(misses, result.deadline_misses);
+		EXPECT_EQ(lateness, result.max_lateness);
+
+		dyn_array_destroy(ready_queue);
+	}
+}
+
+
+/*
+*  Multi-level feedback queue UNIT TEST CASES
+**/
+
+TEST (multi_level_feedback_queue, BadParams)
+{
+	const size_t quanta[] = {2, 0};
+	MlfqConfig_t config = {.levels = 2, .quanta = quanta, .boost_period = 0};
+	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+		.waiting_latency = {}, .turnaround_latency = {}};
+	dyn_array_t* ready_queue = random_ready_queue(10, 3, 10, 20);
+
+	EXPECT_EQ(false, multi_level_feedback_queue(NULL, &result, &config, NULL));
+	EXPECT_EQ(false, multi_level_feedback_queue(ready_queue, NULL, &config, NULL));
+	EXPECT_EQ(false, multi_level_feedback_queue(ready_queue, &result, NULL, NULL));
+	EXPECT_EQ(false, multi_level_feedback_queue(ready_queue, &result, &config, NULL)); // zero quantum on level 1
+	config.levels = 0;
+	EXPECT_EQ(false, multi_level_feedback_queue(ready_queue, &result, &config, NULL));
+	config.levels = MLFQ_MAX_LEVELS + 1;
+	EXPECT_EQ(false, multi_level_feedback_queue(ready_queue, &result, &config, NULL));
+
+	dyn_array_destroy(ready_queue);
+}
+
+TEST (multi_level_feedback_queue, DemotionAndPreemption) // the long pcb sinks to level 2, the short ones preempt it
+{
+	const size_t quanta[] = {2, 4, 8};
+	MlfqConfig_t config = {.levels = 3, .quanta = quanta, .boost_period = 0};
+
+	ProcessControlBlock_t newPCB1 = {.remaining_burst_time = 10, .priority = 1, .arrival = 0, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB2 = {.remaining_burst_time = 3, .priority = 1, .arrival = 4, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB3 = {.remaining_burst_time = 1, .priority = 1, .arrival = 5, .deadline = 0, .started = false};
+	
+	dyn_array_t* ready_queue = dyn_array_create(3, sizeof(ProcessControlBlock_t), NULL);
+	
+	dyn_array_push_back(ready_queue, &newPCB1);
+	dyn_array_push_back(ready_queue, &newPCB2);
+	dyn_array_push_back(ready_queue, &newPCB3);
+	
+	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+		.waiting_latency = {}, .turnaround_latency = {}};
+	
+	EXPECT_EQ(true, multi_level_feedback_queue(ready_queue, &result, &config, NULL));
+	
+	EXPECT_EQ(result.total_run_time, 14UL);
+	EXPECT_NEAR(result.average_waiting_time, 2.67, 0.01);
+	EXPECT_NEAR(result.average_turnaround_time, 7.33, 0.01);
+	
+	dyn_array_destroy(ready_queue);
+}
+
+TEST (multi_level_feedback_queue, PriorityBoost) // without the boost the long pcb waits for every short one
+{
+	const size_t quanta[] = {2, 100};
+	MlfqConfig_t config = {.levels = 2, .quanta = quanta, .boost_period = 0};
+	const ProcessControlBlock_t pcbs[] = {
+		{.remaining_burst_time = 6, .priority = 1, .arrival = 0, .deadline = 0, .started = false},
+		{.remaining_burst_time = 2, .priority = 1, .arrival = 2, .deadline = 0, .started = false},
+		{.remaining_burst_time = 2, .priority = 1, .arrival = 4, .deadline = 0, .started = false},
+		{.remaining_burst_time = 2, .priority = 1, .arrival = 6, .deadline = 0, .started = false},
+		{.remaining_burst_time = 2, .priority = 1, .arrival = 8, .deadline = 0, .started = false}};
+
+	dyn_array_t* ready_queue = dyn_array_import(pcbs, 5, sizeof(ProcessControlBlock_t), NULL);
+	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+		.waiting_latency = {}, .turnaround_latency = {}};
+
+	EXPECT_EQ(true, multi_level_feedback_queue(ready_queue, &result, &config, NULL));
+	EXPECT_EQ(result.total_run_time, 14UL);
+	EXPECT_NEAR(result.average_waiting_time, 1.60, 0.01);
+	EXPECT_NEAR(result.average_turnaround_time, 4.40, 0.01);
+	dyn_array_destroy(ready_queue);
+
+	config.boost_period = 4;
+	ready_queue = dyn_array_import(pcbs, 5, sizeof(ProcessControlBlock_t), NULL);
+
+	EXPECT_EQ(true, multi_level_feedback_queue(ready_queue, &result, &config, NULL));
+	EXPECT_EQ(result.total_run_time, 14UL);
+	EXPECT_NEAR(result.average_waiting_time, 2.40, 0.01);
+	EXPECT_NEAR(result.average_turnaround_time, 5.20, 0.01);
+	dyn_array_destroy(ready_queue);
+}
+
+TEST (multi_level_feedback_queue, PreemptionColumns) // demotions and higher level arrivals both count
+{
+	const size_t quanta[] = {2, 4, 8};
+	MlfqConfig_t config = {.levels = 3, .quanta = quanta, .boost_period = 0};
+	const ProcessControlBlock_t pcbs[] = {
+		{.remaining_burst_time = 10, .priority = 1, .arrival = 0, .deadline = 0, .started = false},
+		{.remaining_burst_time = 3, .priority = 1, .arrival = 4, .deadline = 0, .started = false},
+		{.remaining_burst_time = 1, .priority = 1, .arrival = 5, .deadline = 0, .started = false}};
+	dyn_array_t* ready_queue = dyn_array_import(pcbs, 3, sizeof(ProcessControlBlock_t), NULL);
+	uint64_t firstDispatch[3], completion[3];
+	uint32_t preemptions[3];
+	ScheduleColumns_t columns = {firstDispatch, completion, NULL, NULL, preemptions};
+	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+		.waiting_latency = {}, .turnaround_latency = {}};
+
+	EXPECT_EQ(true, multi_level_feedback_queue(ready_queue, &result, &config, &columns)); // 0: 0-2, 0-4, 1: 4-6, 2: 6-7, 0: 7-9, 1: 9-10, 0: 10-14
+
+	EXPECT_EQ(3U, preemptions[0]);
+	EXPECT_EQ(1U, preemptions[1]);
+	EXPECT_EQ(0U, preemptions[2]);
+	EXPECT_EQ(6UL, firstDispatch[2]);
+	EXPECT_EQ(14UL, completion[0]);
+	EXPECT_EQ(10UL, completion[1]);
+
+	dyn_array_destroy(ready_queue);
+}
+
+TEST (multi_level_feedback_queue, OneLevelIsRoundRobin) // large trace, no boost
+{
+	const size_t quanta[] = {QUANTUM};
+	MlfqConfig_t config = {.levels = 1, .quanta = quanta, .boost_period = 0};
+	dyn_array_t* rr_queue = random_ready_queue(500000, 19, 100, 60);
+	dyn_array_t* mlfq_queue = random_ready_queue(500000, 19, 100, 60);
+
+	ScheduleResult_t expected = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+		.waiting_latency = {}, .turnaround_latency = {}};
+	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+		.waiting_latency = {}, .turnaround_latency = {}};
+
+	EXPECT_EQ(true, round_robin(rr_queue, &expected, QUANTUM));
+	EXPECT_EQ(true, multi_level_feedback_queue(mlfq_queue, &result, &config, NULL));
+
+	EXPECT_EQ(expected.total_run_time, result.total_run_time);
+	EXPECT_EQ(expected.average_waiting_time, result.average_waiting_time);
+	EXPECT_EQ(expected.average_turnaround_time, result.average_turnaround_time);
+
+	dyn_array_destroy(rr_queue);
+	dyn_array_destroy(mlfq_queue);
+}
+
+
+/*
+*  Red-black tree UNIT TEST CASES
+**/
+
+// Checks the subtree under node: parent links, (key, rank) order within [low, high), no red child of a red node
+// \return the subtree's black height, counting the NULL leaves, and adds its nodes to count
+static size_t rb_check_subtree(const RbNode_t *node, const RbNode_t *parent, const RbNode_t *low, const RbNode_t *high, size_t *count)
+{
+	if (node == NULL)
+	{
+		return 1;
+	}
+
+	(*count)++;
+	EXPECT_EQ(parent, node->parent);
+	EXPECT_TRUE(low == NULL || low->key < node->key || (low->key == node->key && low->rank < node->rank));
+	EXPECT_TRUE(high == NULL || node->key < high->key || (node->key == high->key && node->rank < high->rank));
+	EXPECT_FALSE(node->red && parent != NULL && parent->red);
+
+	size_t left = rb_check_subtree(node->left, node, low, node, count);
+	size_t right = rb_check_subtree(node->right, node, node, high, count);
+	EXPECT_EQ(left, right);
+	return left + (node->red ? 0 : 1);
+}
+
+// Checks every red-black invariant of tree, and that its cached leftmost and size are right
+static void rb_check(const RbTree_t *tree)
+{
+	size_t count = 0;
+
+	EXPECT_FALSE(tree->root != NULL && tree->root->red);
+	rb_check_subtree(tree->root, NULL, NULL, NULL, &count);
+	EXPECT_EQ(tree->size, count);
+
+	const RbNode_t *leftmost = tree->root;
+	while (leftmost != NULL && leftmost->left != NULL)
+	{
+		leftmost = leftmost->left;
+	}
+	EXPECT_EQ(leftmost, rb_tree_first(tree));
+}
+
+TEST (rb_tree, Invariants) // random inserts and erases, duplicate keys included, checked after every one
+{
+	std::vector<RbNode_t> nodes(600);
+	std::vector<bool> linked(nodes.size(), false);
+	uint64_t state = 41;
+	RbTree_t tree;
+
+	rb_tree_init(&tree);
+	rb_check(&tree);
+	EXPECT_EQ(NULL, rb_tree_first(&tree));
+
+	for (int step = 0; step < 6000; step++)
+	{
+		state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+		size_t i = (size_t)(state >> 33) % nodes.size();
+
+		if (linked[i])
+		{
+			rb_tree_erase(&tree, &nodes[i]);
+		}
+		else
+		{
+			nodes[i].key = (state >> 20) % 50; // plenty of equal keys, told apart by rank
+			nodes[i].rank = i;
+			rb_tree_insert(&tree, &nodes[i]);
+		}
+		linked[i] = !linked[i];
+		rb_check(&tree);
+	}
+
+	while (tree.root != NULL) // drain it smallest first, like a scheduler would
+	{
+		RbNode_t *first = rb_tree_first(&tree);
+		for (size_t i = 0; i < nodes.size(); i++)
+		{
+			EXPECT_FALSE(linked[i] && (nodes[i].key < first->key || (nodes[i].key == first->key && nodes[i].rank < first->rank)));
+		}
+		rb_tree_erase(&tree, first);
+		linked[first->rank] = false;
+		rb_check(&tree);
+	}
+	EXPECT_EQ(0U, tree.size);
+}
+
+
+/*
+*  Completely fair scheduler UNIT TEST CASES
+**/
+
+TEST (completely_fair_scheduler, BadParams)
+{
+	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+		.waiting_latency = {}, .turnaround_latency = {}};
+	dyn_array_t* ready_queue = random_ready_queue(10, 3, 10, 20);
+
+	EXPECT_EQ(false, completely_fair_scheduler(NULL, &result, 4, 1, NULL));
+	EXPECT_EQ(false, completely_fair_scheduler(ready_queue, NULL, 4, 1, NULL));
+	EXPECT_EQ(false, completely_fair_scheduler(ready_queue, &result, 0, 1, NULL));
+	EXPECT_EQ(false, completely_fair_scheduler(ready_queue, &result, 4, 0, NULL));
+
+	dyn_array_destroy(ready_queue);
+}
+
+TEST (completely_fair_scheduler, EqualWeightsShareEvenly) // two nice 0 pcbs split a latency of 4 into slices of 2
+{
+	ProcessControlBlock_t newPCB1 = {.remaining_burst_time = 6, .priority = 20, .arrival = 0, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB2 = {.remaining_burst_time = 6, .priority = 20, .arrival = 0, .deadline = 0, .started = false};
+	
+	dyn_array_t* ready_queue = dyn_array_create(2, sizeof(ProcessControlBlock_t), NULL);
+	
+	dyn_array_push_back(ready_queue, &newPCB1);
+	dyn_array_push_back(ready_queue, &newPCB2);
+	
+	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+		.waiting_latency = {}, .turnaround_latency = {}};
+	
+	EXPECT_EQ(true, completely_fair_scheduler(ready_queue, &result, 4, 1, NULL));
+	
+	EXPECT_EQ(result.total_run_time, 12UL);
+	EXPECT_NEAR(result.average_waiting_time, 5.00, 0.01);
+	EXPECT_NEAR(result.average_turnaround_time, 11.00, 0.01);
+	
+	dyn_array_destroy(ready_queue);
+}
+
+TEST (completely_fair_scheduler, WeightFromPriority) // nice 0 against nice 5, the heavier pcb gets three units per one
+{
+	ProcessControlBlock_t newPCB1 = {.remaining_burst_time = 10, .priority = 20, .arrival = 0, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB2 = {.remaining_burst_time = 10, .priority = 25, .arrival = 0, .deadline = 0, .started = false};
+	
+	dyn_array_t* ready_queue = dyn_array_create(2, sizeof(ProcessControlBlock_t), NULL);
+	
+	dyn_array_push_back(ready_queue, &newPCB1);
+	dyn_array_push_back(ready_queue, &newPCB2);
+	
+	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+		.waiting_latency = {}, .turnaround_latency = {}};
+	
+	EXPECT_EQ(true, completely_fair_scheduler(ready_queue, &result, 4, 1, NULL));
+	
+	EXPECT_EQ(result.total_run_time, 20UL);
+	EXPECT_NEAR(result.average_waiting_time, 6.50, 0.01);
+	EXPECT_NEAR(result.average_turnaround_time, 16.50, 0.01);
+	
+	dyn_array_destroy(ready_queue);
+}
+
+TEST (completely_fair_scheduler, PreemptionColumns) // slices of 2 out of 6, every slice but the last ends in a preemption
+{
+	const ProcessControlBlock_t pcbs[] = {
+		{.remaining_burst_time = 6, .priority = 20, .arrival = 0, .deadline = 0, .started = false},
+		{.remaining_burst_time = 6, .priority = 20, .arrival = 0, .deadline = 0, .started = false}};
+	dyn_array_t* ready_queue = dyn_array_import(pcbs, 2, sizeof(ProcessControlBlock_t), NULL);
+	uint64_t firstDispatch[2], completion[2];
+	uint32_t preemptions[2];
+	ScheduleColumns_t columns = {firstDispatch, completion, NULL, NULL, preemptions};
+	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+		.waiting_latency = {}, .turnaround_latency = {}};
+
+	EXPECT_EQ(true, completely_fair_scheduler(ready_queue, &result, 4, 1, &columns));
+
+	EXPECT_EQ(2U, preemptions[0]);
+	EXPECT_EQ(2U, preemptions[1]);
+	EXPECT_EQ(0UL, firstDispatch[0]);
+	EXPECT_EQ(2UL, firstDispatch[1]);
+	EXPECT_EQ(10UL, completion[0]);
+	EXPECT_EQ(12UL, completion[1]);
+
+	dyn_array_destroy(ready_queue);
+}
+
+// Completely fair scheduler worked out tick by tick with linear scans, straight from its notes
+// \return the completion time of every pcb, indexed like pcbs
+static std::vector<uint64_t> cfs_oracle(const std::vector<ProcessControlBlock_t> &pcbs, uint64_t targetLatency, uint64_t minGranularity)
+{
+	static const uint64_t weights[40] = {88761, 71755, 56483, 46273, 36291, 29154, 23254, 18705, 14949, 11916, 9548, 7620, 6100, 4904,
+		3906, 3121, 2501, 1991, 1586, 1277, 1024, 820, 655, 526, 423, 335, 272, 215, 172, 137, 110, 87, 70, 56, 45, 36, 29, 23, 18, 15};
+	const std::vector<size_t> order = arrival_ranks(pcbs);
+	const size_t n = pcbs.size();
+	std::vector<uint64_t> vruntime(n, 0), completion(n, 0);
+	std::vector<uint32_t> remaining(n, 0);
+	std::vector<bool> runnable(n, false);
+	std::vector<size_t> held; // arrived during a slice
+	uint64_t now = 0, minVruntime = 0, totalWeight = 0;
+	size_t arrived = 0, done = 0;
+
+	auto weight = [&](size_t rank) { return weights[std::min<uint32_t>(pcbs[order[rank]].priority, 39)]; };
+	auto admit = [&](bool hold)
+	{
+		for (; arrived < n && pcbs[order[arrived]].arrival <= now; arrived++)
+		{
+			remaining[arrived] = pcbs[order[arrived]].remaining_burst_time;
+			totalWeight += weight(arrived);
+			if (hold)
+			{
+				held.push_back(arrived);
+			}
+			else
+			{
+				vruntime[arrived] = minVruntime;
+				runnable[arrived] = true;
+			}
+		}
+	};
+
+	while (done < n)
+	{
+		admit(false);
+		size_t next = n, count = 0;
+		for (size_t r = 0; r < arrived; r++)
+		{
+			if (runnable[r])
+			{
+				count++;
+				next = next == n || vruntime[r] < vruntime[next] ? r : next;
+			}
+		}
+		if (next == n)
+		{
+			now++;
+			continue;
+		}
+
+		runnable[next] = false;
+		uint64_t period = count > targetLatency / minGranularity ? count * minGranularity : targetLatency;
+		uint64_t slice = std::max(period * weight(next) / totalWeight, minGranularity);
+		uint32_t ran = 0;
+		for (; ran < slice && ran < remaining[next]; ran++)
+		{
+			now++;
+			admit(true);
+		}
+
+		vruntime[next] += (uint64_t)ran * 1024 * 64 / weight(next);
+		remaining[next] -= ran;
+		if (remaining[next] == 0)
+		{
+			completion[order[next]] = now;
+			totalWeight -= weight(next);
+			done++;
+		}
+
+		uint64_t fairest = remaining[next] ? vruntime[next] : UINT64_MAX;
+		for (size_t r = 0; r < arrived; r++)
+		{
+			fairest = runnable[r] ? std::min(fairest, vruntime[r]) : fairest;
+		}
+		minVruntime = fairest != UINT64_MAX ? std::max(minVruntime, fairest) : minVruntime;
+
+		for (size_t r : held)
+		{
+			vruntime[r] = minVruntime;
+			runnable[r] = true;
+		}
+		held.clear();
+		runnable[next] = remaining[next] > 0;
+	}
+	return completion;
+}
+
+TEST (completely_fair_scheduler, MatchesOracle) // a few hundred pcbs, overloaded and with idle gaps, against the tick by tick version
+{
+	const size_t latencies[][2] = {{24, 3}, {6, 4}, {1, 1}};
+
+	for (const size_t *latency : latencies)
+	{
+		dyn_array_t* ready_queue = random_ready_queue(300, 23, 20, 12);
+		std::vector<ProcessControlBlock_t> pcbs = pcbs_of(ready_queue);
+		std::vector<uint64_t> completion(pcbs.size());
+		ScheduleColumns_t columns = {NULL, completion.data(), NULL, NULL, NULL};
+		ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+			.waiting_latency = {}, .turnaround_latency = {}};
+
+		for (ProcessControlBlock_t &pcb : pcbs) // spread the weights over every nice level
+		{
+			pcb.priority = (pcb.priority * 7 + pcb.arrival) % 40;
+		}
+		dyn_array_destroy(ready_queue);
+		ready_queue = dyn_array_import(pcbs.data(), pcbs.size(), sizeof(ProcessControlBlock_t), NULL);
+
+		EXPECT_EQ(true, completely_fair_scheduler(ready_queue, &result, latency[0], latency[1], &columns));
+		expect_completions(pcbs, cfs_oracle(pcbs, latency[0], latency[1]), completion.data(), result);
+
+		dyn_array_destroy(ready_queue);
+	}
+}
+
+
+/*
+*  Stride scheduling UNIT TEST CASES
+**/
+
+TEST (stride_scheduling, BadParams)
+{
+	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+		.waiting_latency = {}, .turnaround_latency = {}};
+	dyn_array_t* ready_queue = random_ready_queue(10, 3, 10, 20);
+
+	EXPECT_EQ(false, stride_scheduling(NULL, &result, QUANTUM, NULL));
+	EXPECT_EQ(false, stride_scheduling(ready_queue, NULL, QUANTUM, NULL));
+	EXPECT_EQ(false, stride_scheduling(ready_queue, &result, 0, NULL));
+
+	dyn_array_destroy(ready_queue);
+}
+
+TEST (stride_scheduling, ProportionalShare) // three tickets against one, three quanta for every one
+{
+	ProcessControlBlock_t newPCB1 = {.remaining_burst_time = 6, .priority = 3, .arrival = 0, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB2 = {.remaining_burst_time = 2, .priority = 1, .arrival = 0, .deadline = 0, .started = false};
+	
+	dyn_array_t* ready_queue = dyn_array_create(2, sizeof(ProcessControlBlock_t), NULL);
+	
+	dyn_array_push_back(ready_queue, &newPCB1);
+	dyn_array_push_back(ready_queue, &newPCB2);
+	
+	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+		.waiting_latency = {}, .turnaround_latency = {}};
+	
+	EXPECT_EQ(true, stride_scheduling(ready_queue, &result, 1, NULL));
+	
+	EXPECT_EQ(result.total_run_time, 8UL);
+	EXPECT_NEAR(result.average_waiting_time, 3.50, 0.01);
+	EXPECT_NEAR(result.average_turnaround_time, 7.50, 0.01);
+	
+	dyn_array_destroy(ready_queue);
+}
+
+TEST (stride_scheduling, TicketRatio) // two pcbs get the cpu in the ratio of their tickets to within a quantum, with millions of tickets too
+{
+	const uint32_t cases[][5] = {{3, 1, 3, 1, 1}, {5, 2, 5, 2, 3}, {3000000, 1000000, 3, 1, 1}, {5u << 21, 2u << 21, 5, 2, 4}}; // tickets, ratio, quantum
+
+	for (const uint32_t *ratio : cases)
+	{
+		const uint32_t quantum = ratio[4];
+		const ProcessControlBlock_t pcbs[] = {
+			{.remaining_burst_time = 60 * ratio[2] * quantum, .priority = ratio[0], .arrival = 0, .deadline = 0, .started = false},
+			{.remaining_burst_time = 120 * ratio[3] * quantum, .priority = ratio[1], .arrival = 0, .deadline = 0, .started = false}};
+		dyn_array_t* ready_queue = dyn_array_import(pcbs, 2, sizeof(ProcessControlBlock_t), NULL);
+		uint64_t completion[2];
+		ScheduleColumns_t columns = {NULL, completion, NULL, NULL, NULL};
+		ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+			.waiting_latency = {}, .turnaround_latency = {}};
+
+		EXPECT_EQ(true, stride_scheduling(ready_queue, &result, quantum, &columns));
+		// by the time the first pcb has had its 60 * ratio quanta, the second should have had 60 * its ratio
+		EXPECT_NEAR((double)completion[0], 60.0 * (ratio[2] + ratio[3]) * quantum, quantum) << ratio[0] << " against " << ratio[1];
+
+		dyn_array_destroy(ready_queue);
+	}
+}
+
+TEST (stride_scheduling, PreemptionColumns) // every quantum but a pcb's last ends in a preemption, even when it runs again straight away
+{
+	const ProcessControlBlock_t pcbs[] = {
+		{.remaining_burst_time = 6, .priority = 3, .arrival = 0, .deadline = 0, .started = false},
+		{.remaining_burst_time = 2, .priority = 1, .arrival = 0, .deadline = 0, .started = false}};
+	dyn_array_t* ready_queue = dyn_array_import(pcbs, 2, sizeof(ProcessControlBlock_t), NULL);
+	uint64_t firstDispatch[2], completion[2];
+	uint32_t preemptions[2];
+	ScheduleColumns_t columns = {firstDispatch, completion, NULL, NULL, preemptions};
+	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+		.waiting_latency = {}, .turnaround_latency = {}};
+
+	EXPECT_EQ(true, stride_scheduling(ready_queue, &result, 1, &columns)); // 0: 0-3, 1: 3-4, 0: 4-7, 1: 7-8
+
+	EXPECT_EQ(5U, preemptions[0]);
+	EXPECT_EQ(1U, preemptions[1]);
+	EXPECT_EQ(3UL, firstDispatch[1]);
+	EXPECT_EQ(7UL, completion[0]);
+	EXPECT_EQ(8UL, completion[1]);
+
+	dyn_array_destroy(ready_queue);
+}
+
+// Stride scheduling worked out tick by tick with linear scans and plain 64-bit passes, which never need shifting down
+// on a trace this short
+// \return the completion time of every pcb, indexed like pcbs
+static std::vector<uint64_t> stride_oracle(const std::vector<ProcessControlBlock_t> &pcbs, uint64_t quantum)
+{
+	const std::vector<size_t> order = arrival_ranks(pcbs);
+	const size_t n = pcbs.size();
+	std::vector<uint64_t> pass(n, 0), completion(n, 0);
+	std::vector<uint32_t> remaining(n, 0);
+	std::vector<bool> waiting(n, false);
+	uint64_t now = 0, globalPass = 0;
+	size_t arrived = 0, done = 0;
+
+	auto stride = [&](size_t rank) { uint32_t tickets = pcbs[order[rank]].priority; return (UINT64_C(1) << 40) / (tickets ? tickets : 1); };
+	auto admit = [&]()
+	{
+		for (; arrived < n && pcbs[order[arrived]].arrival <= now; arrived++)
+		{
+			remaining[arrived] = pcbs[order[arrived]].remaining_burst_time;
+			pass[arrived] = globalPass + stride(arrived);
+			waiting[arrived] = true;
+		}
+	};
+
+	while (done < n)
+	{
+		admit();
+		size_t next = n;
+		for (size_t r = 0; r < arrived; r++)
+		{
+			next = waiting[r] && (next == n || pass[r] < pass[next]) ? r : next;
+		}
+		if (next == n)
+		{
+			now++;
+			continue;
+		}
+
+		waiting[next] = false;
+		globalPass = pass[next];
+		for (uint64_t ran = 0; ran < quantum && remaining[next] > 0; ran++)
+		{
+			now++;
+			remaining[next]--;
+			admit();
+		}
+
+		if (remaining[next] == 0)
+		{
+			completion[order[next]] = now;
+			done++;
+		}
+		else
+		{
+			pass[next] = globalPass + stride(next);
+			waiting[next] = true;
+		}
+	}
+	return completion;
+}
+
+TEST (stride_scheduling, MatchesOracle) // a few hundred pcbs, from no tickets to millions, against the tick by tick version
+{
+	const size_t quanta[] = {1, 3, 7};
+
+	for (size_t quantum : quanta)
+	{
+		dyn_array_t* ready_queue = random_ready_queue(300, 37, 20, 12);
+		std::vector<ProcessControlBlock_t> pcbs = pcbs_of(ready_queue);
+		std::vector<uint64_t> completion(pcbs.size());
+		ScheduleColumns_t columns = {NULL, completion.data(), NULL, NULL, NULL};
+		ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+			.waiting_latency = {}, .turnaround_latency = {}};
+
+		for (ProcessControlBlock_t &pcb : pcbs)
+		{
+			pcb.priority = pcb.priority * pcb.priority * 20000 + pcb.arrival % 3;
+		}
+		dyn_array_destroy(ready_queue);
+		ready_queue = dyn_array_import(pcbs.data(), pcbs.size(), sizeof(ProcessControlBlock_t), NULL);
+
+		EXPECT_EQ(true, stride_scheduling(ready_queue, &result, quantum, &columns));
+		expect_completions(pcbs, stride_oracle(pcbs, quantum), completion.data(), result);
+
+		dyn_array_destroy(ready_queue);
+	}
+}
+
+TEST (stride_scheduling, PassesShiftedDown) // one-ticket pcbs run past 2^23 quanta, so the passes are shifted down while several wait
+{
+	const std::vector<ProcessControlBlock_t> pcbs = {
+		{.remaining_burst_time = (1u << 23) + 50, .priority = 1, .arrival = 0, .deadline = 0, .started = false},
+		{.remaining_burst_time = 40, .priority = 1, .arrival = (1u << 23) - 30, .deadline = 0, .started = false},
+		{.remaining_burst_time = 40, .priority = 2, .arrival = (1u << 23) - 10, .deadline = 0, .started = false}};
+	dyn_array_t* ready_queue = dyn_array_import(pcbs.data(), pcbs.size(), sizeof(ProcessControlBlock_t), NULL);
+	std::vector<uint64_t> completion(pcbs.size());
+	ScheduleColumns_t columns = {NULL, completion.data(), NULL, NULL, NULL};
+	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+		.waiting_latency = {}, .turnaround_latency = {}};
+
+	EXPECT_EQ(true, stride_scheduling(ready_queue, &result, 1, &columns));
+	expect_completions(pcbs, stride_oracle(pcbs, 1), completion.data(), result);
+
+	dyn_array_destroy(ready_queue);
+}
+
+
+/*
+*  Policy core UNIT TEST CASES
+**/
+
+typedef std::pair<uint64_t, size_t> KeyedId; // (key, id), ordered like the ready heap
+typedef std::priority_queue<KeyedId, std::vector<KeyedId>, std::greater<KeyedId> > KeyedIdHeap;
+
+// Shortest Job First through the runtime vtable
+static bool sjf_on_arrival(void *state, const ProcessControlBlock_t *pcb, size_t id, uint32_t remaining, uint64_t now, size_t from)
+{
+	(void)remaining;
+	(void)now;
+	(void)from;
+	static_cast<KeyedIdHeap *>(state)->push(KeyedId(pcb->remaining_burst_time, id));
+	return true;
+}
+
+static bool sjf_select(void *state, size_t cpu, uint64_t now, size_t *id, uint64_t *slice)
+{
+	(void)cpu;
+	(void)now;
+	(void)slice; // runs to completion
+	KeyedIdHeap *ready = static_cast<KeyedIdHeap *>(state);
+	*id = ready->top().second;
+	ready->pop();
+	return true;
+}
+
+// Shortest Remaining Time First as a compile-time policy
+struct ShortestRemainingPolicy
+{
+	KeyedIdHeap ready;
+
+	bool on_arrival(const ProcessControlBlock_t *, size_t id, uint32_t remaining, uint64_t, size_t)
+	{
+		ready.push(KeyedId(remaining, id));
+		return true;
+	}
+	bool select(size_t, uint64_t, size_t *id, uint64_t *)
+	{
+		*id = ready.top().second;
+		ready.pop();
+		return true;
+	}
+	bool preempt(size_t, size_t running, uint32_t remaining, uint64_t, uint64_t *)
+	{
+		return !ready.empty() && ready.top() < KeyedId(remaining, running);
+	}
+	void on_complete(size_t, size_t, uint64_t) {}
+};
+
+// Round Robin as a compile-time policy
+struct RoundRobinPolicy
+{
+	std::deque<size_t> ready;
+	uint64_t quantum;
+
+	bool on_arrival(const ProcessControlBlock_t *, size_t id, uint32_t, uint64_t, size_t)
+	{
+		ready.push_back(id);
+		return true;
+	}
+	bool select(size_t, uint64_t, size_t *id, uint64_t *slice)
+	{
+		*id = ready.front();
+		*slice = quantum;
+		ready.pop_front();
+		return true;
+	}
+	bool preempt(size_t, size_t, uint32_t, uint64_t, uint64_t *slice) { return *slice == 0; }
+	void on_complete(size_t, size_t, uint64_t) {}
+};
+
+TEST (schedule_with_policy, BadParams)
+{
+	KeyedIdHeap ready;
+	SchedulePolicyOps_t ops = {sjf_on_arrival, NULL, NULL, NULL};
+	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+		.waiting_latency = {}, .turnaround_latency = {}};
+	dyn_array_t* ready_queue = random_ready_queue(10, 3, 10, 20);
+
+	EXPECT_EQ(false, schedule_with_policy(NULL, &result, &ops, &ready));
+	EXPECT_EQ(false, schedule_with_policy(ready_queue, NULL, &ops, &ready));
+	EXPECT_EQ(false, schedule_with_policy(ready_queue, &result, NULL, &ready));
+	EXPECT_EQ(false, schedule_with_policy(ready_queue, &result, &ops, &ready)); // no select
+
+	dyn_array_destroy(ready_queue);
+}
+
+TEST (schedule_with_policy, VtableMatchesShortestJobFirst)
+{
+	KeyedIdHeap ready;
+	SchedulePolicyOps_t ops = {sjf_on_arrival, sjf_select, NULL, NULL};
+	dyn_array_t* sequential_queue = random_ready_queue(100000, 41, 100, 60);
+	dyn_array_t* policy_queue = random_ready_queue(100000, 41, 100, 60);
+
+	ScheduleResult_t expected = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+		.waiting_latency = {}, .turnaround_latency = {}};
+	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+		.waiting_latency = {}, .turnaround_latency = {}};
+
+	EXPECT_EQ(true, shortest_job_first(sequential_queue, &expected));
+	EXPECT_EQ(true, schedule_with_policy(policy_queue, &result, &ops, &ready));
+
+	EXPECT_EQ(expected.total_run_time, result.total_run_time);
+	EXPECT_EQ(expected.average_waiting_time, result.average_waiting_time);
+	EXPECT_EQ(expected.average_turnaround_time, result.average_turnaround_time);
+	EXPECT_EQ(0UL, dyn_array_size(policy_queue));
+
+	dyn_array_destroy(sequential_queue);
+	dyn_array_destroy(policy_queue);
+}
+
+TEST (schedule_with_policy, TemplateMatchesShortestRemainingTimeFirst)
+{
+	ShortestRemainingPolicy policy;
+	dyn_array_t* sequential_queue = random_ready_queue(100000, 43, 100, 60);
+	dyn_array_t* policy_queue = random_ready_queue(100000, 43, 100, 60);
+
+	ScheduleResult_t expected = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+		.waiting_latency = {}, .turnaround_latency = {}};
+	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+		.waiting_latency = {}, .turnaround_latency = {}};
+
+	EXPECT_EQ(true, shortest_remaining_time_first(sequential_queue, &expected));
+	EXPECT_EQ(true, schedule_with(policy_queue, &result, policy));
+
+	EXPECT_EQ(expected.total_run_time, result.total_run_time);
+	EXPECT_EQ(expected.average_waiting_time, result.average_waiting_time);
+	EXPECT_EQ(expected.average_turnaround_time, result.average_turnaround_time);
+
+	dyn_array_destroy(sequential_queue);
+	dyn_array_destroy(policy_queue);
+}
+
+TEST (schedule_with_policy, TemplateMatchesRoundRobin) // slices and the order of requeues vs arrivals
+{
+	RoundRobinPolicy policy;
+	policy.quantum = QUANTUM;
+	dyn_array_t* sequential_queue = random_ready_queue(100000, 47, 100, 60);
+	dyn_array_t* policy_queue = random_ready_queue(100000, 47, 100, 60);
+
+	ScheduleResult_t expected = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+		.waiting_latency = {}, .turnaround_latency = {}};
+	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+		.waiting_latency = {}, .turnaround_latency = {}};
+
+	EXPECT_EQ(true, round_robin(sequential_queue, &expected, QUANTUM));
+	EXPECT_EQ(true, schedule_with(policy_queue, &result, policy));
+
+	EXPECT_EQ(expected.total_run_time, result.total_run_time);
+	EXPECT_EQ(expected.average_waiting_time, result.average_waiting_time);
+	EXPECT_EQ(expected.average_turnaround_time, result.average_turnaround_time);
+
+	dyn_array_destroy(sequential_queue);
+	dyn_array_destroy(policy_queue);
+}
+
+TEST (schedule_with_policy, PreemptKeepsTheCpu) // consulted at every slice end, a policy can hand out another slice instead
+{
+	struct UnitSliceFifo
+	{
+		std::deque<size_t> ready;
+		size_t consulted;
+		bool on_arrival(const ProcessControlBlock_t *, size_t id, uint32_t, uint64_t, size_t) { ready.push_back(id); return true; }
+		bool select(size_t, uint64_t, size_t *id, uint64_t *slice) { *id = ready.front(); ready.pop_front(); *slice = 1; return true; }
+		bool preempt(size_t, size_t, uint32_t, uint64_t, uint64_t *slice)
+		{
+			consulted += *slice == 0;
+			*slice = 1;
+			return false;
+		}
+		void on_complete(size_t, size_t, uint64_t) {}
+	}
+	policy;
+	policy.consulted = 0;
+	dyn_array_t* sequential_queue = random_ready_queue(10000, 53, 20, 60);
+	dyn_array_t* policy_queue = random_ready_queue(10000, 53, 20, 60);
+
+	ScheduleResult_t expected = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+		.waiting_latency = {}, .turnaround_latency = {}};
+	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+		.waiting_latency = {}, .turnaround_latency = {}};
+
+	EXPECT_EQ(true, first_come_first_serve(sequential_queue, &expected));
+	EXPECT_EQ(true, schedule_with(policy_queue, &result, policy));
+
+	EXPECT_EQ(expected.total_run_time, result.total_run_time);
+	EXPECT_EQ(expected.average_waiting_time, result.average_waiting_time);
+	EXPECT_EQ(expected.average_turnaround_time, result.average_turnaround_time);
+	EXPECT_GT(policy.consulted, 10000UL); // once per time unit run short of a completion
+
+	dyn_array_destroy(sequential_queue);
+	dyn_array_destroy(policy_queue);
+}
+
+
+/*
+*  Schedule session UNIT TEST CASES
+**/
+
+TEST (schedule_session, BadParams)
+{
+	EXPECT_EQ(nullptr, schedule_session_create(SCHEDULE_RR, 0)); // RR without a quantum
+	EXPECT_EQ(false, schedule_session_submit(NULL, NULL));
+	EXPECT_EQ(false, schedule_session_advance(NULL, 10));
+	EXPECT_EQ(false, schedule_session_snapshot(NULL, NULL));
+
+	schedule_session_t *session = schedule_session_create(SCHEDULE_FCFS, 0);
+	ASSERT_NE(nullptr, session);
+
+	ProcessControlBlock_t late = {.remaining_burst_time = 5, .priority = 1, .arrival = 10, .deadline = 0, .started = false};
+	ProcessControlBlock_t early = {.remaining_burst_time = 5, .priority = 1, .arrival = 5, .deadline = 0, .started = false};
+	EXPECT_EQ(true, schedule_session_submit(session, &late));
+	EXPECT_EQ(false, schedule_session_submit(session, &early)); // out of arrival order
+	EXPECT_EQ(true, schedule_session_advance(session, 20));
+	EXPECT_EQ(false, schedule_session_advance(session, 15)); // the clock doesn't go back
+
+	late.arrival = 19;
+	EXPECT_EQ(false, schedule_session_submit(session, &late)); // arrives before the clock
+
+	schedule_session_destroy(session);
+}
+
+TEST (schedule_session, SnapshotWhileRunning) // looked at after the first two pcbs finish and again at the end
+{
+	schedule_session_t *session = schedule_session_create(SCHEDULE_FCFS, 0);
+	ASSERT_NE(nullptr, session);
+
+	ProcessControlBlock_t newPCB1 = {.remaining_burst_time = 5, .priority = 1, .arrival = 0, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB2 = {.remaining_burst_time = 3, .priority = 1, .arrival = 1, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB3 = {.remaining_burst_time = 8, .priority = 1, .arrival = 2, .deadline = 0, .started = false};
+
+	EXPECT_EQ(true, schedule_session_submit(session, &newPCB1));
+	EXPECT_EQ(true, schedule_session_submit(session, &newPCB2));
+	EXPECT_EQ(true, schedule_session_advance(session, 2));
+	EXPECT_EQ(true, schedule_session_submit(session, &newPCB3));
+
+	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+		.waiting_latency = {}, .turnaround_latency = {}};
+
+	EXPECT_EQ(true, schedule_session_advance(session, 9)); // the first two are done by 8
+	EXPECT_EQ(true, schedule_session_snapshot(session, &result));
+	EXPECT_EQ(result.total_run_time, 8UL);
+	EXPECT_NEAR(result.average_waiting_time, 2.00, 0.01);
+	EXPECT_NEAR(result.average_turnaround_time, 6.00, 0.01);
+	EXPECT_EQ(1UL, schedule_session_live(session));
+
+	EXPECT_EQ(true, schedule_session_advance(session, UINT64_MAX));
+	EXPECT_EQ(true, schedule_session_snapshot(session, &result));
+	EXPECT_EQ(result.total_run_time, 16UL);
+	EXPECT_NEAR(result.average_waiting_time, 3.33, 0.01);
+	EXPECT_NEAR(result.average_turnaround_time, 8.67, 0.01);
+	EXPECT_EQ(0UL, schedule_session_live(session));
+
+	schedule_session_destroy(session);
+}
+
+TEST (schedule_session, PreemptionColumns) // streamed SRT and RR fill the same columns as the batch run, indexed by submission
+{
+	dyn_array_t* trace = random_ready_queue(20000, 61, 100, 60);
+	std::vector<ProcessControlBlock_t> stream((ProcessControlBlock_t *)dyn_array_front(trace), (ProcessControlBlock_t *)dyn_array_front(trace) + dyn_array_size(trace));
+	std::stable_sort(stream.begin(), stream.end(), [](const ProcessControlBlock_t &a, const ProcessControlBlock_t &b) { return a.arrival < b.arrival; });
+	dyn_array_destroy(trace);
+
+	const size_t numPCBs = stream.size();
+	std::vector<uint64_t> firstDispatch(numPCBs), completion(numPCBs), expectedFirstDispatch(numPCBs), expectedCompletion(numPCBs);
+	std::vector<uint32_t> preemptions(numPCBs), expectedPreemptions(numPCBs);
+	ScheduleColumns_t columns = {firstDispatch.data(), completion.data(), NULL, NULL, preemptions.data()};
+	ScheduleColumns_t expectedColumns = {expectedFirstDispatch.data(), expectedCompletion.data(), NULL, NULL, expectedPreemptions.data()};
+	dyn_array_t* batch_queue = dyn_array_import(stream.data(), numPCBs, sizeof(ProcessControlBlock_t), NULL);
+
+	for (ScheduleAlgorithm_t algorithm : {SCHEDULE_SRT, SCHEDULE_RR})
+	{
+		ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+			.waiting_latency = {}, .turnaround_latency = {}};
+		EXPECT_EQ(true, schedule_algorithm(batch_queue, &result, algorithm, QUANTUM, &expectedColumns));
+
+		schedule_session_t *session = schedule_session_create(algorithm, QUANTUM);
+		ASSERT_NE(nullptr, session);
+		EXPECT_EQ(true, schedule_session_columns(session, &columns, numPCBs));
+		for (const ProcessControlBlock_t &pcb : stream)
+		{
+			EXPECT_EQ(true, schedule_session_advance(session, pcb.arrival));
+			EXPECT_EQ(true, schedule_session_submit(session, &pcb));
+		}
+		EXPECT_EQ(false, schedule_session_columns(session, NULL, 0)); // too late, pcbs were submitted
+		EXPECT_EQ(false, schedule_session_submit(session, &stream.back())); // no room left in the columns
+		EXPECT_EQ(true, schedule_session_advance(session, UINT64_MAX));
+		schedule_session_destroy(session);
+
+		EXPECT_EQ(expectedPreemptions, preemptions);
+		EXPECT_EQ(expectedFirstDispatch, firstDispatch);
+		EXPECT_EQ(expectedCompletion, completion);
+	}
+
+	dyn_array_destroy(batch_queue);
+}
+
+TEST (schedule_session, StreamingMatchesBatch) // every policy, advancing to each arrival before submitting it
+{
+	const ScheduleAlgorithm_t algorithms[] = {SCHEDULE_FCFS, SCHEDULE_SJF, SCHEDULE_PRIORITY, SCHEDULE_RR, SCHEDULE_SRT, SCHEDULE_EDF, SCHEDULE_EDF_PREEMPTIVE};
+
+	dyn_array_t* trace = random_ready_queue(100000, 53, 100, 60);
+	std::vector<ProcessControlBlock_t> stream((ProcessControlBlock_t *)dyn_array_front(trace), (ProcessControlBlock_t *)dyn_array_front(trace) + dyn_array_size(trace));
+	for (size_t i = 0; i < stream.size(); i++)
+	{
+		stream[i].deadline = stream[i].arrival + 2 * stream[i].remaining_burst_time + 1;
+	}
+	std::stable_sort(stream.begin(), stream.end(), [](const ProcessControlBlock_t &a, const ProcessControlBlock_t &b) { return a.arrival < b.arrival; });
+	dyn_array_destroy(trace);
+
+	for (ScheduleAlgorithm_t algorithm : algorithms)
+	{
+		dyn_array_t* batch_queue = dyn_array_import(stream.data(), stream.size(), sizeof(ProcessControlBlock_t), NULL);
+		ScheduleResult_t expected = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+			.waiting_latency = {}, .turnaround_latency = {}};
+		ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+			.waiting_latency = {}, .turnaround_latency = {}};
+
+		switch (algorithm)
+		{
+			case SCHEDULE_FCFS: EXPECT_EQ(true, first_come_first_serve(batch_queue, &expected)); break;
+			case SCHEDULE_SJF: EXPECT_EQ(true, shortest_job_first(batch_queue, &expected)); break;
+			case SCHEDULE_PRIORITY: EXPECT_EQ(true, priority(batch_queue, &expected)); break;
+			case SCHEDULE_RR: EXPECT_EQ(true, round_robin(batch_queue, &expected, QUANTUM)); break;
+			case SCHEDULE_SRT: EXPECT_EQ(true, shortest_remaining_time_first(batch_queue, &expected)); break;
+			case SCHEDULE_EDF: EXPECT_EQ(true, earliest_deadline_first(batch_queue, &expected, false)); break;
+			case SCHEDULE_EDF_PREEMPTIVE: EXPECT_EQ(true, earliest_deadline_first(batch_queue, &expected, true)); break;
+		}
+		dyn_array_destroy(batch_queue);
+
+		schedule_session_t *session = schedule_session_create(algorithm, QUANTUM);
+		ASSERT_NE(nullptr, session);
+		for (const ProcessControlBlock_t &pcb : stream)
+		{
+			EXPECT_EQ(true, schedule_session_advance(session, pcb.arrival));
+			EXPECT_EQ(true, schedule_session_submit(session, &pcb));
+		}
+		EXPECT_EQ(true, schedule_session_advance(session, UINT64_MAX));
+		EXPECT_EQ(true, schedule_session_snapshot(session, &result));
+		schedule_session_destroy(session);
+
+		EXPECT_EQ(expected.total_run_time, result.total_run_time);
+		EXPECT_EQ(expected.average_waiting_time, result.average_waiting_time);
+		EXPECT_EQ(expected.average_turnaround_time, result.average_turnaround_time);
+		EXPECT_EQ(expected.deadline_misses, result.deadline_misses);
+		EXPECT_EQ(expected.max_lateness, result.max_lateness);
+	}
+}
+
+
+TEST (schedule_session, PolicyBadParams)
+{
+	SchedulePolicy_t policy;
+	const size_t quanta[] = {4, 0};
+	MlfqConfig_t config = {.levels = 2, .quanta = quanta, .boost_period = 0};
+
+	EXPECT_EQ(false, schedule_policy_algorithm(NULL, SCHEDULE_FCFS, 0));
+	EXPECT_EQ(false, schedule_policy_algorithm(&policy, SCHEDULE_RR, 0));
+	EXPECT_EQ(false, schedule_policy_priority_preemptive(NULL, 0));
+	EXPECT_EQ(false, schedule_policy_mlfq(&policy, &config)); // a zero quantum
+	EXPECT_EQ(false, schedule_policy_mlfq(&policy, NULL));
+	EXPECT_EQ(false, schedule_policy_cfs(&policy, 0, 1));
+	EXPECT_EQ(false, schedule_policy_cfs(&policy, 1, 0));
+	EXPECT_EQ(false, schedule_policy_stride(&policy, 0));
+	EXPECT_EQ(false, schedule_policy_smp(&policy, SCHEDULE_FCFS, 0, 0));
+	EXPECT_EQ(false, schedule_policy_smp(&policy, SCHEDULE_RR, 0, 2));
+
+	EXPECT_EQ(nullptr, schedule_session_create_policy(NULL));
+	SchedulePolicyOps_t ops = {sjf_on_arrival, NULL, NULL, NULL};
+	KeyedIdHeap ready;
+	SchedulePolicy_t noSelect = {.ops = &ops, .state = &ready, .destroy = NULL, .cpus = 1};
+	EXPECT_EQ(nullptr, schedule_session_create_policy(&noSelect));
+
+	ASSERT_EQ(true, schedule_policy_stride(&policy, 4));
+	policy.cpus = 0;
+	EXPECT_EQ(nullptr, schedule_session_create_policy(&policy)); // freed all the same
+}
+
+TEST (schedule_session, StreamsEveryEngine) // the engines beyond ScheduleAlgorithm_t, and a policy of our own, fill the same columns streamed as in a batch
+{
+	dyn_array_t* trace = random_ready_queue(20000, 67, 100, 60);
+	std::vector<ProcessControlBlock_t> stream((ProcessControlBlock_t *)dyn_array_front(trace), (ProcessControlBlock_t *)dyn_array_front(trace) + dyn_array_size(trace));
+	std::stable_sort(stream.begin(), stream.end(), [](const ProcessControlBlock_t &a, const ProcessControlBlock_t &b) { return a.arrival < b.arrival; });
+	dyn_array_destroy(trace);
+
+	const size_t numPCBs = stream.size();
+	const size_t quanta[] = {4, 8, 16};
+	const MlfqConfig_t config = {.levels = 3, .quanta = quanta, .boost_period = 200};
+	std::vector<uint64_t> completion(numPCBs), expectedCompletion(numPCBs);
+	std::vector<uint32_t> preemptions(numPCBs), expectedPreemptions(numPCBs);
+	ScheduleColumns_t columns = {NULL, completion.data(), NULL, NULL, preemptions.data()};
+	ScheduleColumns_t expectedColumns = {NULL, expectedCompletion.data(), NULL, NULL, expectedPreemptions.data()};
+	KeyedIdHeap ready;
+	SchedulePolicyOps_t sjf_ops = {sjf_on_arrival, sjf_select, NULL, NULL};
+
+	for (int engine = 0; engine < 7; engine++)
+	{
+		dyn_array_t* batch_queue = dyn_array_import(stream.data(), numPCBs, sizeof(ProcessControlBlock_t), NULL);
+		ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+			.waiting_latency = {}, .turnaround_latency = {}};
+		SchedulePolicy_t policy = {.ops = &sjf_ops, .state = &ready, .destroy = NULL, .cpus = 1}; // the custom one, the others get built
+		bool built = true;
+
+		switch (engine)
+		{
+			case 0:
+				EXPECT_EQ(true, priority_preemptive(batch_queue, &result, 40, &expectedColumns));
+				built = schedule_policy_priority_preemptive(&policy, 40);
+				break;
+			case 1:
+				EXPECT_EQ(true, multi_level_feedback_queue(batch_queue, &result, &config, &expectedColumns));
+				built = schedule_policy_mlfq(&policy, &config);
+				break;
+			case 2:
+				EXPECT_EQ(true, completely_fair_scheduler(batch_queue, &result, 48, 6, &expectedColumns));
+				built = schedule_policy_cfs(&policy, 48, 6);
+				break;
+			case 3:
+				EXPECT_EQ(true, stride_scheduling(batch_queue, &result, QUANTUM, &expectedColumns));
+				built = schedule_policy_stride(&policy, QUANTUM);
+				break;
+			case 4:
+				EXPECT_EQ(true, schedule_smp(batch_queue, &result, SCHEDULE_SRT, 0, 4, NULL, &expectedColumns));
+				built = schedule_policy_smp(&policy, SCHEDULE_SRT, 0, 4);
+				break;
+			case 5:
+				EXPECT_EQ(true, schedule_smp(batch_queue, &result, SCHEDULE_RR, QUANTUM, 3, NULL, &expectedColumns));
+				built = schedule_policy_smp(&policy, SCHEDULE_RR, QUANTUM, 3);
+				break;
+			default:
+				EXPECT_EQ(true, schedule_algorithm(batch_queue, &result, SCHEDULE_SJF, 0, &expectedColumns));
+				break;
+		}
+		dyn_array_destroy(batch_queue);
+		ASSERT_EQ(true, built);
+
+		schedule_session_t *session = schedule_session_create_policy(&policy);
+		ASSERT_NE(nullptr, session);
+		EXPECT_EQ(true, schedule_session_columns(session, &columns, numPCBs));
+		for (const ProcessControlBlock_t &pcb : stream)
+		{
+			EXPECT_EQ(true, schedule_session_advance(session, pcb.arrival));
+			EXPECT_EQ(true, schedule_session_submit(session, &pcb));
+		}
+		EXPECT_EQ(true, schedule_session_advance(session, UINT64_MAX));
+		EXPECT_EQ(0UL, schedule_session_live(session));
+		schedule_session_destroy(session);
+
+		EXPECT_EQ(expectedCompletion, completion) << "engine " << engine;
+		EXPECT_EQ(expectedPreemptions, preemptions) << "engine " << engine;
+	}
+}
+
+TEST (schedule_session, AgingOverflowRejected) // checked as the pcbs arrive, with the same outcome as the batch run
+{
+	const ProcessControlBlock_t pcbs[] = {
+		{.remaining_burst_time = UINT32_MAX, .priority = UINT32_MAX, .arrival = 0, .deadline = 0, .started = false},
+		{.remaining_burst_time = UINT32_MAX, .priority = 0, .arrival = 1, .deadline = 0, .started = false}};
+
+	for (uint32_t aging : {UINT32_MAX, 1U << 20})
+	{
+		SchedulePolicy_t policy;
+		ASSERT_EQ(true, schedule_policy_priority_preemptive(&policy, aging));
+		schedule_session_t *session = schedule_session_create_policy(&policy);
+		ASSERT_NE(nullptr, session);
+
+		EXPECT_EQ(true, schedule_session_submit(session, &pcbs[0]));
+		EXPECT_EQ(true, schedule_session_submit(session, &pcbs[1]));
+		EXPECT_EQ(aging != UINT32_MAX, schedule_session_advance(session, UINT64_MAX));
+		schedule_session_destroy(session);
+	}
+}
+
+/*
+*  Non-destructive scheduling UNIT TEST CASES
+**/
+
+TEST (schedule_algorithm, BadParams)
+{
+	dyn_array_t* ready_queue = random_ready_queue(3, 1, 10, 5);
+	dyn_array_t* empty_queue = dyn_array_create(0, sizeof(ProcessControlBlock_t), NULL);
+	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+		.waiting_latency = {}, .turnaround_latency = {}};
+
+	EXPECT_EQ(false, schedule_algorithm(NULL, &result, SCHEDULE_FCFS, 0, NULL));
+	EXPECT_EQ(false, schedule_algorithm(ready_queue, NULL, SCHEDULE_FCFS, 0, NULL));
+	EXPECT_EQ(false, schedule_algorithm(empty_queue, &result, SCHEDULE_FCFS, 0, NULL));
+	EXPECT_EQ(false, schedule_algorithm(ready_queue, &result, SCHEDULE_RR, 0, NULL));
+	EXPECT_EQ(false, schedule_algorithm(ready_queue, &result, (ScheduleAlgorithm_t)(SCHEDULE_EDF_PREEMPTIVE + 1), 4, NULL));
+
+	dyn_array_destroy(ready_queue);
+	dyn_array_destroy(empty_queue);
+}
+
+TEST (schedule_algorithm, LeavesInputUntouched) // same answers as the draining entry points, the pcbs are byte for byte the same afterwards
+{
+	dyn_array_t* ready_queue = random_ready_queue(20000, 21, 50, 30);
+	std::vector<ProcessControlBlock_t> before((const ProcessControlBlock_t *)dyn_array_export(ready_queue),
+		(const ProcessControlBlock_t *)dyn_array_export(ready_queue) + dyn_array_size(ready_queue));
+
+	for (int algorithm = SCHEDULE_FCFS; algorithm <= SCHEDULE_EDF_PREEMPTIVE; algorithm++)
+	{
+		ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+			.waiting_latency = {}, .turnaround_latency = {}};
+		EXPECT_EQ(true, schedule_algorithm(ready_queue, &result, (ScheduleAlgorithm_t)algorithm, 6, NULL));
+		ASSERT_EQ(before.size(), dyn_array_size(ready_queue));
+		EXPECT_EQ(0, memcmp(before.data(), dyn_array_export(ready_queue), before.size() * sizeof(ProcessControlBlock_t)));
+
+		dyn_array_t* copy = dyn_array_import(before.data(), before.size(), sizeof(ProcessControlBlock_t), NULL);
+		ScheduleResult_t expected = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+			.waiting_latency = {}, .turnaround_latency = {}};
+		EXPECT_EQ(true, schedule_busy_periods_parallel(copy, &expected, (ScheduleAlgorithm_t)algorithm, 6, 1));
+		EXPECT_EQ(0UL, dyn_array_size(copy));
+
+		EXPECT_EQ(expected.total_run_time, result.total_run_time);
+		EXPECT_EQ(expected.average_waiting_time, result.average_waiting_time);
+		EXPECT_EQ(expected.average_turnaround_time, result.average_turnaround_time);
+		dyn_array_destroy(copy);
+	}
+
+	dyn_array_destroy(ready_queue);
+}
+
+TEST (schedule_algorithm, SharedAcrossThreads) // one loaded ready_queue, read by several threads at once
+{
+	dyn_array_t* ready_queue = random_ready_queue(200000, 23, 100, 60);
+	ScheduleResult_t expected = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+		.waiting_latency = {}, .turnaround_latency = {}};
+	ASSERT_EQ(true, schedule_algorithm(ready_queue, &expected, SCHEDULE_SRT, 0, NULL));
+
+	std::vector<ScheduleResult_t> results(4);
+	std::vector<std::thread> threads;
+	for (size_t i = 0; i < results.size(); i++)
+	{
+		threads.push_back(std::thread([&, i]() { schedule_algorithm(ready_queue, &results[i], SCHEDULE_SRT, 0, NULL); }));
+	}
+	for (std::thread &thread : threads)
+	{
+		thread.join();
+	}
+
+	for (const ScheduleResult_t &result : results)
+	{
+		EXPECT_EQ(expected.total_run_time, result.total_run_time);
+		EXPECT_EQ(expected.average_waiting_time, result.average_waiting_time);
+		EXPECT_EQ(expected.average_turnaround_time, result.average_turnaround_time);
+	}
+
+	dyn_array_destroy(ready_queue);
+}
+
+TEST (schedule_algorithm, PolicyEvaluate) // the policy core's non-draining form
+{
+	ProcessControlBlock_t pcbs[] = {
+		{.remaining_burst_time = 6, .priority = 2, .arrival = 0, .deadline = 0, .started = false},
+		{.remaining_burst_time = 2, .priority = 1, .arrival = 1, .deadline = 0, .started = false},
+	};
+	dyn_array_t* ready_queue = dyn_array_import(pcbs, 2, sizeof(ProcessControlBlock_t), NULL);
+
+	struct Fifo
+	{
+		std::deque<size_t> ready;
+		bool on_arrival(const ProcessControlBlock_t *, size_t id, uint32_t, uint64_t, size_t) { ready.push_back(id); return true; }
+		bool select(size_t, uint64_t, size_t *id, uint64_t *) { *id = ready.front(); ready.pop_front(); return true; }
+		bool preempt(size_t, size_t, uint32_t, uint64_t, uint64_t *slice) { return *slice == 0; }
+		void on_complete(size_t, size_t, uint64_t) {}
+	}
+	fifo;
+
+	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+		.waiting_latency = {}, .turnaround_latency = {}};
+	EXPECT_EQ(true, schedule_evaluate_with(ready_queue, &result, fifo, NULL));
+	EXPECT_EQ(2UL, dyn_array_size(ready_queue));
+	EXPECT_EQ(8UL, result.total_run_time);
+	EXPECT_NEAR(result.average_turnaround_time, 6.5, 0.01);
+
+	dyn_array_destroy(ready_queue);
+}
+
+
+/*
+*  Per-pcb columns UNIT TEST CASES
+**/
+
+TEST (schedule_columns, RoundRobin) // columns follow the file order, not the arrival order
+{
+	ProcessControlBlock_t pcbs[] = {
+		{.remaining_burst_time = 3, .priority = 1, .arrival = 1, .deadline = 0, .started = false},
+		{.remaining_burst_time = 5, .priority = 1, .arrival = 0, .deadline = 0, .started = false},
+	};
+	dyn_array_t* ready_queue = dyn_array_import(pcbs, 2, sizeof(ProcessControlBlock_t), NULL);
+	uint64_t firstDispatch[2], completion[2], waiting[2], response[2];
+	uint32_t preemptions[2];
+	ScheduleColumns_t columns = {firstDispatch, completion, waiting, response, preemptions};
+	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+		.waiting_latency = {}, .turnaround_latency = {}};
+
+	EXPECT_EQ(true, schedule_algorithm(ready_queue, &result, SCHEDULE_RR, 2, &columns)); // 1: 0-2, 0: 2-4, 1: 4-6, 0: 6-7, 1: 7-8
+
+	EXPECT_EQ(2UL, firstDispatch[0]);
+	EXPECT_EQ(7UL, completion[0]);
+	EXPECT_EQ(3UL, waiting[0]);
+	EXPECT_EQ(1UL, response[0]);
+	EXPECT_EQ(1U, preemptions[0]);
+
+	EXPECT_EQ(0UL, firstDispatch[1]);
+	EXPECT_EQ(8UL, completion[1]);
+	EXPECT_EQ(3UL, waiting[1]);
+	EXPECT_EQ(0UL, response[1]);
+	EXPECT_EQ(2U, preemptions[1]);
+
+	dyn_array_destroy(ready_queue);
+}
+
+TEST (schedule_columns, PreemptedOnArrival) // SRT and preemptive EDF give up the CPU to the shorter job / earlier deadline
+{
+	ProcessControlBlock_t pcbs[] = {
+		{.remaining_burst_time = 6, .priority = 1, .arrival = 0, .deadline = 20, .started = false},
+		{.remaining_burst_time = 2, .priority = 1, .arrival = 1, .deadline = 5, .started = false},
+	};
+	dyn_array_t* ready_queue = dyn_array_import(pcbs, 2, sizeof(ProcessControlBlock_t), NULL);
+
+	for (ScheduleAlgorithm_t algorithm : {SCHEDULE_SRT, SCHEDULE_EDF_PREEMPTIVE})
+	{
+		uint64_t firstDispatch[2], completion[2], waiting[2], response[2];
+		uint32_t preemptions[2];
+		ScheduleColumns_t columns = {firstDispatch, completion, waiting, response, preemptions};
+		ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+			.waiting_latency = {}, .turnaround_latency = {}};
+
+		EXPECT_EQ(true, schedule_algorithm(ready_queue, &result, algorithm, 0, &columns)); // 0: 0-1, 1: 1-3, 0: 3-8
+
+		EXPECT_EQ(0UL, firstDispatch[0]);
+		EXPECT_EQ(8UL, completion[0]);
+		EXPECT_EQ(2UL, waiting[0]);
+		EXPECT_EQ(1U, preemptions[0]);
+		EXPECT_EQ(1UL, firstDispatch[1]);
+		EXPECT_EQ(3UL, completion[1]);
+		EXPECT_EQ(0UL, response[1]);
+		EXPECT_EQ(0U, preemptions[1]);
+	}
+
+	dyn_array_destroy(ready_queue);
+}
+
+TEST (schedule_columns, ConsistentWithAverages) // every algorithm: the columns add up to the aggregates and agree with each other
+{
+	dyn_array_t* ready_queue = random_ready_queue(50000, 29, 60, 40);
+	const ProcessControlBlock_t *pcbs = (const ProcessControlBlock_t *)dyn_array_export(ready_queue);
+	const size_t numPCBs = dyn_array_size(ready_queue);
+	std::vector<uint64_t> firstDispatch(numPCBs), completion(numPCBs), waiting(numPCBs), response(numPCBs);
+	std::vector<uint32_t> preemptions(numPCBs);
+	ScheduleColumns_t columns = {firstDispatch.data(), completion.data(), waiting.data(), response.data(), preemptions.data()};
+
+	for (int algorithm = SCHEDULE_FCFS; algorithm <= SCHEDULE_EDF_PREEMPTIVE; algorithm++)
+	{
+		ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+			.waiting_latency = {}, .turnaround_latency = {}};
+		ASSERT_EQ(true, schedule_algorithm(ready_queue, &result, (ScheduleAlgorithm_t)algorithm, 5, &columns));
+
+		bool preemptive = algorithm == SCHEDULE_RR || algorithm == SCHEDULE_SRT || algorithm == SCHEDULE_EDF_PREEMPTIVE;
+		uint64_t waitingSum = 0;
+		uint64_t lastCompletion = 0;
+		for (size_t i = 0; i < numPCBs; i++)
+		{
+			waitingSum += waiting[i];
+			lastCompletion = std::max(lastCompletion, completion[i]);
+			ASSERT_GE(firstDispatch[i], (uint64_t)pcbs[i].arrival);
+			ASSERT_EQ(firstDispatch[i] - pcbs[i].arrival, response[i]);
+			ASSERT_EQ(completion[i] - pcbs[i].arrival - pcbs[i].remaining_burst_time, waiting[i]);
+			if (preemptive == false)
+			{
+				ASSERT_EQ(0U, preemptions[i]);
+				ASSERT_EQ(firstDispatch[i] + pcbs[i].remaining_burst_time, completion[i]);
+			}
+			else if (algorithm == SCHEDULE_RR)
+			{
+				uint32_t slices = (pcbs[i].remaining_burst_time + 4) / 5;
+				ASSERT_EQ(slices ? slices - 1 : 0, preemptions[i]); // one per slice but the last
+			}
+		}
+		EXPECT_NEAR(result.average_waiting_time, (double)waitingSum / numPCBs, 0.01);
+		EXPECT_LE(result.total_run_time, lastCompletion);
+	}
+
+	dyn_array_destroy(ready_queue);
+}
+
+TEST (schedule_columns, PartialAndPolicyCore) // a column left NULL is skipped; the policy core fills the same columns as the built in engines
+{
+	dyn_array_t* ready_queue = random_ready_queue(20000, 31, 40, 20);
+	const size_t numPCBs = dyn_array_size(ready_queue);
+	std::vector<uint32_t> builtIn(numPCBs), core(numPCBs);
+	std::vector<uint64_t> coreCompletion(numPCBs), builtInCompletion(numPCBs);
+
+	ScheduleColumns_t builtInColumns = {NULL, builtInCompletion.data(), NULL, NULL, builtIn.data()};
+	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+		.waiting_latency = {}, .turnaround_latency = {}};
+	ASSERT_EQ(true, schedule_algorithm(ready_queue, &result, SCHEDULE_RR, 3, &builtInColumns));
+
+	struct RoundRobin
+	{
+		std::deque<size_t> ready;
+		bool on_arrival(const ProcessControlBlock_t *, size_t id, uint32_t, uint64_t, size_t) { ready.push_back(id); return true; }
+		bool select(size_t, uint64_t, size_t *id, uint64_t *slice) { *id = ready.front(); ready.pop_front(); *slice = 3; return true; }
+		bool preempt(size_t, size_t, uint32_t, uint64_t, uint64_t *slice) { return *slice == 0; }
+		void on_complete(size_t, size_t, uint64_t) {}
+	}
+	roundRobin;
+
+	ScheduleColumns_t coreColumns = {NULL, coreCompletion.data(), NULL, NULL, core.data()};
+	ASSERT_EQ(true, schedule_evaluate_with(ready_queue, &result, roundRobin, &coreColumns));
+
+	EXPECT_EQ(builtIn, core);
+	EXPECT_EQ(builtInCompletion, coreCompletion);
+
+	dyn_array_destroy(ready_queue);
+}
+
+
+/*
+*  Latency histogram UNIT TEST CASES
+**/
+
+TEST (latency_histogram, BucketBounds) // small values are exact, every value lands in a bucket whose bounds are within 1/32 of it
+{
+	for (uint64_t value = 0; value < LATENCY_HISTOGRAM_SUB_BUCKETS; value++)
+	{
+		EXPECT_EQ(value, latency_histogram_bucket(value));
+		EXPECT_EQ(value, latency_histogram_bucket_limit(value));
+	}
+
+	std::vector<uint64_t> values = {32, 33, 63, 64, 65, 1000, 123456789, UINT32_MAX, (uint64_t)1 << 40, UINT64_MAX};
+	for (uint64_t value : values)
+	{
+		size_t bucket = latency_histogram_bucket(value);
+		ASSERT_LT(bucket, (size_t)LATENCY_HISTOGRAM_BUCKETS);
+		uint64_t limit = latency_histogram_bucket_limit(bucket);
+		EXPECT_GE(limit, value);
+		EXPECT_LE((double)(limit - value), (double)value / 32.0);
+		EXPECT_EQ(bucket, latency_histogram_bucket(limit));
+		if (bucket > 0)
+		{
+			EXPECT_LT(latency_histogram_bucket_limit(bucket - 1), value);
+		}
+	}
+}
+
+TEST (latency_histogram, Percentiles)
+{
+	LatencyHistogram_t histogram = {};
+
+	EXPECT_EQ(0UL, latency_histogram_percentile(&histogram, 50.0)); // empty
+
+	for (uint64_t value = 1; value <= 10000; value++)
+	{
+		latency_histogram_record(&histogram, value);
+	}
+
+	EXPECT_EQ(10000UL, histogram.total);
+	EXPECT_EQ(10000UL, histogram.max);
+	EXPECT_NEAR((double)latency_histogram_percentile(&histogram, 50.0), 5000.0, 5000.0 / 32);
+	EXPECT_NEAR((double)latency_histogram_percentile(&histogram, 90.0), 9000.0, 9000.0 / 32);
+	EXPECT_NEAR((double)latency_histogram_percentile(&histogram, 99.9), 9990.0, 9990.0 / 32);
+	EXPECT_EQ(10000UL, latency_histogram_percentile(&histogram, 100.0));
+	EXPECT_EQ(1UL, latency_histogram_percentile(&histogram, 0.0));
+}
+
+TEST (latency_histogram, MergeMatchesOneHistogram) // shards merged in any order give the same histogram as recording everything in one
+{
+	std::vector<LatencyHistogram_t> shards(3);
+	LatencyHistogram_t whole = {};
+	LatencyHistogram_t merged = {};
+
+	for (uint64_t i = 0; i < 30000; i++)
+	{
+		uint64_t value = (i * 2654435761u) % 1000003;
+		latency_histogram_record(&whole, value);
+		latency_histogram_record(&shards[i % 3], value);
+	}
+	latency_histogram_merge(&merged, &shards[2]);
+	latency_histogram_merge(&merged, &shards[0]);
+	latency_histogram_merge(&merged, &shards[1]);
+
+	EXPECT_EQ(0, memcmp(&whole, &merged, sizeof(LatencyHistogram_t)));
+}
+
+TEST (latency_histogram, ScheduleResults)
+{
+	ProcessControlBlock_t pcbs[] = {
+		{.remaining_burst_time = 10, .priority = 1, .arrival = 0, .deadline = 0, .started = false},
+		{.remaining_burst_time = 5, .priority = 1, .arrival = 0, .deadline = 0, .started = false},
+		{.remaining_burst_time = 7, .priority = 1, .arrival = 0, .deadline = 0, .started = false},
+		{.remaining_burst_time = 3, .priority = 1, .arrival = 0, .deadline = 0, .started = false},
+	};
+	dyn_array_t* ready_queue = dyn_array_import(pcbs, 4, sizeof(ProcessControlBlock_t), NULL);
+	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+		.waiting_latency = {}, .turnaround_latency = {}};
+
+	EXPECT_EQ(true, first_come_first_serve(ready_queue, &result)); // waits 0, 10, 15, 22 and turnarounds 10, 15, 22, 25
+
+	EXPECT_EQ(10UL, result.waiting_latency.p50);
+	EXPECT_EQ(22UL, result.waiting_latency.p90);
+	EXPECT_EQ(22UL, result.waiting_latency.p999);
+	EXPECT_EQ(22UL, result.waiting_latency.max);
+	EXPECT_EQ(15UL, result.turnaround_latency.p50);
+	EXPECT_EQ(25UL, result.turnaround_latency.p99);
+	EXPECT_EQ(25UL, result.turnaround_latency.max);
+
+	dyn_array_destroy(ready_queue);
+}
+
+TEST (latency_histogram, MergedAcrossThreads) // the busy period threads' histograms merge into exactly the sequential percentiles
+{
+	dyn_array_t* sequential_queue = random_ready_queue(200000, 37, 100, 110);
+	dyn_array_t* parallel_queue = dyn_array_import(dyn_array_export(sequential_queue), dyn_array_size(sequential_queue), sizeof(ProcessControlBlock_t), NULL);
+	ScheduleResult_t expected = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+		.waiting_latency = {}, .turnaround_latency = {}};
+	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+		.waiting_latency = {}, .turnaround_latency = {}};
+
+	EXPECT_EQ(true, shortest_remaining_time_first(sequential_queue, &expected));
+	EXPECT_EQ(true, schedule_busy_periods_parallel(parallel_queue, &result, SCHEDULE_SRT, 0, 4));
+
+	EXPECT_EQ(0, memcmp(&expected.waiting_latency, &result.waiting_latency, sizeof(ScheduleLatency_t)));
+	EXPECT_EQ(0, memcmp(&expected.turnaround_latency, &result.turnaround_latency, sizeof(ScheduleLatency_t)));
+	EXPECT_LE(result.waiting_latency.p50, result.waiting_latency.p99);
+	EXPECT_LE(result.waiting_latency.p999, result.waiting_latency.max);
+
+	dyn_array_destroy(sequential_queue);
+	dyn_array_destroy(parallel_queue);
+}
+
+
+/*
+*  Round robin quantum sweep UNIT TEST CASES
+**/
+
+TEST (round_robin_sweep, NULLParams)
+{
+	dyn_array_t* ready_queue = random_ready_queue(3, 1, 10, 5);
+	size_t quanta[] = {1, 2};
+	ScheduleResult_t results[2];
+
+	EXPECT_EQ(false, round_robin_sweep(NULL, quanta, 2, results, 2));
+	EXPECT_EQ(false, round_robin_sweep(ready_queue, NULL, 2, results, 2));
+	EXPECT_EQ(false, round_robin_sweep(ready_queue, quanta, 2, NULL, 2));
+
+	dyn_array_destroy(ready_queue);
+}
+
+TEST (round_robin_sweep, BadParams)
+{
+	dyn_array_t* ready_queue = random_ready_queue(3, 1, 10, 5);
+	dyn_array_t* empty_queue = dyn_array_create(0, sizeof(ProcessControlBlock_t), NULL);
+	size_t quanta[] = {4, 0};
+	ScheduleResult_t results[2];
+
+	EXPECT_EQ(false, round_robin_sweep(ready_queue, quanta, 0, results, 2)); // no quanta
+	EXPECT_EQ(false, round_robin_sweep(ready_queue, quanta, 2, results, 2)); // a zero quantum
+	EXPECT_EQ(false, round_robin_sweep(empty_queue, quanta, 1, results, 2));
+
+	dyn_array_destroy(ready_queue);
+	dyn_array_destroy(empty_queue);
+}
+
+TEST (round_robin_sweep, MatchesRoundRobin) // every row equals its own round_robin run, and the input is left alone
+{
+	dyn_array_t* ready_queue = random_ready_queue(200000, 11, 100, 60);
+	const size_t quanta[] = {1, 3, 7, 20, 64, 1000};
+	const size_t numQuanta = sizeof(quanta) / sizeof(quanta[0]);
+	ScheduleResult_t results[numQuanta];
+
+	EXPECT_EQ(true, round_robin_sweep(ready_queue, quanta, numQuanta, results, 4));
+	ASSERT_EQ(200000UL, dyn_array_size(ready_queue));
+
+	for (size_t i = 0; i < numQuanta; i++)
+	{
+		dyn_array_t* copy = dyn_array_import(dyn_array_export(ready_queue), dyn_array_size(ready_queue), sizeof(ProcessControlBlock_t), NULL);
+		ScheduleResult_t expected = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+			.waiting_latency = {}, .turnaround_latency = {}};
+		EXPECT_EQ(true, round_robin(copy, &expected, quanta[i]));
+
+		EXPECT_EQ(expected.total_run_time, results[i].total_run_time);
+		EXPECT_EQ(expected.average_waiting_time, results[i].average_waiting_time);
+		EXPECT_EQ(expected.average_turnaround_time, results[i].average_turnaround_time);
+		dyn_array_destroy(copy);
+	}
+
+	dyn_array_destroy(ready_queue);
+}
+
+TEST (round_robin_sweep, MoreQuantaThanThreads)
+{
+	ProcessControlBlock_t pcbs[] = {
+		{.remaining_burst_time = 5, .priority = 1, .arrival = 0, .deadline = 0, .started = false},
+		{.remaining_burst_time = 3, .priority = 1, .arrival = 1, .deadline = 0, .started = false},
+	};
+	dyn_array_t* ready_queue = dyn_array_import(pcbs, 2, sizeof(ProcessControlBlock_t), NULL);
+	size_t quanta[] = {1, 2, 3, 4, 5};
+	ScheduleResult_t results[5];
+
+	EXPECT_EQ(true, round_robin_sweep(ready_queue, quanta, 5, results, 2));
+
+	for (size_t i = 0; i < 5; i++)
+	{
+		EXPECT_EQ(8UL, results[i].total_run_time);
+	}
+	EXPECT_NEAR(results[0].average_turnaround_time, 6.5, 0.01); // ends at 8 and 5
+	EXPECT_NEAR(results[4].average_turnaround_time, 6.0, 0.01); // FCFS: ends at 5 and 8
+
+	dyn_array_destroy(ready_queue);
+}
+
+
+/*
+*  Algorithm comparison UNIT TEST CASES
+**/
+
+TEST (schedule_compare, BadParams)
+{
+	dyn_array_t* ready_queue = random_ready_queue(3, 1, 10, 5);
+	ScheduleAlgorithm_t algorithms[] = {SCHEDULE_FCFS, SCHEDULE_RR};
+	ScheduleAlgorithm_t unknown[] = {(ScheduleAlgorithm_t)(SCHEDULE_EDF_PREEMPTIVE + 1)};
+	ScheduleResult_t results[2];
+
+	EXPECT_EQ(false, schedule_compare(NULL, algorithms, 2, 4, results, 2));
+	EXPECT_EQ(false, schedule_compare(ready_queue, NULL, 2, 4, results, 2));
+	EXPECT_EQ(false, schedule_compare(ready_queue, algorithms, 2, 4, NULL, 2));
+	EXPECT_EQ(false, schedule_compare(ready_queue, algorithms, 0, 4, results, 2));
+	EXPECT_EQ(false, schedule_compare(ready_queue, algorithms, 2, 0, results, 2)); // round robin without a quantum
+	EXPECT_EQ(false, schedule_compare(ready_queue, unknown, 1, 4, results, 2));
+
+	dyn_array_destroy(ready_queue);
+}
+
+TEST (schedule_compare, MatchesSequential) // every algorithm from one shared load equals its own run on a private copy
+{
+	dyn_array_t* ready_queue = random_ready_queue(200000, 5, 100, 60);
+	const ScheduleAlgorithm_t algorithms[] = {SCHEDULE_FCFS, SCHEDULE_SJF, SCHEDULE_PRIORITY, SCHEDULE_RR, SCHEDULE_SRT};
+	const size_t numAlgorithms = sizeof(algorithms) / sizeof(algorithms[0]);
+	ScheduleResult_t results[numAlgorithms];
+
+	EXPECT_EQ(true, schedule_compare(ready_queue, algorithms, numAlgorithms, 8, results, 0));
+	ASSERT_EQ(200000UL, dyn_array_size(ready_queue));
+
+	for (size_t i = 0; i < numAlgorithms; i++)
+	{
+		dyn_array_t* copy = dyn_array_import(dyn_array_export(ready_queue), dyn_array_size(ready_queue), sizeof(ProcessControlBlock_t), NULL);
+		ScheduleResult_t expected = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+			.waiting_latency = {}, .turnaround_latency = {}};
+		switch (algorithms[i])
+		{
+			case SCHEDULE_FCFS: EXPECT_EQ(true, first_come_first_serve(copy, &expected)); break;
+			case SCHEDULE_SJF: EXPECT_EQ(true, shortest_job_first(copy, &expected)); break;
+			case SCHEDULE_PRIORITY: EXPECT_EQ(true, priority(copy, &expected)); break;
+			case SCHEDULE_RR: EXPECT_EQ(true, round_robin(copy, &expected, 8)); break;
+			default: EXPECT_EQ(true, shortest_remaining_time_first(copy, &expected)); break;
+		}
+
+		EXPECT_EQ(expected.total_run_time, results[i].total_run_time);
+		EXPECT_EQ(expected.average_waiting_time, results[i].average_waiting_time);
+		EXPECT_EQ(expected.average_turnaround_time, results[i].average_turnaround_time);
+		dyn_array_destroy(copy);
+	}
+
+	dyn_array_destroy(ready_queue);
+}
+
+TEST (schedule_compare, SameAlgorithmTwice)
+{
+	ProcessControlBlock_t pcbs[] = {
+		{.remaining_burst_time = 6, .priority = 2, .arrival = 0, .deadline = 0, .started = false},
+		{.remaining_burst_time = 2, .priority = 1, .arrival = 1, .deadline = 0, .started = false},
+	};
+	dyn_array_t* ready_queue = dyn_array_import(pcbs, 2, sizeof(ProcessControlBlock_t), NULL);
+	ScheduleAlgorithm_t algorithms[] = {SCHEDULE_SRT, SCHEDULE_SRT, SCHEDULE_FCFS};
+	ScheduleResult_t results[3];
+
+	EXPECT_EQ(true, schedule_compare(ready_queue, algorithms, 3, 0, results, 3)); // no round robin, so no quantum needed
+
+	EXPECT_NEAR(results[0].average_turnaround_time, 5.0, 0.01); // ends at 3 and 8
+	EXPECT_NEAR(results[1].average_turnaround_time, 5.0, 0.01);
+	EXPECT_NEAR(results[2].average_turnaround_time, 6.5, 0.01); // ends at 6 and 8
+	EXPECT_EQ(8UL, results[2].total_run_time);
+
+	dyn_array_destroy(ready_queue);
+}
+
+
+/*
+*  SMP simulation UNIT TEST CASES
+**/
+
+TEST (schedule_smp, BadParams)
+{
+	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+		.waiting_latency = {}, .turnaround_latency = {}};
+	EXPECT_EQ(false, schedule_smp(NULL, &result, SCHEDULE_FCFS, 0, 2, NULL, NULL));
+
+	dyn_array_t* ready_queue = random_ready_queue(10, 3, 10, 20);
+	EXPECT_EQ(false, schedule_smp(ready_queue, NULL, SCHEDULE_FCFS, 0, 2, NULL, NULL));
+	EXPECT_EQ(false, schedule_smp(ready_queue, &result, SCHEDULE_FCFS, 0, 0, NULL, NULL)); // no cores
+	EXPECT_EQ(false, schedule_smp(ready_queue, &result, SCHEDULE_RR, 0, 2, NULL, NULL)); // RR without a quantum
+	dyn_array_destroy(ready_queue);
+
+	ready_queue = dyn_array_create(3, sizeof(ProcessControlBlock_t), NULL);
+	EXPECT_EQ(false, schedule_smp(ready_queue, &result, SCHEDULE_SJF, 0, 2, NULL, NULL));
+	dyn_array_destroy(ready_queue);
+}
+
+TEST (schedule_smp, IdleCoreStealsWork) // the third pcb is queued behind the first, core 1 takes it when it frees up
+{
+	ProcessControlBlock_t newPCB1 = {.remaining_burst_time = 5, .priority = 1, .arrival = 0, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB2 = {.remaining_burst_time = 3, .priority = 1, .arrival = 0, .deadline = 0, .started = false};
+	ProcessControlBlock_t newPCB3 = {.remaining_burst_time = 4, .priority = 1, .arrival = 0, .deadline = 0, .started = false};
+	
+	dyn_array_t* ready_queue = dyn_array_create(3, sizeof(ProcessControlBlock_t), NULL);
+	
+	dyn_array_push_back(ready_queue, &newPCB1);
+	dyn_array_push_back(ready_queue, &newPCB2);
+	dyn_array_push_back(ready_queue, &newPCB3);
+	
+	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+		.waiting_latency = {}, .turnaround_latency = {}};
+	float utilization[2] = {0, 0};
+	
+	EXPECT_EQ(true, schedule_smp(ready_queue, &result, SCHEDULE_FCFS, 0, 2, utilization, NULL));
+	
+	EXPECT_EQ(result.total_run_time, 12UL);
+	EXPECT_NEAR(result.average_waiting_time, 1.00, 0.01);
+	EXPECT_NEAR(result.average_turnaround_time, 5.00, 0.01);
+	EXPECT_NEAR(utilization[0], 0.71, 0.01);
+	EXPECT_NEAR(utilization[1], 1.00, 0.01);
+	
+	dyn_array_destroy(ready_queue);
+}
+
+TEST (schedule_smp, OneCoreMatchesSequential) // every policy
+{
+	const ScheduleAlgorithm_t algorithms[] = {SCHEDULE_FCFS, SCHEDULE_SJF, SCHEDULE_PRIORITY, SCHEDULE_RR, SCHEDULE_SRT, SCHEDULE_EDF, SCHEDULE_EDF_PREEMPTIVE};
+
+	for (ScheduleAlgorithm_t algorithm : algorithms)
+	{
+		dyn_array_t* sequential_queue = random_ready_queue(50000, 13, 100, 60);
+		dyn_array_t* smp_queue = random_ready_queue(50000, 13, 100, 60);
+
+		ScheduleResult_t expected = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+			.waiting_latency = {}, .turnaround_latency = {}};
+		ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+			.waiting_latency = {}, .turnaround_latency = {}};
+
+		switch (algorithm)
+		{
+			case SCHEDULE_FCFS: EXPECT_EQ(true, first_come_first_serve(sequential_queue, &expected)); break;
+			case SCHEDULE_SJF: EXPECT_EQ(true, shortest_job_first(sequential_queue, &expected)); break;
+			case SCHEDULE_PRIORITY: EXPECT_EQ(true, priority(sequential_queue, &expected)); break;
+			case SCHEDULE_RR: EXPECT_EQ(true, round_robin(sequential_queue, &expected, QUANTUM)); break;
+			case SCHEDULE_SRT: EXPECT_EQ(true, shortest_remaining_time_first(sequential_queue, &expected)); break;
+			case SCHEDULE_EDF: EXPECT_EQ(true, earliest_deadline_first(sequential_queue, &expected, false)); break;
+			case SCHEDULE_EDF_PREEMPTIVE: EXPECT_EQ(true, earliest_deadline_first(sequential_queue, &expected, true)); break;
+		}
+		EXPECT_EQ(true, schedule_smp(smp_queue, &result, algorithm, QUANTUM, 1, NULL, NULL));
+
+		EXPECT_EQ(expected.total_run_time, result.total_run_time);
+		EXPECT_EQ(expected.average_waiting_time, result.average_waiting_time);
+		EXPECT_EQ(expected.average_turnaround_time, result.average_turnaround_time);
+
+		dyn_array_destroy(sequential_queue);
+		dyn_array_destroy(smp_queue);
+	}
+}
+
+TEST (schedule_smp, PreemptionColumns) // round robin on four cores preempts every quantum but the last; one SRT core gives the single CPU columns
+{
+	dyn_array_t* trace = random_ready_queue(20000, 59, 60, 10);
+	const ProcessControlBlock_t *pcbs = (const ProcessControlBlock_t *)dyn_array_export(trace);
+	const size_t numPCBs = dyn_array_size(trace);
+	std::vector<uint64_t> firstDispatch(numPCBs), completion(numPCBs), expectedCompletion(numPCBs);
+	std::vector<uint32_t> preemptions(numPCBs), expectedPreemptions(numPCBs);
+	ScheduleColumns_t columns = {firstDispatch.data(), completion.data(), NULL, NULL, preemptions.data()};
+	ScheduleColumns_t expectedColumns = {NULL, expectedCompletion.data(), NULL, NULL, expectedPreemptions.data()};
+	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+		.waiting_latency = {}, .turnaround_latency = {}};
+
+	dyn_array_t* smp_queue = dyn_array_import(pcbs, numPCBs, sizeof(ProcessControlBlock_t), NULL);
+	EXPECT_EQ(true, schedule_smp(smp_queue, &result, SCHEDULE_RR, QUANTUM, 4, NULL, &columns));
+	for (size_t i = 0; i < numPCBs; i++)
+	{
+		ASSERT_EQ(pcbs[i].remaining_burst_time ? (pcbs[i].remaining_burst_time + QUANTUM - 1) / QUANTUM - 1 : 0, preemptions[i]);
+		ASSERT_GE(firstDispatch[i], (uint64_t)pcbs[i].arrival);
+		ASSERT_GE(completion[i], firstDispatch[i] + pcbs[i].remaining_burst_time);
+	}
+	dyn_array_destroy(smp_queue);
+
+	EXPECT_EQ(true, schedule_algorithm(trace, &result, SCHEDULE_SRT, 0, &expectedColumns));
+	smp_queue = dyn_array_import(pcbs, numPCBs, sizeof(ProcessControlBlock_t), NULL);
+	EXPECT_EQ(true, schedule_smp(smp_queue, &result, SCHEDULE_SRT, 0, 1, NULL, &columns));
+	EXPECT_EQ(expectedPreemptions, preemptions);
+	EXPECT_EQ(expectedCompletion, completion);
+	dyn_array_destroy(smp_queue);
+
+	dyn_array_destroy(trace);
+}
+
+TEST (schedule_smp, ManyCores) // overloaded trace, every core should stay busy and waiting should drop
+{
+	const size_t NUM_CORES = 64;
+	dyn_array_t* sequential_queue = random_ready_queue(200000, 17, 100, 2);
+	dyn_array_t* smp_queue = random_ready_queue(200000, 17, 100, 2);
+
+	ScheduleResult_t expected = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+		.waiting_latency = {}, .turnaround_latency = {}};
+	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+		.waiting_latency = {}, .turnaround_latency = {}};
+	float utilization[NUM_CORES];
+
+	EXPECT_EQ(true, shortest_remaining_time_first(sequential_queue, &expected));
+	EXPECT_EQ(true, schedule_smp(smp_queue, &result, SCHEDULE_SRT, 0, NUM_CORES, utilization, NULL));
+
+	EXPECT_EQ(expected.total_run_time, result.total_run_time);
+	EXPECT_LT(result.average_waiting_time, expected.average_waiting_time);
+	for (size_t c = 0; c < NUM_CORES; c++)
+	{
+		EXPECT_GT(utilization[c], 0.0f);
+		EXPECT_LE(utilization[c], 1.0f);
+	}
+
+	dyn_array_destroy(sequential_queue);
+	dyn_array_destroy(smp_queue);
+}
+
+
+/*
+*  LOAD PROCESS CONTROL BLOCKS UNIT TEST CASES
+**/
+
+/*
+*  Tests related to invalid parameters
+**/
+
+// if the filename is NULL
+TEST (load_process_control_blocks, fileNULL) 
+{
+	EXPECT_EQ(nullptr,load_process_control_blocks(nullptr));
+}
+
+// if the file doesn't exist
+TEST (load_process_control_blocks, fileDNE) 
+{
+	FILE *fptr = fopen("fileDNE.bin", "wb");
+	fclose(fptr);
+	dyn_array_t * pcbs = load_process_control_blocks("fileDNE.bin");
+	EXPECT_EQ(NULL,pcbs);
+	dyn_array_destroy(pcbs);
+	remove("fileDNE.bin");
+}
+
+/*
+*  Tests related to corrupt or malformed file types
+**/
+
+TEST (load_process_control_blocks, emptyFile) 
+{
+	FILE *fptr = fopen("test.bin", "wb");
+	fclose(fptr);
+	EXPECT_EQ(NULL,load_process_control_blocks("test.bin"));
+	remove("test.bin");
 }
 
 // test file too short, should at least have 4 bytes for N even if N=0
 TEST (load_process_control_blocks, fileTooShort) 
 {
 	FILE *fptr = fopen("test.bin", "wb");
-	uint16_t testNum = 24;
-	fwrite(&testNum, sizeof(uint16_t), 1, fptr); // only write 2 bytes to the file
+	uint16_t testNum = 24;
+	fwrite(&testNum, sizeof(uint16_t), 1, fptr); // only write 2 bytes to the file
+	fclose(fptr);
+	EXPECT_EQ(NULL,load_process_control_blocks("test.bin"));
+	remove("test.bin");
+}
+
+//The PCB file is composed of LESS than 1+(3*N) 32-bit integers
+TEST (load_process_control_blocks, tooFewIntegers) 
+{
+	FILE *fptr = fopen("test.bin", "wb");
+	
+	uint32_t N = 2; // 2 pcbs
+	fwrite(&N, sizeof(uint32_t), 1, fptr);
+
+	uint32_t P1remaining_burst_time = 2;
+	fwrite(&P1remaining_burst_time, sizeof(uint32_t), 1, fptr);
+	uint32_t P1priority = 5;
+	fwrite(&P1priority, sizeof(uint32_t), 1, fptr);
+	uint32_t P1arrival = 3;
+	fwrite(&P1arrival, sizeof(uint32_t), 1, fptr);
+
+	uint32_t P2remaining_burst_time = 3;
+	fwrite(&P2remaining_burst_time, sizeof(uint32_t), 1, fptr);
+	uint32_t P2priority = 6;
+	fwrite(&P2priority, sizeof(uint32_t), 1, fptr);
+	// leaving out arrival of the second process so that the PCB file is NOT composed of 1+(3*N) 32-bit integers
+
+	fclose(fptr);
+
+	EXPECT_EQ(NULL, load_process_control_blocks("test.bin"));
+	remove("test.bin");
+}
+
+//The PCB file is composed of MORE than 1+(3*N) 32-bit integers
+TEST (load_process_control_blocks, tooManyIntegers) 
+{
+	FILE *fptr = fopen("test.bin", "wb");
+	
+	uint32_t N = 2; // 2 pcbs
+	fwrite(&N, sizeof(uint32_t), 1, fptr);
+
+	uint32_t P1remaining_burst_time = 2;
+	fwrite(&P1remaining_burst_time, sizeof(uint32_t), 1, fptr);
+	uint32_t P1priority = 5;
+	fwrite(&P1priority, sizeof(uint32_t), 1, fptr);
+	uint32_t P1arrival = 3;
+	fwrite(&P1arrival, sizeof(uint32_t), 1, fptr);
+
+	uint32_t P2remaining_burst_time = 3;
+	fwrite(&P2remaining_burst_time, sizeof(uint32_t), 1, fptr);
+	uint32_t P2priority = 6;
+	fwrite(&P2priority, sizeof(uint32_t), 1, fptr);
+	uint32_t P2arrival = 1;
+	fwrite(&P2arrival, sizeof(uint32_t), 1, fptr);
+
+	// Adding burst time of a third process, should not be here
+	uint32_t P3remaining_burst_time = 4;
+	fwrite(&P3remaining_burst_time, sizeof(uint32_t), 1, fptr);
+
+	fclose(fptr);
+	
+	EXPECT_EQ(NULL, load_process_control_blocks("test.bin"));
+	remove("test.bin");
+}
+
+
+/*
+*  Tests related to zero processes in a valid binary file, N=0
+**/
+
+TEST (load_process_control_blocks, zeroProcesses) 
+{
+	FILE *fptr = fopen("test.bin", "wb");
+	
+	uint32_t N = 0;
+	fwrite(&N, sizeof(uint32_t), 1, fptr);
+
+	fclose(fptr);
+
+	dyn_array_t * array = load_process_control_blocks("test.bin");
+
+	ASSERT_NE(array, nullptr); // array is not null
+	EXPECT_EQ(dyn_array_size(array), static_cast<size_t>(0)); // array is empty
+
+	dyn_array_destroy(array);
+	remove("test.bin");
+}
+
+/*
+*  Tests related to one process in a valid binary file, N=1
+**/
+
+TEST (load_process_control_blocks, oneProcess) 
+{
+	FILE *fptr = fopen("test.bin", "wb");
+	
+	uint32_t N = 1;
+	fwrite(&N, sizeof(uint32_t), 1, fptr);
+
+	uint32_t P1remaining_burst_time = 2;
+	fwrite(&P1remaining_burst_time, sizeof(uint32_t), 1, fptr);
+	uint32_t P1priority = 5;
+	fwrite(&P1priority, sizeof(uint32_t), 1, fptr);
+	uint32_t P1arrival = 3;
+	fwrite(&P1arrival, sizeof(uint32_t), 1, fptr);
+
+	fclose(fptr);
+
+	dyn_array_t * array = load_process_control_blocks("test.bin");
+
+	ASSERT_NE(array, nullptr); // array is not null
+	EXPECT_EQ(dyn_array_size(array), static_cast<size_t>(1)); // array has 1 process
+
+	ProcessControlBlock_t* pcb = (ProcessControlBlock_t *)dyn_array_at(array,0);
+
+	EXPECT_EQ(P1remaining_burst_time, pcb->remaining_burst_time);
+	EXPECT_EQ(P1priority, pcb->priority);
+	EXPECT_EQ(P1arrival, pcb->arrival);
+	EXPECT_FALSE(pcb->started);
+
+	dyn_array_destroy(array);
+	remove("test.bin");
+}
+
+/*
+*  Tests related to multiple processes in a valid binary file, N = 10
+**/
+
+TEST (load_process_control_blocks, multipleProcesses) 
+{
+	FILE *fptr = fopen("test.bin", "wb");
+	
+	uint32_t N = 10;
+	fwrite(&N, sizeof(uint32_t), 1, fptr);
+
+	uint32_t burst_times[10] = {2, 3, 7, 9, 0, 15, 8, 3, 6, 9};
+	uint32_t priorities[10] = {5, 6, 4, 5, 10, 1, 9, 4, 7, 8};
+	uint32_t arrivals[10] = {3, 8, 2, 1, 30, 4, 10, 5, 8, 9};
+
+	size_t i;
+
+	for (i = 0; i < 10; i++) {
+		fwrite(&burst_times[i], sizeof(uint32_t), 1, fptr);
+		fwrite(&priorities[i], sizeof(uint32_t), 1, fptr);
+		fwrite(&arrivals[i], sizeof(uint32_t), 1, fptr);
+	}
+
+	fclose(fptr);
+
+	dyn_array_t * array = load_process_control_blocks("test.bin");
+
+	ASSERT_NE(array, nullptr); // array is not null
+	EXPECT_EQ(dyn_array_size(array), static_cast<size_t>(10)); // array has 10 processes
+
+	for (i = 0; i < 10; i++) {
+		ProcessControlBlock_t* pcb = (ProcessControlBlock_t *)dyn_array_at(array,i);
+		ASSERT_NE(pcb, nullptr); // pcb is not null
+
+		EXPECT_EQ(burst_times[i], pcb->remaining_burst_time);
+		EXPECT_EQ(priorities[i], pcb->priority);
+		EXPECT_EQ(arrivals[i], pcb->arrival);
+		EXPECT_FALSE(pcb->started);
+	}
+
+	dyn_array_destroy(array);
+	remove("test.bin");
+}
+
+TEST (load_process_control_blocks_with_deadlines, multipleProcesses) 
+{
+	FILE *fptr = fopen("test.bin", "wb");
+	
+	uint32_t N = 3;
+	fwrite(&N, sizeof(uint32_t), 1, fptr);
+
+	uint32_t records[3][4] = {{2, 5, 3, 10}, {3, 6, 8, 0}, {7, 4, 2, 30}};
+	fwrite(records, sizeof(records), 1, fptr);
+	fclose(fptr);
+
+	dyn_array_t * array = load_process_control_blocks_with_deadlines("test.bin");
+
+	ASSERT_NE(array, nullptr);
+	EXPECT_EQ(dyn_array_size(array), static_cast<size_t>(3));
+
+	for (size_t i = 0; i < 3; i++) {
+		ProcessControlBlock_t* pcb = (ProcessControlBlock_t *)dyn_array_at(array,i);
+		ASSERT_NE(pcb, nullptr);
+
+		EXPECT_EQ(records[i][0], pcb->remaining_burst_time);
+		EXPECT_EQ(records[i][1], pcb->priority);
+		EXPECT_EQ(records[i][2], pcb->arrival);
+		EXPECT_EQ(records[i][3], pcb->deadline);
+	}
+
+	dyn_array_destroy(array);
+
+	array = load_process_control_blocks("test.bin"); // 4 words per record can't be read as 3
+	EXPECT_EQ(array, nullptr);
+	remove("test.bin");
+}
+
+
+// Writes a pcb.bin: the count, then the records, then any extra bytes
+static void write_pcb_file(const char *path, const std::vector<PcbRecord_t> &records, size_t extraBytes = 0, uint32_t count = UINT32_MAX)
+{
+	FILE *fptr = fopen(path, "wb");
+	uint32_t N = count == UINT32_MAX ? (uint32_t)records.size() : count;
+	fwrite(&N, sizeof(uint32_t), 1, fptr);
+	fwrite(records.data(), sizeof(PcbRecord_t), records.size(), fptr);
+	for (size_t i = 0; i < extraBytes; i++)
+	{
+		fputc(0, fptr);
+	}
+	fclose(fptr);
+}
+
+// A random pcb.bin, the same pcbs random_ready_queue would make
+static std::vector<PcbRecord_t> random_pcb_records(uint32_t numPCBs, uint32_t seed)
+{
+	dyn_array_t *ready_queue = random_ready_queue(numPCBs, seed, 100, 50);
+	std::vector<PcbRecord_t> records;
+	for (size_t i = 0; i < dyn_array_size(ready_queue); i++)
+	{
+		const ProcessControlBlock_t *pcb = (const ProcessControlBlock_t *)dyn_array_at(ready_queue, i);
+		records.push_back({pcb->remaining_burst_time, pcb->priority, pcb->arrival});
+	}
+	dyn_array_destroy(ready_queue);
+	return records;
+}
+
+// Checks a loaded ready_queue against the records it was written from
+static void expect_loaded(const std::vector<PcbRecord_t> &records, const dyn_array_t *array)
+{
+	ASSERT_NE(array, nullptr);
+	ASSERT_EQ(records.size(), dyn_array_size(array));
+	for (size_t i = 0; i < records.size(); i++)
+	{
+		const ProcessControlBlock_t *pcb = (const ProcessControlBlock_t *)dyn_array_at(array, i);
+		ASSERT_EQ(records[i].remaining_burst_time, pcb->remaining_burst_time);
+		ASSERT_EQ(records[i].priority, pcb->priority);
+		ASSERT_EQ(records[i].arrival, pcb->arrival);
+		ASSERT_EQ(0U, pcb->deadline);
+		ASSERT_FALSE(pcb->started);
+	}
+}
+
+TEST (load_process_control_blocks_mapped, BadFiles) // the same files load_process_control_blocks turns down
+{
+	EXPECT_EQ(nullptr, load_process_control_blocks_mapped(nullptr));
+	EXPECT_EQ(nullptr, load_process_control_blocks_mapped("fileDNE.bin"));
+
+	FILE *fptr = fopen("test.bin", "wb");
+	fclose(fptr);
+	EXPECT_EQ(nullptr, load_process_control_blocks_mapped("test.bin")); // empty
+
+	fptr = fopen("test.bin", "wb");
+	uint16_t testNum = 24;
+	fwrite(&testNum, sizeof(uint16_t), 1, fptr);
+	fclose(fptr);
+	EXPECT_EQ(nullptr, load_process_control_blocks_mapped("test.bin")); // too short for N
+
+	std::vector<PcbRecord_t> records = {{2, 5, 3}, {3, 6, 1}};
+	write_pcb_file("test.bin", records, 0, 3);
+	EXPECT_EQ(nullptr, load_process_control_blocks_mapped("test.bin")); // too few integers
+	write_pcb_file("test.bin", records, 4);
+	EXPECT_EQ(nullptr, load_process_control_blocks_mapped("test.bin")); // too many integers
+
+	remove("test.bin");
+}
+
+TEST (load_process_control_blocks_mapped, zeroProcesses)
+{
+	write_pcb_file("test.bin", {});
+
+	dyn_array_t * array = load_process_control_blocks_mapped("test.bin");
+	ASSERT_NE(array, nullptr);
+	EXPECT_EQ(dyn_array_size(array), static_cast<size_t>(0));
+
+	pcb_file_t *file = pcb_file_map("test.bin");
+	ASSERT_NE(file, nullptr);
+	EXPECT_EQ(0UL, pcb_file_size(file));
+	EXPECT_EQ(nullptr, pcb_file_records(file));
+	pcb_file_unmap(file);
+
+	dyn_array_destroy(array);
+	remove("test.bin");
+}
+
+TEST (load_process_control_blocks_mapped, MatchesLoader) // same pcbs as the stdio loader, and the records can be read in place
+{
+	std::vector<PcbRecord_t> records = random_pcb_records(100000, 41);
+	write_pcb_file("test.bin", records);
+
+	dyn_array_t * array = load_process_control_blocks_mapped("test.bin");
+	expect_loaded(records, array);
+
+	dyn_array_t * expected = load_process_control_blocks("test.bin");
+	expect_loaded(records, expected);
+
+	pcb_file_t *file = pcb_file_map("test.bin");
+	ASSERT_NE(file, nullptr);
+	ASSERT_EQ(records.size(), pcb_file_size(file));
+	EXPECT_EQ(0, memcmp(records.data(), pcb_file_records(file), records.size() * sizeof(PcbRecord_t)));
+	pcb_file_unmap(file);
+
+	dyn_array_destroy(array);
+	dyn_array_destroy(expected);
+	remove("test.bin");
+}
+
+TEST (pcb_stream_load, LittleEndianBytes) // the file's bytes are decoded as little-endian whatever the host
+{
+	const uint8_t bytes[] = {2, 0, 0, 0,  0x04, 0x03, 0x02, 0x01,  7, 0, 0, 0,  0, 1, 0, 0,  1, 0, 0, 0,  0, 0, 0, 0x80,  0xff, 0xff, 0xff, 0xff};
+	FILE *fptr = fopen("test.bin", "wb");
+	fwrite(bytes, sizeof(bytes), 1, fptr);
 	fclose(fptr);
-	EXPECT_EQ(NULL,load_process_control_blocks("test.bin"));
+
+	fptr = fopen("test.bin", "rb");
+	dyn_array_t * array = pcb_stream_load(fptr, false);
+	fclose(fptr);
+
+	ASSERT_NE(array, nullptr);
+	ASSERT_EQ(2UL, dyn_array_size(array));
+	const ProcessControlBlock_t *pcbs = (const ProcessControlBlock_t *)dyn_array_export(array);
+	EXPECT_EQ(0x01020304U, pcbs[0].remaining_burst_time);
+	EXPECT_EQ(7U, pcbs[0].priority);
+	EXPECT_EQ(256U, pcbs[0].arrival);
+	EXPECT_EQ(1U, pcbs[1].remaining_burst_time);
+	EXPECT_EQ(0x80000000U, pcbs[1].priority);
+	EXPECT_EQ(UINT32_MAX, pcbs[1].arrival);
+
+	dyn_array_destroy(array);
 	remove("test.bin");
 }
 
-//The PCB file is composed of LESS than 1+(3*N) 32-bit integers
-TEST (load_process_control_blocks, tooFewIntegers) 
+TEST (pcb_stream_load, ManyBlocks) // more records than one block, loaded whole, and truncation caught in a later block
 {
-	FILE *fptr = fopen("test.bin", "wb");
-	
-	uint32_t N = 2; // 2 pcbs
-	fwrite(&N, sizeof(uint32_t), 1, fptr);
-
-	uint32_t P1remaining_burst_time = 2;
-	fwrite(&P1remaining_burst_time, sizeof(uint32_t), 1, fptr);
-	uint32_t P1priority = 5;
-	fwrite(&P1priority, sizeof(uint32_t), 1, fptr);
-	uint32_t P1arrival = 3;
-	fwrite(&P1arrival, sizeof(uint32_t), 1, fptr);
+	std::vector<PcbRecord_t> records = random_pcb_records(150000, 43);
+	write_pcb_file("test.bin", records);
 
-	uint32_t P2remaining_burst_time = 3;
-	fwrite(&P2remaining_burst_time, sizeof(uint32_t), 1, fptr);
-	uint32_t P2priority = 6;
-	fwrite(&P2priority, sizeof(uint32_t), 1, fptr);
-	// leaving out arrival of the second process so that the PCB file is NOT composed of 1+(3*N) 32-bit integers
+	dyn_array_t * array = load_process_control_blocks("test.bin");
+	expect_loaded(records, array);
+	dyn_array_destroy(array);
 
-	fclose(fptr);
+	write_pcb_file("test.bin", records, 0, 150001);
+	EXPECT_EQ(nullptr, load_process_control_blocks("test.bin"));
+	write_pcb_file("test.bin", records, 3); // fewer stray bytes than a uint32, the same as always
+	array = load_process_control_blocks("test.bin");
+	expect_loaded(records, array);
+	dyn_array_destroy(array);
 
-	EXPECT_EQ(NULL, load_process_control_blocks("test.bin"));
 	remove("test.bin");
 }
 
-//The PCB file is composed of MORE than 1+(3*N) 32-bit integers
-TEST (load_process_control_blocks, tooManyIntegers) 
+TEST (pcb_stream_load, FromPipe) // streams that can't be mapped or sized up front
 {
-	FILE *fptr = fopen("test.bin", "wb");
-	
-	uint32_t N = 2; // 2 pcbs
-	fwrite(&N, sizeof(uint32_t), 1, fptr);
+	std::vector<PcbRecord_t> records = random_pcb_records(100000, 47);
+	int fds[2];
+	ASSERT_EQ(0, pipe(fds));
+
+	std::thread writer([&]() {
+		uint32_t N = (uint32_t)records.size();
+		EXPECT_EQ((ssize_t)sizeof(N), write(fds[1], &N, sizeof(N)));
+		const char *bytes = (const char *)records.data();
+		size_t left = records.size() * sizeof(PcbRecord_t);
+		while (left > 0)
+		{
+			ssize_t written = write(fds[1], bytes, left);
+			ASSERT_GT(written, 0);
+			bytes += written;
+			left -= (size_t)written;
+		}
+		close(fds[1]);
+	});
 
-	uint32_t P1remaining_burst_time = 2;
-	fwrite(&P1remaining_burst_time, sizeof(uint32_t), 1, fptr);
-	uint32_t P1priority = 5;
-	fwrite(&P1priority, sizeof(uint32_t), 1, fptr);
-	uint32_t P1arrival = 3;
-	fwrite(&P1arrival, sizeof(uint32_t), 1, fptr);
+	FILE *stream = fdopen(fds[0], "rb");
+	dyn_array_t * array = pcb_stream_load(stream, false);
+	writer.join();
+	fclose(stream);
 
-	uint32_t P2remaining_burst_time = 3;
-	fwrite(&P2remaining_burst_time, sizeof(uint32_t), 1, fptr);
-	uint32_t P2priority = 6;
-	fwrite(&P2priority, sizeof(uint32_t), 1, fptr);
-	uint32_t P2arrival = 1;
-	fwrite(&P2arrival, sizeof(uint32_t), 1, fptr);
+	expect_loaded(records, array);
+	dyn_array_destroy(array);
 
-	// Adding burst time of a third process, should not be here
-	uint32_t P3remaining_burst_time = 4;
-	fwrite(&P3remaining_burst_time, sizeof(uint32_t), 1, fptr);
+	EXPECT_EQ(nullptr, pcb_stream_load(NULL, false));
+}
 
+// Reads or rewrites every byte of a file, to corrupt it on purpose
+static std::vector<uint8_t> read_file_bytes(const char *path)
+{
+	std::vector<uint8_t> bytes;
+	FILE *fptr = fopen(path, "rb");
+	for (int c; (c = fgetc(fptr)) != EOF;)
+	{
+		bytes.push_back((uint8_t)c);
+	}
 	fclose(fptr);
-	
-	EXPECT_EQ(NULL, load_process_control_blocks("test.bin"));
+	return bytes;
+}
+
+static void write_file_bytes(const char *path, const std::vector<uint8_t> &bytes)
+{
+	FILE *fptr = fopen(path, "wb");
+	fwrite(bytes.data(), 1, bytes.size(), fptr);
+	fclose(fptr);
+}
+
+TEST (pcb_file_write, BadParams)
+{
+	dyn_array_t *ready_queue = random_ready_queue(10, 3, 10, 10);
+	EXPECT_FALSE(pcb_file_write(NULL, ready_queue, 0, 0));
+	EXPECT_FALSE(pcb_file_write("test.bin", NULL, 0, 0));
+	EXPECT_FALSE(pcb_file_write("test.bin", ready_queue, PCB_FILE_ARRIVAL_SORTED, 0)); // worked out by the writer
+	EXPECT_FALSE(pcb_file_write("test.bin", ready_queue, 0, PCB_FILE_MAX_BLOCK_RECORDS + 1));
+	dyn_array_destroy(ready_queue);
 	remove("test.bin");
 }
 
+TEST (pcb_file_write, RoundTrip) // every loader reads a v2 file back, whatever its block size and flags
+{
+	std::vector<PcbRecord_t> records = random_pcb_records(150000, 53);
+	dyn_array_t *ready_queue = random_ready_queue(150000, 53, 100, 50);
+	const uint32_t flags[] = {0, PCB_FILE_CHECKSUMS};
+	const size_t blocks[] = {0, 1000, 150000};
+
+	for (uint32_t flag : flags)
+	{
+		for (size_t block : blocks)
+		{
+			ASSERT_TRUE(pcb_file_write("test.bin", ready_queue, flag, block));
+
+			pcb_file_t *file = pcb_file_map("test.bin");
+			ASSERT_NE(file, nullptr);
+			EXPECT_EQ((uint32_t)PCB_FILE_VERSION, pcb_file_version(file));
+			EXPECT_EQ(flag, pcb_file_flags(file)); // random arrivals, not sorted
+			EXPECT_EQ(records.size(), pcb_file_size(file));
+			EXPECT_EQ(nullptr, pcb_file_records(file));
+			dyn_array_t *array = pcb_file_to_dyn_array(file);
+			expect_loaded(records, array);
+			dyn_array_destroy(array);
+			pcb_file_unmap(file);
+
+			array = load_process_control_blocks("test.bin");
+			expect_loaded(records, array);
+			dyn_array_destroy(array);
+
+			FILE *fptr = fopen("test.bin", "rb");
+			array = pcb_stream_load(fptr, false);
+			fclose(fptr);
+			expect_loaded(records, array);
+			dyn_array_destroy(array);
+		}
+	}
 
-/*
-*  Tests related to zero processes in a valid binary file, N=0
-**/
+	dyn_array_destroy(ready_queue);
+	remove("test.bin");
+}
 
-TEST (load_process_control_blocks, zeroProcesses) 
+TEST (pcb_file_write, DeadlinesAndEmpty)
 {
-	FILE *fptr = fopen("test.bin", "wb");
-	
-	uint32_t N = 0;
-	fwrite(&N, sizeof(uint32_t), 1, fptr);
+	ProcessControlBlock_t pcbs[3] = {{5, 1, 0, 9, false}, {2, 2, 4, 7, false}, {3, 3, 4, 12, false}};
+	dyn_array_t *ready_queue = dyn_array_import(pcbs, 3, sizeof(ProcessControlBlock_t), NULL);
+	ASSERT_TRUE(pcb_file_write("test.bin", ready_queue, PCB_FILE_HAS_DEADLINES | PCB_FILE_CHECKSUMS, 2));
+
+	pcb_file_t *file = pcb_file_map("test.bin");
+	ASSERT_NE(file, nullptr);
+	EXPECT_EQ(PCB_FILE_ARRIVAL_SORTED | PCB_FILE_HAS_DEADLINES | PCB_FILE_CHECKSUMS, pcb_file_flags(file));
+	pcb_file_unmap(file);
+
+	dyn_array_t *array = load_process_control_blocks("test.bin"); // the header says there are deadlines, the caller needn't
+	ASSERT_NE(array, nullptr);
+	ASSERT_EQ(3UL, dyn_array_size(array));
+	for (size_t i = 0; i < 3; i++)
+	{
+		const ProcessControlBlock_t *pcb = (const ProcessControlBlock_t *)dyn_array_at(array, i);
+		EXPECT_EQ(pcbs[i].remaining_burst_time, pcb->remaining_burst_time);
+		EXPECT_EQ(pcbs[i].arrival, pcb->arrival);
+		EXPECT_EQ(pcbs[i].deadline, pcb->deadline);
+	}
+	dyn_array_destroy(array);
+	dyn_array_destroy(ready_queue);
 
-	fclose(fptr);
+	ready_queue = dyn_array_create(0, sizeof(ProcessControlBlock_t), NULL);
+	ASSERT_TRUE(pcb_file_write("test.bin", ready_queue, 0, 0));
+	array = load_process_control_blocks("test.bin");
+	ASSERT_NE(array, nullptr);
+	EXPECT_EQ(0UL, dyn_array_size(array));
+	dyn_array_destroy(array);
+	dyn_array_destroy(ready_queue);
+	remove("test.bin");
+}
 
-	dyn_array_t * array = load_process_control_blocks("test.bin");
+TEST (pcb_file_write, SortedSchedulesTheSame) // a sorted file skips the arrival sort and schedules exactly as before
+{
+	dyn_array_t *ready_queue = random_ready_queue(50000, 59, 100, 50);
+	ProcessControlBlock_t *pcbs = (ProcessControlBlock_t *)dyn_array_export(ready_queue);
+	std::stable_sort(pcbs, pcbs + dyn_array_size(ready_queue),
+		[](const ProcessControlBlock_t &a, const ProcessControlBlock_t &b) { return a.arrival < b.arrival; });
+	ASSERT_TRUE(pcb_file_write("test.bin", ready_queue, PCB_FILE_CHECKSUMS, 4096));
+
+	pcb_file_t *file = pcb_file_map("test.bin");
+	ASSERT_NE(file, nullptr);
+	EXPECT_EQ(PCB_FILE_ARRIVAL_SORTED | PCB_FILE_CHECKSUMS, pcb_file_flags(file));
+	pcb_file_unmap(file);
+
+	dyn_array_t *array = load_process_control_blocks("test.bin");
+	ASSERT_NE(array, nullptr);
+	ScheduleResult_t loaded = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+		.waiting_latency = {}, .turnaround_latency = {}};
+	ScheduleResult_t expected = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+		.waiting_latency = {}, .turnaround_latency = {}};
+	ASSERT_TRUE(schedule_algorithm(array, &loaded, SCHEDULE_RR, 7, NULL));
+	ASSERT_TRUE(schedule_algorithm(ready_queue, &expected, SCHEDULE_RR, 7, NULL));
+	EXPECT_EQ(expected.total_run_time, loaded.total_run_time);
+	EXPECT_DOUBLE_EQ(expected.average_waiting_time, loaded.average_waiting_time);
+	EXPECT_DOUBLE_EQ(expected.average_turnaround_time, loaded.average_turnaround_time);
 
-	ASSERT_NE(array, nullptr); // array is not null
-	EXPECT_EQ(dyn_array_size(array), static_cast<size_t>(0)); // array is empty
+	dyn_array_destroy(array);
+	dyn_array_destroy(ready_queue);
+	remove("test.bin");
+}
+
+TEST (pcb_file_write, CorruptFiles) // checksums, the sorted flag and the block table are all checked
+{
+	dyn_array_t *ready_queue = random_ready_queue(20000, 61, 100, 50);
+	ProcessControlBlock_t *pcbs = (ProcessControlBlock_t *)dyn_array_export(ready_queue);
+	for (size_t i = 0; i < 20000; i++)
+	{
+		pcbs[i].arrival = (uint32_t)i;
+	}
+	ASSERT_TRUE(pcb_file_write("test.bin", ready_queue, PCB_FILE_CHECKSUMS, 1000));
+	const std::vector<uint8_t> good = read_file_bytes("test.bin");
+	const size_t firstRecord = 32 + 20 * 16;
+	ASSERT_EQ(firstRecord + 20000 * 12, good.size());
+
+	std::vector<uint8_t> bytes = good;
+	bytes[firstRecord + 15000 * 12] ^= 1; // a burst in block 15
+	write_file_bytes("test.bin", bytes);
+	EXPECT_EQ(nullptr, load_process_control_blocks("test.bin"));
+	EXPECT_EQ(nullptr, load_process_control_blocks_mapped("test.bin"));
+	FILE *fptr = fopen("test.bin", "rb");
+	EXPECT_EQ(nullptr, pcb_stream_load(fptr, false));
+	fclose(fptr);
 
+	bytes[12] &= (uint8_t)~PCB_FILE_CHECKSUMS; // the same damage goes unnoticed without checksums
+	write_file_bytes("test.bin", bytes);
+	dyn_array_t *array = load_process_control_blocks("test.bin");
+	ASSERT_NE(array, nullptr);
+	EXPECT_EQ(pcbs[15000].remaining_burst_time ^ 1, ((const ProcessControlBlock_t *)dyn_array_at(array, 15000))->remaining_burst_time);
 	dyn_array_destroy(array);
+
+	bytes = good;
+	bytes[12] &= (uint8_t)~PCB_FILE_CHECKSUMS;
+	bytes[firstRecord + 12000 * 12 + 8] = 0xff; // arrival 12000 jumps ahead of 12001
+	write_file_bytes("test.bin", bytes);
+	EXPECT_EQ(nullptr, load_process_control_blocks("test.bin"));
+	bytes = good;
+	bytes[12] &= (uint8_t)~PCB_FILE_CHECKSUMS;
+	bytes[firstRecord + 12999 * 12 + 10] = 1; // the last arrival of block 12 ahead of block 13
+	write_file_bytes("test.bin", bytes);
+	EXPECT_EQ(nullptr, load_process_control_blocks("test.bin"));
+	fptr = fopen("test.bin", "rb");
+	EXPECT_EQ(nullptr, pcb_stream_load(fptr, false));
+	fclose(fptr);
+
+	bytes = good;
+	bytes.pop_back(); // truncated
+	write_file_bytes("test.bin", bytes);
+	EXPECT_EQ(nullptr, load_process_control_blocks("test.bin"));
+	fptr = fopen("test.bin", "rb");
+	EXPECT_EQ(nullptr, pcb_stream_load(fptr, false));
+	fclose(fptr);
+
+	bytes = good;
+	bytes.push_back(0); // extra data
+	write_file_bytes("test.bin", bytes);
+	EXPECT_EQ(nullptr, load_process_control_blocks("test.bin"));
+	fptr = fopen("test.bin", "rb");
+	EXPECT_EQ(nullptr, pcb_stream_load(fptr, false));
+	fclose(fptr);
+
+	bytes = good;
+	bytes[8] = 3; // a version this loader doesn't know
+	write_file_bytes("test.bin", bytes);
+	EXPECT_EQ(nullptr, load_process_control_blocks("test.bin"));
+
+	bytes = good;
+	bytes[32 + 5 * 16] += 12; // block 5 points past its records
+	write_file_bytes("test.bin", bytes);
+	EXPECT_EQ(nullptr, load_process_control_blocks_mapped("test.bin"));
+	fptr = fopen("test.bin", "rb");
+	EXPECT_EQ(nullptr, pcb_stream_load(fptr, false));
+	fclose(fptr);
+
+	dyn_array_destroy(ready_queue);
 	remove("test.bin");
 }
 
-/*
-*  Tests related to one process in a valid binary file, N=1
-**/
+TEST (pcb_file_write, HugeCountFailsFast) // a header claiming 2^59 one-record blocks must not size the offset table from the claim
+{
+	std::vector<uint8_t> bytes(32 + 4 * 16, 0);
+	memcpy(bytes.data(), "PCBFILE2", 8);
+	bytes[8] = 2; // version
+	bytes[16 + 7] = 0x08; // count 2^59, whose table would still fit a size_t
+	bytes[24] = 1; // block_records
+	write_file_bytes("test.bin", bytes);
+
+	EXPECT_EQ(nullptr, load_process_control_blocks("test.bin"));
+	EXPECT_EQ(nullptr, load_process_control_blocks_mapped("test.bin"));
+	FILE *fptr = fopen("test.bin", "rb");
+	ASSERT_NE(fptr, nullptr);
+	EXPECT_EQ(nullptr, pcb_stream_load(fptr, false));
+	fclose(fptr);
+	remove("test.bin");
+}
 
-TEST (load_process_control_blocks, oneProcess) 
+// A random ready_queue with deadlines a little after each arrival, for the files that store them
+static dyn_array_t *random_deadline_queue(uint32_t numPCBs, uint32_t seed)
 {
-	FILE *fptr = fopen("test.bin", "wb");
-	
-	uint32_t N = 1;
-	fwrite(&N, sizeof(uint32_t), 1, fptr);
+	dyn_array_t *ready_queue = random_ready_queue(numPCBs, seed, 100, 50);
+	ProcessControlBlock_t *pcbs = (ProcessControlBlock_t *)dyn_array_export(ready_queue);
+	for (size_t i = 0; i < numPCBs; i++)
+	{
+		pcbs[i].deadline = pcbs[i].arrival + pcbs[i].remaining_burst_time + (uint32_t)(i % 97);
+	}
+	return ready_queue;
+}
 
-	uint32_t P1remaining_burst_time = 2;
-	fwrite(&P1remaining_burst_time, sizeof(uint32_t), 1, fptr);
-	uint32_t P1priority = 5;
-	fwrite(&P1priority, sizeof(uint32_t), 1, fptr);
-	uint32_t P1arrival = 3;
-	fwrite(&P1arrival, sizeof(uint32_t), 1, fptr);
+// Checks every field of a loaded ready_queue against the pcbs it was written from, fields outside columns being 0
+static void expect_columns(const dyn_array_t *expected, const dyn_array_t *array, uint32_t columns)
+{
+	ASSERT_NE(array, nullptr);
+	ASSERT_EQ(dyn_array_size(expected), dyn_array_size(array));
+	for (size_t i = 0; i < dyn_array_size(array); i++)
+	{
+		const ProcessControlBlock_t *want = (const ProcessControlBlock_t *)dyn_array_at(expected, i);
+		const ProcessControlBlock_t *pcb = (const ProcessControlBlock_t *)dyn_array_at(array, i);
+		ASSERT_EQ(columns & PCB_COLUMN_BIT(PCB_COLUMN_BURST) ? want->remaining_burst_time : 0, pcb->remaining_burst_time);
+		ASSERT_EQ(columns & PCB_COLUMN_BIT(PCB_COLUMN_PRIORITY) ? want->priority : 0, pcb->priority);
+		ASSERT_EQ(columns & PCB_COLUMN_BIT(PCB_COLUMN_ARRIVAL) ? want->arrival : 0, pcb->arrival);
+		ASSERT_EQ(columns & PCB_COLUMN_BIT(PCB_COLUMN_DEADLINE) ? want->deadline : 0, pcb->deadline);
+		ASSERT_FALSE(pcb->started);
+	}
+}
+
+TEST (pcb_file_columns, RoundTrip) // every loader reads a columnar file back, and the columns can be read in place
+{
+	dyn_array_t *ready_queue = random_deadline_queue(150000, 67);
+	const ProcessControlBlock_t *pcbs = (const ProcessControlBlock_t *)dyn_array_export(ready_queue);
+	ASSERT_TRUE(pcb_file_write("test.bin", ready_queue, PCB_FILE_COLUMNAR | PCB_FILE_HAS_DEADLINES | PCB_FILE_CHECKSUMS, 0));
+
+	pcb_file_t *file = pcb_file_map("test.bin");
+	ASSERT_NE(file, nullptr);
+	EXPECT_EQ(PCB_FILE_COLUMNAR | PCB_FILE_HAS_DEADLINES | PCB_FILE_CHECKSUMS, pcb_file_flags(file));
+	EXPECT_EQ(nullptr, pcb_file_records(file));
+	const uint32_t *bursts = pcb_file_column(file, PCB_COLUMN_BURST);
+	const uint32_t *deadlines = pcb_file_column(file, PCB_COLUMN_DEADLINE);
+	ASSERT_NE(bursts, nullptr);
+	ASSERT_NE(deadlines, nullptr);
+	EXPECT_EQ(0U, (uintptr_t)bursts % 64);
+	EXPECT_EQ(0U, (uintptr_t)deadlines % 64);
+	for (size_t i = 0; i < 150000; i++)
+	{
+		ASSERT_EQ(pcbs[i].remaining_burst_time, bursts[i]);
+		ASSERT_EQ(pcbs[i].deadline, deadlines[i]);
+	}
+	EXPECT_EQ(nullptr, pcb_file_column(file, PCB_COLUMN_KNOWN));
+	dyn_array_t *array = pcb_file_to_dyn_array(file);
+	expect_columns(ready_queue, array, PCB_COLUMNS_ALL);
+	dyn_array_destroy(array);
+	pcb_file_unmap(file);
 
+	array = load_process_control_blocks("test.bin");
+	expect_columns(ready_queue, array, PCB_COLUMNS_ALL);
+	dyn_array_destroy(array);
+
+	FILE *fptr = fopen("test.bin", "rb");
+	array = pcb_stream_load(fptr, false);
 	fclose(fptr);
+	expect_columns(ready_queue, array, PCB_COLUMNS_ALL);
+	dyn_array_destroy(array);
 
-	dyn_array_t * array = load_process_control_blocks("test.bin");
+	dyn_array_t *empty = dyn_array_create(0, sizeof(ProcessControlBlock_t), NULL);
+	ASSERT_TRUE(pcb_file_write("test.bin", empty, PCB_FILE_COLUMNAR, 0));
+	array = load_process_control_blocks("test.bin");
+	ASSERT_NE(array, nullptr);
+	EXPECT_EQ(0UL, dyn_array_size(array));
+	dyn_array_destroy(array);
+	dyn_array_destroy(empty);
 
-	ASSERT_NE(array, nullptr); // array is not null
-	EXPECT_EQ(dyn_array_size(array), static_cast<size_t>(1)); // array has 1 process
+	dyn_array_destroy(ready_queue);
+	remove("test.bin");
+}
 
-	ProcessControlBlock_t* pcb = (ProcessControlBlock_t *)dyn_array_at(array,0);
+TEST (pcb_file_columns, ProjectionSchedulesTheSame) // each algorithm gets the same result from just the columns it needs
+{
+	dyn_array_t *ready_queue = random_deadline_queue(20000, 71);
+	const ScheduleAlgorithm_t algorithms[] = {SCHEDULE_FCFS, SCHEDULE_SJF, SCHEDULE_PRIORITY, SCHEDULE_RR, SCHEDULE_SRT, SCHEDULE_EDF, SCHEDULE_EDF_PREEMPTIVE};
+	const uint32_t flags[] = {PCB_FILE_COLUMNAR | PCB_FILE_HAS_DEADLINES, PCB_FILE_HAS_DEADLINES}; // projected columns or a row file cleared
+
+	for (uint32_t flag : flags)
+	{
+		ASSERT_TRUE(pcb_file_write("test.bin", ready_queue, flag, 0));
+		for (ScheduleAlgorithm_t algorithm : algorithms)
+		{
+			uint32_t columns = pcb_file_policy_columns(algorithm);
+			dyn_array_t *array = load_process_control_blocks_columns("test.bin", columns);
+			expect_columns(ready_queue, array, columns);
+
+			ScheduleResult_t loaded = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+				.waiting_latency = {}, .turnaround_latency = {}};
+			ScheduleResult_t expected = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+				.waiting_latency = {}, .turnaround_latency = {}};
+			ASSERT_TRUE(schedule_algorithm(array, &loaded, algorithm, 5, NULL));
+			ASSERT_TRUE(schedule_algorithm(ready_queue, &expected, algorithm, 5, NULL));
+			EXPECT_EQ(expected.total_run_time, loaded.total_run_time) << algorithm;
+			EXPECT_DOUBLE_EQ(expected.average_waiting_time, loaded.average_waiting_time) << algorithm;
+			EXPECT_DOUBLE_EQ(expected.average_turnaround_time, loaded.average_turnaround_time) << algorithm;
+			dyn_array_destroy(array);
+		}
+	}
 
-	EXPECT_EQ(P1remaining_burst_time, pcb->remaining_burst_time);
-	EXPECT_EQ(P1priority, pcb->priority);
-	EXPECT_EQ(P1arrival, pcb->arrival);
-	EXPECT_FALSE(pcb->started);
+	EXPECT_EQ(PCB_COLUMN_BIT(PCB_COLUMN_BURST) | PCB_COLUMN_BIT(PCB_COLUMN_ARRIVAL), pcb_file_policy_columns(SCHEDULE_FCFS));
+	EXPECT_EQ(nullptr, load_process_control_blocks_columns(NULL, PCB_COLUMNS_ALL));
+	dyn_array_destroy(ready_queue);
+	remove("test.bin");
+}
 
+TEST (pcb_file_columns, UnreadColumnsUnchecked) // a column that isn't loaded isn't summed either, a loaded one is
+{
+	dyn_array_t *ready_queue = random_deadline_queue(10000, 73);
+	ASSERT_TRUE(pcb_file_write("test.bin", ready_queue, PCB_FILE_COLUMNAR | PCB_FILE_CHECKSUMS, 0));
+
+	pcb_file_t *file = pcb_file_map("test.bin");
+	ASSERT_NE(file, nullptr);
+	size_t priorityOffset = (size_t)((const uint8_t *)pcb_file_column(file, PCB_COLUMN_PRIORITY) - (const uint8_t *)pcb_file_column(file, PCB_COLUMN_BURST));
+	pcb_file_unmap(file);
+	std::vector<uint8_t> bytes = read_file_bytes("test.bin");
+	size_t burstOffset = 32 + 3 * 16;
+	burstOffset += (64 - burstOffset % 64) % 64;
+	bytes[burstOffset + priorityOffset + 400] ^= 0x10; // a priority
+	write_file_bytes("test.bin", bytes);
+
+	EXPECT_EQ(nullptr, load_process_control_blocks("test.bin"));
+	EXPECT_EQ(nullptr, load_process_control_blocks_columns("test.bin", pcb_file_policy_columns(SCHEDULE_PRIORITY)));
+	dyn_array_t *array = load_process_control_blocks_columns("test.bin", pcb_file_policy_columns(SCHEDULE_SJF));
+	expect_columns(ready_queue, array, pcb_file_policy_columns(SCHEDULE_SJF));
 	dyn_array_destroy(array);
+
+	dyn_array_destroy(ready_queue);
 	remove("test.bin");
 }
 
-/*
-*  Tests related to multiple processes in a valid binary file, N = 10
-**/
+TEST (pcb_file_columns, LaterColumnsSkipped) // a file with a column added after this code still loads
+{
+	std::vector<uint8_t> bytes(32 + 5 * 16 + 5 * 8, 0);
+	const uint8_t magic[] = {'P', 'C', 'B', 'F', 'I', 'L', 'E', '2'};
+	std::copy(magic, magic + 8, bytes.begin());
+	bytes[8] = PCB_FILE_VERSION;
+	bytes[12] = PCB_FILE_COLUMNAR | PCB_FILE_HAS_DEADLINES;
+	bytes[16] = 2; // records
+	bytes[24] = 5; // columns
+	for (size_t c = 0; c < 5; c++)
+	{
+		size_t offset = 32 + 5 * 16 + c * 8;
+		bytes[32 + c * 16] = (uint8_t)offset;
+		bytes[offset] = (uint8_t)(10 * c + 1);
+		bytes[offset + 4] = (uint8_t)(10 * c + 2);
+	}
+	write_file_bytes("test.bin", bytes);
+
+	dyn_array_t *array = load_process_control_blocks("test.bin");
+	ASSERT_NE(array, nullptr);
+	ASSERT_EQ(2UL, dyn_array_size(array));
+	const ProcessControlBlock_t *pcb = (const ProcessControlBlock_t *)dyn_array_at(array, 1);
+	EXPECT_EQ(2U, pcb->remaining_burst_time);
+	EXPECT_EQ(12U, pcb->priority);
+	EXPECT_EQ(22U, pcb->arrival);
+	EXPECT_EQ(32U, pcb->deadline);
+	dyn_array_destroy(array);
 
-TEST (load_process_control_blocks, multipleProcesses) 
+	FILE *fptr = fopen("test.bin", "rb");
+	array = pcb_stream_load(fptr, false);
+	fclose(fptr);
+	ASSERT_NE(array, nullptr);
+	EXPECT_EQ(31U, ((const ProcessControlBlock_t *)dyn_array_at(array, 0))->deadline);
+	dyn_array_destroy(array);
+
+	bytes[24] = 3; // claims deadlines but has no deadline column
+	write_file_bytes("test.bin", bytes);
+	EXPECT_EQ(nullptr, load_process_control_blocks("test.bin"));
+	remove("test.bin");
+}
+
+// A random ready_queue sorted by arrival, the way traces are recorded
+static dyn_array_t *sorted_ready_queue(uint32_t numPCBs, uint32_t seed)
 {
-	FILE *fptr = fopen("test.bin", "wb");
-	
-	uint32_t N = 10;
-	fwrite(&N, sizeof(uint32_t), 1, fptr);
+	dyn_array_t *ready_queue = random_deadline_queue(numPCBs, seed);
+	ProcessControlBlock_t *pcbs = (ProcessControlBlock_t *)dyn_array_export(ready_queue);
+	std::stable_sort(pcbs, pcbs + numPCBs, [](const ProcessControlBlock_t &a, const ProcessControlBlock_t &b) { return a.arrival < b.arrival; });
+	return ready_queue;
+}
 
-	uint32_t burst_times[10] = {2, 3, 7, 9, 0, 15, 8, 3, 6, 9};
-	uint32_t priorities[10] = {5, 6, 4, 5, 10, 1, 9, 4, 7, 8};
-	uint32_t arrivals[10] = {3, 8, 2, 1, 30, 4, 10, 5, 8, 9};
+TEST (pcb_trace, BadParams)
+{
+	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+		.waiting_latency = {}, .turnaround_latency = {}};
+	dyn_array_t *ready_queue = sorted_ready_queue(10, 79);
+	size_t decoded;
+	EXPECT_FALSE(pcb_trace_write(NULL, ready_queue, 0));
+	EXPECT_FALSE(pcb_trace_write(stdout, NULL, 0));
+	EXPECT_FALSE(pcb_trace_write(stdout, ready_queue, 0x10));
+	EXPECT_FALSE(pcb_trace_convert(NULL, stdout, false));
+	EXPECT_EQ(nullptr, pcb_trace_open(NULL));
+	EXPECT_FALSE(pcb_trace_read(NULL, NULL, 0, &decoded));
+	EXPECT_EQ(nullptr, pcb_trace_load(NULL));
+	EXPECT_FALSE(pcb_trace_replay(NULL, SCHEDULE_FCFS, 0, &result));
+
+	FILE *fptr = fopen("test.trace", "wb");
+	ASSERT_TRUE(pcb_trace_write(fptr, ready_queue, 0));
+	fclose(fptr);
+	fptr = fopen("test.trace", "rb");
+	EXPECT_FALSE(pcb_trace_replay(fptr, SCHEDULE_RR, 0, &result)); // RR without a quantum
+	fclose(fptr);
 
-	size_t i;
+	write_pcb_file("test.trace", random_pcb_records(10, 79));
+	fptr = fopen("test.trace", "rb");
+	EXPECT_EQ(nullptr, pcb_trace_open(fptr)); // a pcb.bin isn't a trace
+	fclose(fptr);
 
-	for (i = 0; i < 10; i++) {
-		fwrite(&burst_times[i], sizeof(uint32_t), 1, fptr);
-		fwrite(&priorities[i], sizeof(uint32_t), 1, fptr);
-		fwrite(&arrivals[i], sizeof(uint32_t), 1, fptr);
+	dyn_array_destroy(ready_queue);
+	remove("test.trace");
+}
+
+TEST (pcb_trace, ConvertRoundTrip) // pcb.bin in, the same pcbs out of every loader, in far fewer bytes
+{
+	dyn_array_t *ready_queue = sorted_ready_queue(150000, 83);
+	std::vector<PcbRecord_t> records;
+	for (size_t i = 0; i < dyn_array_size(ready_queue); i++)
+	{
+		const ProcessControlBlock_t *pcb = (const ProcessControlBlock_t *)dyn_array_at(ready_queue, i);
+		records.push_back({pcb->remaining_burst_time, pcb->priority, pcb->arrival});
+	}
+	write_pcb_file("test.bin", records);
+
+	FILE *input = fopen("test.bin", "rb");
+	FILE *output = fopen("test.trace", "wb");
+	ASSERT_TRUE(pcb_trace_convert(input, output, false));
+	fclose(input);
+	fclose(output);
+	EXPECT_LT(read_file_bytes("test.trace").size() * 3, read_file_bytes("test.bin").size()); // about 4 bytes a record instead of 12
+
+	dyn_array_t *array = load_process_control_blocks("test.trace");
+	expect_loaded(records, array);
+	dyn_array_destroy(array);
+	array = load_process_control_blocks_columns("test.trace", pcb_file_policy_columns(SCHEDULE_SJF));
+	expect_columns(ready_queue, array, pcb_file_policy_columns(SCHEDULE_SJF));
+	dyn_array_destroy(array);
+
+	input = fopen("test.trace", "rb");
+	pcb_trace_reader_t *reader = pcb_trace_open(input);
+	ASSERT_NE(reader, nullptr);
+	EXPECT_EQ(150000UL, pcb_trace_size(reader));
+	EXPECT_EQ(0U, pcb_trace_flags(reader));
+	std::vector<ProcessControlBlock_t> pcbs(7);
+	size_t total = 0;
+	for (size_t decoded = 1; decoded > 0; total += decoded) // odd sized reads straddle the buffer refills
+	{
+		ASSERT_TRUE(pcb_trace_read(reader, pcbs.data(), pcbs.size(), &decoded));
+		for (size_t i = 0; i < decoded; i++)
+		{
+			ASSERT_EQ(records[total + i].arrival, pcbs[i].arrival);
+			ASSERT_EQ(records[total + i].remaining_burst_time, pcbs[i].remaining_burst_time);
+			ASSERT_EQ(records[total + i].priority, pcbs[i].priority);
+		}
 	}
+	EXPECT_EQ(150000UL, total);
+	pcb_trace_close(reader);
+	fclose(input);
+
+	dyn_array_destroy(ready_queue);
+	remove("test.bin");
+	remove("test.trace");
+}
 
+TEST (pcb_trace, DeadlinesAndUnsorted) // any uint32_t values round trip, arrivals going backwards and deadlines before arrivals too
+{
+	ProcessControlBlock_t pcbs[4] = {{5, 1, 100, 9, false}, {UINT32_MAX, UINT32_MAX, 0, UINT32_MAX, false}, {0, 0, UINT32_MAX, 0, false}, {3, 3, 4, 12, false}};
+	dyn_array_t *ready_queue = dyn_array_import(pcbs, 4, sizeof(ProcessControlBlock_t), NULL);
+	FILE *fptr = fopen("test.trace", "wb");
+	ASSERT_TRUE(pcb_trace_write(fptr, ready_queue, PCB_TRACE_HAS_DEADLINES));
 	fclose(fptr);
 
-	dyn_array_t * array = load_process_control_blocks("test.bin");
+	fptr = fopen("test.trace", "rb");
+	dyn_array_t *array = pcb_trace_load(fptr);
+	fclose(fptr);
+	expect_columns(ready_queue, array, PCB_COLUMNS_ALL);
+	dyn_array_destroy(array);
 
-	ASSERT_NE(array, nullptr); // array is not null
-	EXPECT_EQ(dyn_array_size(array), static_cast<size_t>(10)); // array has 10 processes
+	ScheduleResult_t result = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+		.waiting_latency = {}, .turnaround_latency = {}};
+	fptr = fopen("test.trace", "rb");
+	EXPECT_FALSE(pcb_trace_replay(fptr, SCHEDULE_FCFS, 0, &result)); // a session needs arrivals in order
+	fclose(fptr);
 
-	for (i = 0; i < 10; i++) {
-		ProcessControlBlock_t* pcb = (ProcessControlBlock_t *)dyn_array_at(array,i);
-		ASSERT_NE(pcb, nullptr); // pcb is not null
+	dyn_array_destroy(ready_queue);
+	ready_queue = dyn_array_create(0, sizeof(ProcessControlBlock_t), NULL);
+	fptr = fopen("test.trace", "wb");
+	ASSERT_TRUE(pcb_trace_write(fptr, ready_queue, 0));
+	fclose(fptr);
+	array = load_process_control_blocks("test.trace");
+	ASSERT_NE(array, nullptr);
+	EXPECT_EQ(0UL, dyn_array_size(array));
+	dyn_array_destroy(array);
 
-		EXPECT_EQ(burst_times[i], pcb->remaining_burst_time);
-		EXPECT_EQ(priorities[i], pcb->priority);
-		EXPECT_EQ(arrivals[i], pcb->arrival);
-		EXPECT_FALSE(pcb->started);
+	dyn_array_destroy(ready_queue);
+	remove("test.trace");
+}
+
+TEST (pcb_trace, ReplayMatchesBatch) // streamed into a session chunk by chunk, every policy ends where the batch run does
+{
+	dyn_array_t *ready_queue = sorted_ready_queue(30000, 89);
+	FILE *fptr = fopen("test.trace", "wb");
+	ASSERT_TRUE(pcb_trace_write(fptr, ready_queue, PCB_TRACE_HAS_DEADLINES));
+	fclose(fptr);
+
+	const ScheduleAlgorithm_t algorithms[] = {SCHEDULE_FCFS, SCHEDULE_SJF, SCHEDULE_PRIORITY, SCHEDULE_RR, SCHEDULE_SRT, SCHEDULE_EDF, SCHEDULE_EDF_PREEMPTIVE};
+	for (ScheduleAlgorithm_t algorithm : algorithms)
+	{
+		ScheduleResult_t replayed = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+			.waiting_latency = {}, .turnaround_latency = {}};
+		ScheduleResult_t expected = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+			.waiting_latency = {}, .turnaround_latency = {}};
+		fptr = fopen("test.trace", "rb");
+		ASSERT_TRUE(pcb_trace_replay(fptr, algorithm, 6, &replayed));
+		fclose(fptr);
+		ASSERT_TRUE(schedule_algorithm(ready_queue, &expected, algorithm, 6, NULL));
+		EXPECT_EQ(expected.total_run_time, replayed.total_run_time) << algorithm;
+		EXPECT_NEAR(expected.average_waiting_time, replayed.average_waiting_time, 1e-6) << algorithm;
+		EXPECT_NEAR(expected.average_turnaround_time, replayed.average_turnaround_time, 1e-6) << algorithm;
+		EXPECT_EQ(expected.waiting_latency.p99, replayed.waiting_latency.p99) << algorithm;
 	}
 
-	dyn_array_destroy(array);
+	dyn_array_destroy(ready_queue);
+	remove("test.trace");
+}
+
+TEST (pcb_trace, ConvertAndReplayThroughPipe) // converted on one thread and replayed on another, neither holding the trace
+{
+	dyn_array_t *ready_queue = sorted_ready_queue(100000, 97);
+	std::vector<PcbRecord_t> records;
+	for (size_t i = 0; i < dyn_array_size(ready_queue); i++)
+	{
+		const ProcessControlBlock_t *pcb = (const ProcessControlBlock_t *)dyn_array_at(ready_queue, i);
+		records.push_back({pcb->remaining_burst_time, pcb->priority, pcb->arrival});
+	}
+	write_pcb_file("test.bin", records);
+	int fds[2];
+	ASSERT_EQ(0, pipe(fds));
+
+	std::thread converter([&]() {
+		FILE *input = fopen("test.bin", "rb");
+		FILE *output = fdopen(fds[1], "wb");
+		EXPECT_TRUE(pcb_trace_convert(input, output, false));
+		fclose(input);
+		fclose(output);
+	});
+
+	ScheduleResult_t replayed = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+		.waiting_latency = {}, .turnaround_latency = {}};
+	ScheduleResult_t expected = {.average_waiting_time = 0, .average_turnaround_time = 0, .total_run_time = 0, .deadline_misses = 0, .max_lateness = 0,
+		.waiting_latency = {}, .turnaround_latency = {}};
+	FILE *stream = fdopen(fds[0], "rb");
+	EXPECT_TRUE(pcb_trace_replay(stream, SCHEDULE_SRT, 0, &replayed));
+	converter.join();
+	fclose(stream);
+
+	ProcessControlBlock_t *pcbs = (ProcessControlBlock_t *)dyn_array_export(ready_queue);
+	for (size_t i = 0; i < dyn_array_size(ready_queue); i++)
+	{
+		pcbs[i].deadline = 0; // pcb.bin has no deadlines
+	}
+	ASSERT_TRUE(schedule_algorithm(ready_queue, &expected, SCHEDULE_SRT, 0, NULL));
+	EXPECT_EQ(expected.total_run_time, replayed.total_run_time);
+	EXPECT_NEAR(expected.average_waiting_time, replayed.average_waiting_time, 1e-6);
+
+	dyn_array_destroy(ready_queue);
+	remove("test.bin");
+}
+
+TEST (pcb_trace, CorruptFiles) // cut short, trailing bytes, overlong varints and bad pcb.bin input are all turned down
+{
+	dyn_array_t *ready_queue = sorted_ready_queue(5000, 101);
+	FILE *fptr = fopen("test.trace", "wb");
+	ASSERT_TRUE(pcb_trace_write(fptr, ready_queue, 0));
+	fclose(fptr);
+	const std::vector<uint8_t> good = read_file_bytes("test.trace");
+
+	std::vector<uint8_t> bytes = good;
+	bytes.pop_back();
+	write_file_bytes("test.trace", bytes);
+	EXPECT_EQ(nullptr, load_process_control_blocks("test.trace"));
+
+	bytes = good;
+	bytes.push_back(0);
+	write_file_bytes("test.trace", bytes);
+	EXPECT_EQ(nullptr, load_process_control_blocks("test.trace"));
+
+	bytes = good;
+	bytes[16] += 1; // one more record than there is
+	write_file_bytes("test.trace", bytes);
+	EXPECT_EQ(nullptr, load_process_control_blocks("test.trace"));
+
+	bytes = std::vector<uint8_t>(good.begin(), good.begin() + 24);
+	bytes[16] = 1;
+	for (uint8_t byte : {0x80, 0x80, 0x80, 0x80, 0x80, 0x01, 0x01, 0x01}) // an arrival delta too long for 35 bits
+	{
+		bytes.push_back(byte);
+	}
+	std::fill(bytes.begin() + 17, bytes.begin() + 24, 0);
+	write_file_bytes("test.trace", bytes);
+	EXPECT_EQ(nullptr, load_process_control_blocks("test.trace"));
+	bytes.erase(bytes.begin() + 24, bytes.begin() + 27);
+	bytes[24] = 0x01; // a first arrival of -1
+	write_file_bytes("test.trace", bytes);
+	EXPECT_EQ(nullptr, load_process_control_blocks("test.trace"));
+
+	std::vector<PcbRecord_t> records = {{2, 5, 3}, {3, 6, 4}};
+	const std::pair<size_t, uint32_t> inputs[] = {{0, 3}, {4, UINT32_MAX}}; // too few records, a stray uint32_t
+	for (const std::pair<size_t, uint32_t> &input : inputs)
+	{
+		write_pcb_file("test.bin", records, input.first, input.second);
+		FILE *in = fopen("test.bin", "rb");
+		FILE *out = fopen("test.trace", "wb");
+		EXPECT_FALSE(pcb_trace_convert(in, out, false));
+		fclose(in);
+		fclose(out);
+	}
+
+	dyn_array_destroy(ready_queue);
 	remove("test.bin");
+	remove("test.trace");
 }
 
 